@@ -0,0 +1,117 @@
+/**
+ * expLORA Gateway Lite
+ *
+ * Fixed point number formatting
+ *
+ * Copyright Pajenicko s.r.o., Igor Sverma (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "FixedPoint.h"
+
+static const uint32_t POWERS_OF_TEN[] = {1, 10, 100, 1000, 10000, 100000, 1000000};
+static const uint8_t MAX_SCALE = 6;
+
+// Write value / 10^scale rounded to decimals into buffer
+size_t FixedPoint::format(char *buffer, size_t size, int32_t value, uint8_t scale, uint8_t decimals)
+{
+    if (scale > MAX_SCALE)
+    {
+        scale = MAX_SCALE;
+    }
+    if (decimals > scale)
+    {
+        decimals = scale;
+    }
+
+    // Drop digits that are not printed, rounding half away from zero
+    bool negative = value < 0;
+    uint32_t magnitude = negative ? (uint32_t)(-(int64_t)value) : (uint32_t)value;
+    uint32_t dropped = POWERS_OF_TEN[scale - decimals];
+    magnitude = (uint32_t)(((uint64_t)magnitude + dropped / 2) / dropped);
+    if (magnitude == 0)
+    {
+        negative = false; // No "-0.00"
+    }
+
+    uint32_t integerPart = magnitude / POWERS_OF_TEN[decimals];
+    uint32_t fraction = magnitude % POWERS_OF_TEN[decimals];
+
+    // Sign, up to 10 integer digits, point and up to 6 decimals
+    char text[20];
+    size_t length = 0;
+    if (negative)
+    {
+        text[length++] = '-';
+    }
+
+    char reversed[10];
+    size_t digits = 0;
+    do
+    {
+        reversed[digits++] = '0' + integerPart % 10;
+        integerPart /= 10;
+    } while (integerPart > 0);
+    while (digits > 0)
+    {
+        text[length++] = reversed[--digits];
+    }
+
+    if (decimals > 0)
+    {
+        text[length++] = '.';
+        for (int i = decimals - 1; i >= 0; i--)
+        {
+            text[length + i] = '0' + fraction % 10;
+            fraction /= 10;
+        }
+        length += decimals;
+    }
+
+    if (length >= size)
+    {
+        return 0;
+    }
+    memcpy(buffer, text, length);
+    buffer[length] = '\0';
+    return length;
+}
+
+// Same as format() returning String
+String FixedPoint::toString(int32_t value, uint8_t scale, uint8_t decimals)
+{
+    char text[20];
+    format(text, sizeof(text), value, scale, decimals);
+    return String(text);
+}
+
+// Convert float to fixed point
+int32_t FixedPoint::fromFloat(float value, uint8_t scale)
+{
+    return (int32_t)lroundf(value * POWERS_OF_TEN[scale > MAX_SCALE ? MAX_SCALE : scale]);
+}
+
+// Convert fixed point to float
+float FixedPoint::toFloat(int32_t value, uint8_t scale)
+{
+    return value / (float)POWERS_OF_TEN[scale > MAX_SCALE ? MAX_SCALE : scale];
+}
+
+// Multiply value by factor given in thousandths
+int32_t FixedPoint::scale(int32_t value, int32_t factorPermille)
+{
+    int64_t product = (int64_t)value * factorPermille;
+    return (int32_t)((product >= 0 ? product + 500 : product - 500) / 1000);
+}
@@ -0,0 +1,62 @@
+/**
+ * expLORA Gateway Lite
+ *
+ * Fixed point number formatting header file
+ *
+ * Copyright Pajenicko s.r.o., Igor Sverma (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * Fixed point numbers - integers holding value * 10^scale
+ *
+ * Measurements are kept as fixed point integers in the units the sensors
+ * send (hundredths of degree, tenths of hPa, ...), so the radio path and
+ * corrections need no floating point and every consumer formats the text it
+ * needs directly from the integer, without float conversion or rounding.
+ */
+class FixedPoint
+{
+public:
+    // Write value / 10^scale rounded to decimals (at most scale) into buffer,
+    // returns length without terminator, 0 if buffer is too small
+    static size_t format(char *buffer, size_t size, int32_t value, uint8_t scale, uint8_t decimals);
+
+    // Same as format() returning String
+    static String toString(int32_t value, uint8_t scale, uint8_t decimals);
+
+    // Convert between float and fixed point (rounded to nearest)
+    static int32_t fromFloat(float value, uint8_t scale);
+    static float toFloat(int32_t value, uint8_t scale);
+
+    // Multiply value by factor given in thousandths (rounded to nearest)
+    static int32_t scale(int32_t value, int32_t factorPermille);
+
+    // Same as format() into a buffer on the stack, for printf style arguments:
+    // FixedPoint::Text(value, 2, 2).c_str() is valid until the end of the statement
+    class Text
+    {
+    private:
+        char text[20];
+
+    public:
+        Text(int32_t value, uint8_t scale, uint8_t decimals) { format(text, sizeof(text), value, scale, decimals); }
+        const char *c_str() const { return text; }
+    };
+};
@@ -21,18 +21,35 @@
 
 #include "Logging.h"
 #include <time.h>
-#include <esp_heap_caps.h>
+#include <stdarg.h>
 #include <Arduino.h>
+#include <esp_system.h>
+#include "../Hardware/PSRAM_Manager.h"
 
 // Initialization of static variables
 LogLevel Logger::currentLevel = LogLevel::INFO;
-LogEntry *Logger::logBuffer = nullptr;
-size_t Logger::logBufferSize = LOG_BUFFER_SIZE;
-size_t Logger::logIndex = 0;
+uint8_t *Logger::arena = nullptr;
+size_t Logger::arenaSize = 0;
+size_t Logger::head = 0;
+size_t Logger::tail = 0;
+size_t Logger::newest = 0;
+size_t Logger::wrapEnd = 0;
+bool Logger::wrapped = false;
 size_t Logger::logCount = 0;
+uint32_t Logger::nextSequence = 0;
+uint32_t Logger::bootId = 0;
+Logger::SinkState Logger::sinks[LOG_MAX_SINKS];
+size_t Logger::sinkCount = 0;
+std::mutex Logger::drainMutex;
+std::atomic<TaskHandle_t> Logger::drainTaskHandle(NULL);
+std::atomic<bool> Logger::syncRequested(false);
+bool Logger::usePSRAM = false;
 std::mutex Logger::logMutex;
 bool Logger::initialized = false;
 
+// Serial console is always a sink
+static SerialLogSink serialSink;
+
 bool Logger::timeInitialized = false;
 
 void Logger::setTimeInitialized(bool initialized)
@@ -49,28 +66,47 @@ bool Logger::init(size_t bufferSize)
         deinit();
     }
 
-    logBufferSize = bufferSize;
+    // Arena must hold at least one record of maximum length
+    if (bufferSize < recordSize(LOG_MESSAGE_SIZE))
+    {
+        bufferSize = recordSize(LOG_MESSAGE_SIZE);
+    }
 
-    logBuffer = new LogEntry[logBufferSize];
-    Serial.printf("Logger: Allocated %u bytes in RAM for logs\n", sizeof(LogEntry) * logBufferSize);
+    arena = (uint8_t *)PSRAMManager::allocateMemory(bufferSize);
 
     // Check if memory allocation was successful
-    if (logBuffer == nullptr)
+    if (arena == nullptr)
     {
         Serial.println("Logger: Failed to allocate memory for logs");
         return false;
     }
 
-    // Reset indexes and log count
-    logIndex = 0;
+    arenaSize = bufferSize;
+    usePSRAM = PSRAMManager::isPSRAMAvailable();
+    Serial.printf("Logger: Allocated %u bytes in %s for logs\n", (unsigned)arenaSize, usePSRAM ? "PSRAM" : "RAM");
+
+    // Reset arena
+    head = 0;
+    tail = 0;
+    newest = 0;
+    wrapEnd = 0;
+    wrapped = false;
     logCount = 0;
     initialized = true;
 
-    // First log after initialization - use char[] instead of String concat
-    char initMsg[64];
-    snprintf(initMsg, sizeof(initMsg), "Logging system initialized with %u entries",
-             logBufferSize);
-    info(initMsg);
+    // Sequence numbers continue across re-initialization, they only restart at boot
+    while (bootId == 0)
+    {
+        bootId = esp_random();
+    }
+
+    if (sinkCount == 0)
+    {
+        addSink(&serialSink);
+    }
+
+    // First log after initialization
+    logf(LogLevel::INFO, "Logging system initialized with %u byte arena", (unsigned)arenaSize);
 
     return true;
 }
@@ -81,13 +117,13 @@ void Logger::deinit()
     if (!initialized)
         return;
 
+    std::lock_guard<std::mutex> drainLock(drainMutex);
     std::lock_guard<std::mutex> lock(logMutex);
 
-    if (logBuffer != nullptr)
-    {
-        delete[] logBuffer;
-        logBuffer = nullptr;
-    }
+    PSRAMManager::freeMemory(arena);
+    arena = nullptr;
+    arenaSize = 0;
+    logCount = 0;
 
     initialized = false;
 }
@@ -105,59 +141,479 @@ LogLevel Logger::getLogLevel()
     return currentLevel;
 }
 
-// Get timestamp
-String Logger::getTimeStamp()
+// Store message and hand it to sinks
+void Logger::write(LogLevel level, const char *message)
 {
-    static char timeBuffer[32];
-
+    // Wall clock time is stored as a number and formatted when the log is read
+    time_t now = 0;
     if (timeInitialized)
     {
-        struct tm timeinfo;
-        if (getLocalTime(&timeinfo))
+        time(&now);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(logMutex);
+        if (arena == nullptr)
         {
-            strftime(timeBuffer, sizeof(timeBuffer), "%Y-%m-%d %H:%M:%S", &timeinfo);
-            return String(timeBuffer);
+            return;
         }
+        append(level, message, (uint32_t)now);
+    }
+
+    TaskHandle_t task = drainTaskHandle.load();
+    if (task != NULL)
+    {
+        xTaskNotifyGive(task);
+        return;
     }
 
-    // Time not set - use simple static string
-    return String("[Time not set]");
+    // No drain task yet - write sinks here, unless this log comes from a sink being drained
+    std::unique_lock<std::mutex> drainLock(drainMutex, std::try_to_lock);
+    if (drainLock.owns_lock())
+    {
+        drainSinks();
+    }
 }
 
-// Add log with specified level
-void Logger::log(LogLevel level, const String &message)
+// Bytes taken by record with message of given length
+size_t Logger::recordSize(size_t length)
+{
+    // Header, message and terminator, rounded up so that headers stay aligned
+    return (sizeof(RecordHeader) + length + 1 + 3) & ~(size_t)3;
+}
+
+// Store message as newest record
+void Logger::append(LogLevel level, const char *message, uint32_t time)
+{
+    size_t length = strnlen(message, LOG_MESSAGE_SIZE - 1);
+    size_t size = recordSize(length);
+
+    // Find room after head, wrapping to the arena start and dropping oldest records
+    for (;;)
+    {
+        if (logCount == 0)
+        {
+            head = 0;
+            tail = 0;
+            wrapped = false;
+        }
+
+        if (!wrapped)
+        {
+            if (head + size <= arenaSize)
+            {
+                break;
+            }
+
+            // Space after head stays unused until records before it are dropped
+            wrapEnd = head;
+            head = 0;
+            wrapped = true;
+        }
+
+        if (head + size <= tail)
+        {
+            break;
+        }
+        dropOldest();
+    }
+
+    RecordHeader header;
+    header.sequence = nextSequence++;
+    header.timestamp = millis();
+    header.time = time;
+    header.previous = newest;
+    header.length = length;
+    header.level = static_cast<uint8_t>(level);
+    header.reserved = 0;
+
+    memcpy(arena + head, &header, sizeof(header));
+    memcpy(arena + head + sizeof(header), message, length);
+    arena[head + sizeof(header) + length] = '\0';
+
+    newest = head;
+    head += size;
+    logCount++;
+}
+
+// Drop oldest record
+void Logger::dropOldest()
+{
+    RecordHeader header;
+    memcpy(&header, arena + tail, sizeof(header));
+
+    tail += recordSize(header.length);
+    logCount--;
+
+    // Records before wrapEnd are gone, the oldest one is now at the arena start
+    if (wrapped && tail >= wrapEnd)
+    {
+        tail = 0;
+        wrapped = false;
+    }
+}
+
+// Read record at offset into entry
+size_t Logger::readRecord(size_t offset, LogEntry &entry)
+{
+    RecordHeader header;
+    memcpy(&header, arena + offset, sizeof(header));
+
+    entry.sequence = header.sequence;
+    entry.timestamp = header.timestamp;
+    entry.time = header.time;
+    entry.level = static_cast<LogLevel>(header.level);
+    entry.message = (const char *)arena + offset + sizeof(header);
+    entry.length = header.length;
+
+    return header.previous;
+}
+
+// Offset of record following the one at offset
+size_t Logger::nextOffset(size_t offset)
+{
+    RecordHeader header;
+    memcpy(&header, arena + offset, sizeof(header));
+
+    size_t next = offset + recordSize(header.length);
+    if (wrapped && next >= wrapEnd)
+    {
+        next = 0;
+    }
+    return next;
+}
+
+// Offset of stored record with given sequence number
+size_t Logger::findRecord(uint32_t sequence)
+{
+    uint32_t fromOldest = sequence - (nextSequence - logCount);
+    uint32_t fromNewest = nextSequence - 1 - sequence;
+
+    // Walk from whichever end of the log is closer
+    size_t offset;
+    if (fromOldest < fromNewest)
+    {
+        offset = tail;
+        for (; fromOldest > 0; fromOldest--)
+        {
+            offset = nextOffset(offset);
+        }
+    }
+    else
+    {
+        LogEntry entry;
+        offset = newest;
+        for (; fromNewest > 0; fromNewest--)
+        {
+            offset = readRecord(offset, entry);
+        }
+    }
+    return offset;
+}
+
+// Copy next record for sink
+bool Logger::takeRecord(SinkState &state, LogEntry &entry, char *message, size_t &following)
+{
+    uint32_t oldest = nextSequence - logCount;
+    if ((int32_t)(state.sequence - oldest) < 0)
+    {
+        // Sink fell behind, the records it did not get were overwritten
+        state.dropped += oldest - state.sequence;
+        state.sequence = oldest;
+        state.offset = tail;
+    }
+
+    if (state.sequence == nextSequence)
+    {
+        return false;
+    }
+
+    // Sink was up to date when the record was appended
+    if (state.offset == NO_OFFSET)
+    {
+        state.offset = findRecord(state.sequence);
+    }
+
+    // Copy out, sink is written without holding logMutex
+    readRecord(state.offset, entry);
+    memcpy(message, entry.message, entry.length + 1);
+    entry.message = message;
+
+    following = state.sequence + 1 != nextSequence ? nextOffset(state.offset) : NO_OFFSET;
+    return true;
+}
+
+// Write pending records to all sinks
+size_t Logger::drainSinks()
+{
+    char message[LOG_MESSAGE_SIZE];
+    size_t total = 0;
+
+    // Sinks take turns in batches, so a slow sink does not make the others fall behind
+    bool progress = true;
+    while (progress)
+    {
+        progress = false;
+
+        for (size_t i = 0; i < sinkCount; i++)
+        {
+            SinkState &state = sinks[i];
+            size_t written = 0;
+
+            while (written < LOG_DRAIN_BATCH)
+            {
+                LogEntry entry;
+                size_t following;
+                {
+                    std::lock_guard<std::mutex> lock(logMutex);
+                    if (!takeRecord(state, entry, message, following))
+                    {
+                        break;
+                    }
+                }
+
+                // Refused record is retried on the next drain
+                if (!state.sink->write(entry))
+                {
+                    break;
+                }
+
+                state.sequence = entry.sequence + 1;
+                state.offset = following;
+                state.written++;
+                written++;
+            }
+
+            if (written > 0)
+            {
+                state.sink->flush();
+                progress = true;
+            }
+            total += written;
+        }
+    }
+
+    return total;
+}
+
+// Let all sinks flush or sync buffered records
+void Logger::flushSinks(bool sync)
+{
+    for (size_t i = 0; i < sinkCount; i++)
+    {
+        if (sync)
+        {
+            sinks[i].sink->sync();
+        }
+        else
+        {
+            sinks[i].sink->flush();
+        }
+    }
+}
+
+// Write pending records to all sinks now and sync them
+size_t Logger::drain()
+{
+    std::lock_guard<std::mutex> drainLock(drainMutex);
+    size_t written = drainSinks();
+    flushSinks(true);
+    return written;
+}
+
+// Let the drain task sync all sinks soon
+void Logger::requestSync()
 {
-    if (!initialized || level > currentLevel)
+    TaskHandle_t task = drainTaskHandle.load();
+    if (task == NULL)
     {
+        drain();
         return;
     }
 
-    // Get timestamp only once
-    String timeStamp = getTimeStamp();
-    // String timeStamp = "[Time not set]";
+    syncRequested = true;
+    xTaskNotifyGive(task);
+}
 
-    // Print to serial port
-    Serial.print(timeStamp);
-    Serial.print(F(" ["));
-    Serial.print(levelToString(level));
-    Serial.print(F("] "));
-    Serial.println(message);
+// Drain task
+void Logger::drainTask(void *parameter)
+{
+    Logger *log = (Logger *)parameter;
+
+    for (;;)
+    {
+        // Woken by every log, the timeout retries sinks that refused records
+        // and lets buffering sinks write out records that waited too long
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(LOG_DRAIN_INTERVAL));
+
+        std::lock_guard<std::mutex> drainLock(log->drainMutex);
+        log->drainSinks();
+        log->flushSinks(log->syncRequested.exchange(false));
+    }
+}
+
+// Start drain task
+bool Logger::startDrainTask()
+{
+    if (drainTaskHandle.load() != NULL)
+    {
+        return true;
+    }
 
+    TaskHandle_t handle = NULL;
+    BaseType_t result = xTaskCreatePinnedToCore(
+        drainTask,               // Task function
+        "LogDrainTask",          // Task name
+        LOG_DRAIN_TASK_STACK,    // Stack size (bytes)
+        this,                    // Parameter to pass
+        LOG_DRAIN_TASK_PRIORITY, // Task priority
+        &handle,                 // Task handle
+        LOG_DRAIN_TASK_CORE      // Core
+    );
+
+    if (result != pdPASS)
+    {
+        logf(LogLevel::ERROR, "Failed to create log drain task");
+        return false;
+    }
+
+    drainTaskHandle.store(handle);
+    logf(LogLevel::INFO, "Log drain task started on core %d", LOG_DRAIN_TASK_CORE);
+    return true;
+}
+
+// Register sink
+bool Logger::addSink(LogSink *sink, bool storedLogs)
+{
+    std::lock_guard<std::mutex> drainLock(drainMutex);
     std::lock_guard<std::mutex> lock(logMutex);
 
-    if (logBuffer != nullptr)
+    for (size_t i = 0; i < sinkCount; i++)
     {
-        logBuffer[logIndex].timestamp = millis();
-        logBuffer[logIndex].level = level;
-        logBuffer[logIndex].message = message;
-        logBuffer[logIndex].formattedTime = timeStamp;
+        if (sinks[i].sink == sink)
+        {
+            return true;
+        }
+    }
 
-        logIndex = (logIndex + 1) % logBufferSize;
-        if (logCount < logBufferSize)
+    if (sinkCount >= LOG_MAX_SINKS)
+    {
+        return false;
+    }
+
+    // A sink registered again may have got the stored logs before it was removed
+    SinkState &state = sinks[sinkCount];
+    state.sink = sink;
+    state.sequence = storedLogs ? nextSequence - logCount : nextSequence;
+    state.offset = storedLogs && logCount > 0 ? tail : NO_OFFSET;
+    state.written = 0;
+    state.dropped = 0;
+    sinkCount++;
+
+    return true;
+}
+
+// Unregister sink
+bool Logger::removeSink(LogSink *sink)
+{
+    std::lock_guard<std::mutex> drainLock(drainMutex);
+
+    for (size_t i = 0; i < sinkCount; i++)
+    {
+        if (sinks[i].sink != sink)
         {
-            logCount++;
+            continue;
         }
+
+        // Hand over pending records first, sync without logMutex so logging goes on meanwhile
+        drainSinks();
+        sink->sync();
+
+        std::lock_guard<std::mutex> lock(logMutex);
+        for (size_t j = i; j + 1 < sinkCount; j++)
+        {
+            sinks[j].sink = sinks[j + 1].sink;
+            sinks[j].sequence = sinks[j + 1].sequence;
+            sinks[j].offset = sinks[j + 1].offset;
+            sinks[j].written = sinks[j + 1].written.load();
+            sinks[j].dropped = sinks[j + 1].dropped.load();
+        }
+        sinkCount--;
+        return true;
+    }
+
+    return false;
+}
+
+// Get number of stored logs
+size_t Logger::getLogCount()
+{
+    std::lock_guard<std::mutex> lock(logMutex);
+    return logCount;
+}
+
+// Sequence number the next log will get
+uint32_t Logger::getNextSequence()
+{
+    std::lock_guard<std::mutex> lock(logMutex);
+    return nextSequence;
+}
+
+// Add log with specified level
+void Logger::log(LogLevel level, const String &message)
+{
+    if (!isEnabled(level))
+    {
+        return;
+    }
+
+    write(level, message.c_str());
+}
+
+// Add printf style log with specified level
+void Logger::logf(LogLevel level, const char *format, ...)
+{
+    if (!isEnabled(level))
+    {
+        return;
+    }
+
+    char message[LOG_MESSAGE_SIZE];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(message, sizeof(message), format, args);
+    va_end(args);
+
+    write(level, message);
+}
+
+// Add log of label followed by data bytes in hexadecimal
+void Logger::logHex(LogLevel level, const char *label, const uint8_t *data, size_t length)
+{
+    if (!isEnabled(level))
+    {
+        return;
+    }
+
+    static const char digits[] = "0123456789abcdef";
+
+    char message[LOG_MESSAGE_SIZE];
+    size_t used = strlcpy(message, label, sizeof(message));
+    if (used >= sizeof(message))
+    {
+        used = sizeof(message) - 1;
     }
+
+    // Bytes that do not fit are left out
+    for (size_t i = 0; i < length && used + 3 < sizeof(message); i++)
+    {
+        message[used++] = digits[data[i] >> 4];
+        message[used++] = digits[data[i] & 0x0F];
+        message[used++] = ' ';
+    }
+    message[used] = '\0';
+
+    write(level, message);
 }
 
 // Helper methods for different log levels
@@ -186,29 +642,25 @@ void Logger::verbose(const String &message)
     log(LogLevel::VERBOSE, message);
 }
 
-// Get all logs (for web interface)
-const LogEntry *Logger::getLogs(size_t &count)
-{
-    std::lock_guard<std::mutex> lock(logMutex);
-    count = logCount;
-    return logBuffer;
-}
-
 // Clear all logs
 void Logger::clearLogs()
 {
+    std::lock_guard<std::mutex> drainLock(drainMutex);
     std::lock_guard<std::mutex> lock(logMutex);
 
-    // Explicitly clear all String objects
-    for (size_t i = 0; i < logBufferSize; i++)
+    head = 0;
+    tail = 0;
+    newest = 0;
+    wrapEnd = 0;
+    wrapped = false;
+    logCount = 0;
+
+    // Cleared records are not written to sinks
+    for (size_t i = 0; i < sinkCount; i++)
     {
-        // Force String deallocation by assigning empty strings
-        logBuffer[i].message = String();
-        logBuffer[i].formattedTime = String();
+        sinks[i].sequence = nextSequence;
+        sinks[i].offset = NO_OFFSET;
     }
-
-    logIndex = 0;
-    logCount = 0;
 }
 
 // Convert log level from string
@@ -230,6 +682,12 @@ LogLevel Logger::levelFromString(const String &levelStr)
 
 // Convert log level to string
 String Logger::levelToString(LogLevel level)
+{
+    return String(levelName(level));
+}
+
+// Name of log level
+const char *Logger::levelName(LogLevel level)
 {
     switch (level)
     {
@@ -247,3 +705,39 @@ String Logger::levelToString(LogLevel level)
         return "UNKNOWN";
     }
 }
+
+// Write formatted time into buffer
+void LogEntry::formatTime(char *buffer, size_t size) const
+{
+    if (time != 0)
+    {
+        struct tm timeinfo;
+        localtime_r(&time, &timeinfo);
+        strftime(buffer, size, "%Y-%m-%d %H:%M:%S", &timeinfo);
+        return;
+    }
+
+    strlcpy(buffer, "[Time not set]", size);
+}
+
+// Format log for UI display
+String LogEntry::getFormattedLog() const
+{
+    char timeStamp[32];
+    formatTime(timeStamp, sizeof(timeStamp));
+    return String(timeStamp) + " [" + getLevelString() + "] " + message;
+}
+
+// Print record to serial console
+bool SerialLogSink::write(const LogEntry &entry)
+{
+    char timeStamp[32];
+    entry.formatTime(timeStamp, sizeof(timeStamp));
+
+    Serial.print(timeStamp);
+    Serial.print(F(" ["));
+    Serial.print(Logger::levelName(entry.level));
+    Serial.print(F("] "));
+    Serial.println(entry.message);
+    return true;
+}
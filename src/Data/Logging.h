@@ -22,15 +22,23 @@
 #pragma once
 
 #include <Arduino.h>
+#include <atomic>
 #include <mutex>
+#include <time.h>
 #include "../config.h"
 
 /**
  * Definition of a logging system with support for various levels
  *
  * The system supports storing logs in PSRAM (if available) and allows
- * setting the logging level via the web interface. Logs are stored in a circular
- * buffer for efficient memory usage.
+ * setting the logging level via the web interface. Logs are stored as packed
+ * records in one circular byte arena, so logging never allocates and the
+ * oldest records are dropped to make room for new ones.
+ *
+ * Producers only append records. A low priority drain task writes them to the
+ * sinks (Serial and others), so a slow sink never blocks the radio path - a
+ * sink that falls behind loses the records overwritten meanwhile, and they
+ * are counted.
  */
 
 // Logging levels
@@ -43,13 +51,16 @@ enum class LogLevel
     VERBOSE = 4  // All available information
 };
 
-// Structure for storing log entries
+// Log entry read from the log arena - message points into the arena and is
+// only valid inside Logger::forEachLog()
 struct LogEntry
 {
+    uint32_t sequence;       // Sequence number, increments with every log
     unsigned long timestamp; // Timestamp in milliseconds since start
+    time_t time;             // Wall clock time, 0 if time was not set when logged
     LogLevel level;          // Log level
-    String message;          // Text message
-    String formattedTime;    // Formatted time (if available)
+    const char *message;     // Text message (null terminated)
+    size_t length;           // Message length
 
     // Convert log level to text representation
     String getLevelString() const
@@ -91,32 +102,125 @@ struct LogEntry
         }
     }
 
+    // Write formatted time into buffer (formatted when read, not when logged)
+    void formatTime(char *buffer, size_t size) const;
+
     // Format log for UI display
-    String getFormattedLog() const
-    {
-        return formattedTime + " [" + getLevelString() + "] " + message;
-    }
+    String getFormattedLog() const;
+};
+
+// Destination of log records, written by the drain task outside the log lock
+class LogSink
+{
+public:
+    virtual ~LogSink() {}
+
+    // Name shown in diagnostics
+    virtual const char *getName() const = 0;
+
+    // Write record, false if the sink cannot take it now (it is retried later)
+    virtual bool write(const LogEntry &entry) = 0;
+
+    // Called after a batch of records was written and periodically by the drain task,
+    // sinks buffering records decide here whether to write them out
+    virtual void flush() {}
+
+    // Write buffered records out now (before reboot)
+    virtual void sync() {}
+};
+
+// Sink printing logs to the serial console
+class SerialLogSink : public LogSink
+{
+public:
+    const char *getName() const override { return "Serial"; }
+    bool write(const LogEntry &entry) override;
 };
 
 class Logger
 {
 private:
+    // Header of record in log arena, followed by the message and its terminator
+    struct RecordHeader
+    {
+        uint32_t sequence;  // Sequence number
+        uint32_t timestamp; // millis() when logged
+        uint32_t time;      // Wall clock seconds, 0 if time was not set
+        uint32_t previous;  // Arena offset of previous (older) record
+        uint16_t length;    // Message length without terminator
+        uint8_t level;      // LogLevel
+        uint8_t reserved;
+    };
+
+    // Position of a sink in the log
+    struct SinkState
+    {
+        LogSink *sink;
+        uint32_t sequence;              // Next record to write
+        size_t offset;                  // Arena offset of that record, NO_OFFSET if not known yet
+        std::atomic<uint32_t> written;  // Records written
+        std::atomic<uint32_t> dropped;  // Records overwritten before the sink got them
+    };
+
+    static const size_t NO_OFFSET = SIZE_MAX;
+
     static LogLevel currentLevel;
-    static LogEntry *logBuffer;
-    static size_t logBufferSize;
-    static size_t logIndex;
-    static size_t logCount;
+    static uint8_t *arena;     // Circular buffer of records
+    static size_t arenaSize;   // Arena size in bytes
+    static size_t head;        // Offset where next record is written
+    static size_t tail;        // Offset of oldest record
+    static size_t newest;      // Offset of newest record
+    static size_t wrapEnd;     // End of records before head wrapped to the arena start
+    static bool wrapped;       // Oldest records lie between tail and wrapEnd, newer ones before head
+    static size_t logCount;    // Number of records in arena
+    static uint32_t nextSequence; // Sequence number of next record
+    static uint32_t bootId;       // Random number telling log readers that sequence numbers restarted
+    static SinkState sinks[LOG_MAX_SINKS];
+    static size_t sinkCount;
+    static std::mutex drainMutex; // Serializes drain(), lock before logMutex
+    static std::atomic<TaskHandle_t> drainTaskHandle;
+    static std::atomic<bool> syncRequested; // Drain task syncs sinks on its next run
     static bool usePSRAM;
     static std::mutex logMutex;
     static bool initialized;
     static bool timeInitialized;
 
-    // Get timestamp (if available)
-    static String getTimeStamp();
+    // Print and store message (caller checked the level)
+    static void write(LogLevel level, const char *message);
+
+    // Store message as newest record, dropping oldest ones as needed (caller must hold logMutex)
+    static void append(LogLevel level, const char *message, uint32_t time);
+
+    // Drop oldest record (caller must hold logMutex)
+    static void dropOldest();
+
+    // Bytes taken by record with message of given length
+    static size_t recordSize(size_t length);
+
+    // Read record at offset into entry, returns offset of previous record
+    static size_t readRecord(size_t offset, LogEntry &entry);
+
+    // Offset of record following the one at offset (caller must hold logMutex)
+    static size_t nextOffset(size_t offset);
+
+    // Offset of stored record with given sequence number (caller must hold logMutex)
+    static size_t findRecord(uint32_t sequence);
+
+    // Copy next record for sink into entry and message buffer, false if there is none (caller must hold logMutex)
+    static bool takeRecord(SinkState &state, LogEntry &entry, char *message, size_t &following);
+
+    // Write pending records to all sinks (caller must hold drainMutex)
+    static size_t drainSinks();
+
+    // Let all sinks flush or sync buffered records (caller must hold drainMutex)
+    static void flushSinks(bool sync);
+
+    // Drain task - writes records to sinks whenever new ones are appended
+    static void drainTask(void *parameter);
 
 public:
     // Logger initialization
-    static bool init(size_t bufferSize = LOG_BUFFER_SIZE);
+    static bool init(size_t bufferSize = LOG_ARENA_SIZE);
 
     // Free memory on termination
     static void deinit();
@@ -127,9 +231,19 @@ public:
     // Get current logging level
     static LogLevel getLogLevel();
 
+    // Check whether messages of given level are logged (use before building expensive messages)
+    static bool isEnabled(LogLevel level) { return initialized && level <= currentLevel; }
+
     // Add log with specified level
     static void log(LogLevel level, const String &message);
 
+    // Add printf style log with specified level - formatted on the stack only
+    // when the level is enabled (prefer the LOGF_* macros below)
+    static void logf(LogLevel level, const char *format, ...) __attribute__((format(printf, 2, 3)));
+
+    // Add log of label followed by data bytes in hexadecimal
+    static void logHex(LogLevel level, const char *label, const uint8_t *data, size_t length);
+
     // Helper methods for different log levels
     static void error(const String &message);
     static void warning(const String &message);
@@ -137,8 +251,96 @@ public:
     static void debug(const String &message);
     static void verbose(const String &message);
 
-    // Get all logs (for web interface)
-    static const LogEntry *getLogs(size_t &count);
+    // Call visitor(entry) for stored logs from newest to oldest until it returns false,
+    // returns number of visited logs. Logging waits meanwhile, so the visitor must not log.
+    template <typename Visitor>
+    static size_t forEachLog(Visitor visitor)
+    {
+        std::lock_guard<std::mutex> lock(logMutex);
+
+        size_t offset = newest;
+        size_t visited = 0;
+        while (visited < logCount)
+        {
+            LogEntry entry;
+            offset = readRecord(offset, entry);
+            visited++;
+            if (!visitor(entry))
+            {
+                break;
+            }
+        }
+        return visited;
+    }
+
+    // Call visitor(entry) for stored logs from the given sequence number on, oldest first,
+    // until it returns false; sequence is then set to the first log not visited. A sequence
+    // older than the oldest log or ahead of the newest one (from before a reboot) starts at
+    // the oldest log. Returns number of visited logs, the visitor must not log.
+    template <typename Visitor>
+    static size_t forEachLogSince(uint32_t &sequence, Visitor visitor)
+    {
+        std::lock_guard<std::mutex> lock(logMutex);
+
+        uint32_t oldest = nextSequence - logCount;
+        if ((int32_t)(sequence - oldest) < 0 || (int32_t)(nextSequence - sequence) < 0)
+        {
+            sequence = oldest;
+        }
+
+        size_t pending = nextSequence - sequence;
+        if (pending == 0)
+        {
+            return 0;
+        }
+
+        size_t offset = findRecord(sequence);
+        size_t visited = 0;
+        while (visited < pending)
+        {
+            LogEntry entry;
+            readRecord(offset, entry);
+            sequence++;
+            visited++;
+            if (!visitor(entry) || visited == pending)
+            {
+                break;
+            }
+            offset = nextOffset(offset);
+        }
+        return visited;
+    }
+
+    // Get number of stored logs
+    static size_t getLogCount();
+
+    // Sequence number the next log will get
+    static uint32_t getNextSequence();
+
+    // Random number chosen at boot - a reader whose cursor has another boot id starts over
+    static uint32_t getBootId() { return bootId; }
+
+    // Register sink, it receives all stored records from the oldest one on, or with
+    // storedLogs false only logs written from now on (sink that was registered before)
+    static bool addSink(LogSink *sink, bool storedLogs = true);
+
+    // Unregister sink after it synced its buffered records
+    static bool removeSink(LogSink *sink);
+
+    // Start drain task - until then records are written to sinks by the logging task itself
+    bool startDrainTask();
+
+    // Write pending records to all sinks and sync them (before reboot), returns number of records written
+    static size_t drain();
+
+    // Let the drain task sync all sinks soon, without waiting for it (falls back to drain() without the task)
+    static void requestSync();
+
+    // Sink statistics
+    static size_t getSinkCount() { return sinkCount; }
+    static const char *getSinkName(size_t index) { return sinks[index].sink->getName(); }
+    static uint32_t getSinkWritten(size_t index) { return sinks[index].written.load(); }
+    static uint32_t getSinkDropped(size_t index) { return sinks[index].dropped.load(); }
 
     // Clear all logs
     static void clearLogs();
@@ -149,11 +351,50 @@ public:
     // Convert log level to string
     static String levelToString(LogLevel level);
 
+    // Name of log level
+    static const char *levelName(LogLevel level);
+
     // Set time initialization state
     static void setTimeInitialized(bool initialized);
 
     static bool isTimeInitialized() { return timeInitialized; }
 
-    static size_t getLogIndex() { return logIndex; }
-    static size_t getLogBufferSize() { return logBufferSize; }
-};
\ No newline at end of file
+    // Arena size and whether it is in PSRAM
+    static size_t getArenaSize() { return arenaSize; }
+    static bool isUsingPSRAM() { return usePSRAM; }
+};
+
+/**
+ * Logging macros
+ *
+ * Arguments are only evaluated and formatted when the level is enabled at
+ * runtime, and calls below LOG_MIN_LEVEL are removed at compile time, so
+ * they cost nothing on the packet path when their level is off. Messages are
+ * formatted into a stack buffer of LOG_MESSAGE_SIZE bytes, never a String.
+ */
+#define LOGF_COMPILED(level) (static_cast<int>(LogLevel::level) <= LOG_MIN_LEVEL)
+#define LOGF_ENABLED(level) (LOGF_COMPILED(level) && Logger::isEnabled(LogLevel::level))
+
+#define LOGF(level, ...)                                  \
+    do                                                    \
+    {                                                     \
+        if (LOGF_ENABLED(level))                          \
+        {                                                 \
+            Logger::logf(LogLevel::level, __VA_ARGS__);   \
+        }                                                 \
+    } while (0)
+
+#define LOGF_ERROR(...) LOGF(ERROR, __VA_ARGS__)
+#define LOGF_WARNING(...) LOGF(WARNING, __VA_ARGS__)
+#define LOGF_INFO(...) LOGF(INFO, __VA_ARGS__)
+#define LOGF_DEBUG(...) LOGF(DEBUG, __VA_ARGS__)
+#define LOGF_VERBOSE(...) LOGF(VERBOSE, __VA_ARGS__)
+
+#define LOGF_HEX(level, label, data, length)                        \
+    do                                                              \
+    {                                                               \
+        if (LOGF_ENABLED(level))                                    \
+        {                                                           \
+            Logger::logHex(LogLevel::level, label, data, length);   \
+        }                                                           \
+    } while (0)
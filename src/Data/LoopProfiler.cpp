@@ -0,0 +1,161 @@
+/**
+ * expLORA Gateway Lite
+ *
+ * Main loop profiler implementation file
+ *
+ * Copyright Pajenicko s.r.o., Igor Sverma (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "LoopProfiler.h"
+#include <esp_attr.h>
+#include <esp_system.h>
+#include <esp_timer.h>
+#include "../config.h"
+
+// Marks valid content of RTC memory, which is random after power-on
+#define LOOP_PROFILER_RTC_MAGIC 0x4C4F4F50
+
+// Running stage, preserved across watchdog reset
+static RTC_NOINIT_ATTR uint32_t rtcMagic;
+static RTC_NOINIT_ATTR uint8_t rtcStage;
+
+LatencyHistogram LoopProfiler::stages[static_cast<size_t>(LoopStage::COUNT)];
+LatencyHistogram LoopProfiler::iterations;
+int64_t LoopProfiler::iterationStart = 0;
+int64_t LoopProfiler::stageStart = 0;
+LoopStage LoopProfiler::currentStage = LoopStage::COUNT;
+std::atomic<uint32_t> LoopProfiler::stalledIterations(0);
+std::atomic<uint32_t> LoopProfiler::watchdogWarnings(0);
+LoopStage LoopProfiler::watchdogWarningStage = LoopStage::COUNT;
+uint32_t LoopProfiler::watchdogWarningElapsed = 0;
+bool LoopProfiler::watchdogWarningPending = false;
+LoopStage LoopProfiler::watchdogResetStage = LoopStage::COUNT;
+
+// Check whether last reset was caused by task watchdog
+void LoopProfiler::init()
+{
+    if (rtcMagic == LOOP_PROFILER_RTC_MAGIC && rtcStage < static_cast<uint8_t>(LoopStage::COUNT) &&
+        esp_reset_reason() == ESP_RST_TASK_WDT)
+    {
+        watchdogResetStage = static_cast<LoopStage>(rtcStage);
+    }
+
+    rtcMagic = LOOP_PROFILER_RTC_MAGIC;
+    rtcStage = static_cast<uint8_t>(LoopStage::COUNT);
+}
+
+// Start of loop() iteration
+void LoopProfiler::beginIteration()
+{
+    iterationStart = esp_timer_get_time();
+    stageStart = iterationStart;
+    currentStage = LoopStage::COUNT;
+}
+
+// Close running stage
+void LoopProfiler::endStage(int64_t now)
+{
+    if (currentStage >= LoopStage::COUNT)
+    {
+        return;
+    }
+
+    stages[static_cast<size_t>(currentStage)].record((uint32_t)(now - stageStart));
+
+    // Watchdog is reset only at the start of iteration, so everything since then counts
+    uint32_t elapsed = (uint32_t)((now - iterationStart) / 1000);
+    if (elapsed >= WDT_TIMEOUT * 1000UL * LOOP_WDT_WARNING_PERCENT / 100)
+    {
+        watchdogWarnings++;
+        watchdogWarningStage = currentStage;
+        watchdogWarningElapsed = elapsed;
+        watchdogWarningPending = true;
+    }
+}
+
+// Close running stage and start next one
+void LoopProfiler::beginStage(LoopStage stage)
+{
+    int64_t now = esp_timer_get_time();
+    endStage(now);
+
+    currentStage = stage;
+    stageStart = now;
+    rtcStage = static_cast<uint8_t>(stage);
+}
+
+// End of loop() iteration
+bool LoopProfiler::endIteration()
+{
+    int64_t now = esp_timer_get_time();
+    endStage(now);
+
+    uint32_t duration = (uint32_t)(now - iterationStart);
+    iterations.record(duration);
+    if (duration > LOOP_STALL_BUDGET * 1000UL)
+    {
+        stalledIterations++;
+    }
+
+    currentStage = LoopStage::COUNT;
+    rtcStage = static_cast<uint8_t>(LoopStage::COUNT);
+
+    bool warning = watchdogWarningPending;
+    watchdogWarningPending = false;
+    return warning;
+}
+
+// Name of stage for API and logs
+const char *LoopProfiler::getStageName(LoopStage stage)
+{
+    switch (stage)
+    {
+    case LoopStage::AP_TIMER:
+        return "apTimer";
+    case LoopStage::DNS:
+        return "dns";
+    case LoopStage::WEB:
+        return "web";
+    case LoopStage::MQTT:
+        return "mqtt";
+    case LoopStage::PUBLISH:
+        return "publish";
+    case LoopStage::PERSIST:
+        return "persist";
+    case LoopStage::WIFI:
+        return "wifi";
+    case LoopStage::IDLE:
+        return "idle";
+    case LoopStage::DIAGNOSTICS:
+        return "diagnostics";
+    default:
+        return "none";
+    }
+}
+
+// Clear statistics
+void LoopProfiler::reset()
+{
+    for (LatencyHistogram &histogram : stages)
+    {
+        histogram.reset();
+    }
+    iterations.reset();
+    stalledIterations = 0;
+    watchdogWarnings = 0;
+    watchdogWarningStage = LoopStage::COUNT;
+    watchdogWarningElapsed = 0;
+}
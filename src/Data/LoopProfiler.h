@@ -0,0 +1,102 @@
+/**
+ * expLORA Gateway Lite
+ *
+ * Main loop profiler header file
+ *
+ * Copyright Pajenicko s.r.o., Igor Sverma (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+#include "PacketLatency.h"
+
+// Stages of main loop, in order of execution
+enum class LoopStage : uint8_t
+{
+    AP_TIMER,    // Temporary AP mode timer
+    DNS,         // Captive portal DNS
+    WEB,         // Web portal and OTA housekeeping
+    MQTT,        // MQTT client processing
+    PUBLISH,     // Publishing sensors decoded by LoRa task
+    PERSIST,     // Write-behind saving of sensor state
+    WIFI,        // WiFi reconnect
+    IDLE,        // delay() between iterations
+    DIAGNOSTICS, // Periodic memory diagnostics
+    COUNT
+};
+
+/**
+ * Lightweight profiler of the main loop
+ *
+ * Measures the duration of every loop() stage, counts iterations that exceed
+ * LOOP_STALL_BUDGET and remembers the stage that was running when the task
+ * watchdog came close to firing. The running stage is also kept in memory that
+ * survives a reset, so the stage that caused a watchdog reset is reported on
+ * the next boot. Only called from the loop() task.
+ */
+class LoopProfiler
+{
+private:
+    static LatencyHistogram stages[static_cast<size_t>(LoopStage::COUNT)];
+    static LatencyHistogram iterations;
+
+    static int64_t iterationStart; // Start of iteration, watchdog was reset here
+    static int64_t stageStart;     // Start of running stage
+    static LoopStage currentStage; // Running stage, COUNT outside of iteration
+
+    static std::atomic<uint32_t> stalledIterations; // Iterations longer than LOOP_STALL_BUDGET
+    static std::atomic<uint32_t> watchdogWarnings;  // Stages ending close to watchdog timeout
+    static LoopStage watchdogWarningStage;          // Stage of last watchdog warning
+    static uint32_t watchdogWarningElapsed;         // Time since watchdog reset at last warning (ms)
+    static bool watchdogWarningPending;             // Warning not yet reported by endIteration()
+
+    static LoopStage watchdogResetStage; // Stage running before last watchdog reset, COUNT if none
+
+    // Close running stage
+    static void endStage(int64_t now);
+
+public:
+    // Check whether last reset was caused by task watchdog (call once at boot)
+    static void init();
+
+    // Start of loop() iteration, right after esp_task_wdt_reset()
+    static void beginIteration();
+
+    // Close running stage and start next one
+    static void beginStage(LoopStage stage);
+
+    // End of loop() iteration, returns true when a stage came close to watchdog timeout
+    static bool endIteration();
+
+    // Statistics (us)
+    static const LatencyHistogram &getStage(LoopStage stage) { return stages[static_cast<size_t>(stage)]; }
+    static const LatencyHistogram &getIterations() { return iterations; }
+    static uint32_t getStalledIterations() { return stalledIterations.load(); }
+
+    // Watchdog diagnostics
+    static uint32_t getWatchdogWarnings() { return watchdogWarnings.load(); }
+    static LoopStage getWatchdogWarningStage() { return watchdogWarningStage; }
+    static uint32_t getWatchdogWarningElapsed() { return watchdogWarningElapsed; }
+    static LoopStage getWatchdogResetStage() { return watchdogResetStage; }
+
+    // Name of stage for API and logs
+    static const char *getStageName(LoopStage stage);
+
+    // Clear statistics (watchdog reset stage is kept)
+    static void reset();
+};
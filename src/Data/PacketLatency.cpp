@@ -0,0 +1,147 @@
+/**
+ * expLORA Gateway Lite
+ *
+ * Packet latency statistics implementation file
+ *
+ * Copyright Pajenicko s.r.o., Igor Sverma (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "PacketLatency.h"
+
+LatencyHistogram PacketLatency::histograms[static_cast<size_t>(LatencyStage::COUNT)];
+
+// Add one duration
+void LatencyHistogram::record(uint32_t duration)
+{
+    buckets[bucketOf(duration)].fetch_add(1, std::memory_order_relaxed);
+    count.fetch_add(1, std::memory_order_relaxed);
+    total.fetch_add(duration, std::memory_order_relaxed);
+
+    uint32_t current = minimum.load(std::memory_order_relaxed);
+    while (duration < current && !minimum.compare_exchange_weak(current, duration, std::memory_order_relaxed))
+    {
+    }
+
+    current = maximum.load(std::memory_order_relaxed);
+    while (duration > current && !maximum.compare_exchange_weak(current, duration, std::memory_order_relaxed))
+    {
+    }
+}
+
+// Clear all counters
+void LatencyHistogram::reset()
+{
+    for (size_t i = 0; i < BUCKET_COUNT; i++)
+    {
+        buckets[i].store(0, std::memory_order_relaxed);
+    }
+    count.store(0, std::memory_order_relaxed);
+    total.store(0, std::memory_order_relaxed);
+    minimum.store(UINT32_MAX, std::memory_order_relaxed);
+    maximum.store(0, std::memory_order_relaxed);
+}
+
+// Bucket index of duration - number of significant bits
+size_t LatencyHistogram::bucketOf(uint32_t duration)
+{
+    if (duration == 0)
+    {
+        return 0;
+    }
+
+    size_t bucket = 32 - __builtin_clz(duration);
+    return bucket < BUCKET_COUNT ? bucket : BUCKET_COUNT - 1;
+}
+
+uint32_t LatencyHistogram::getAverage() const
+{
+    uint32_t n = getCount();
+    return n > 0 ? (uint32_t)(total.load(std::memory_order_relaxed) / n) : 0;
+}
+
+// Upper bound of bucket containing given percentile
+uint32_t LatencyHistogram::getPercentile(float percentile) const
+{
+    uint32_t n = getCount();
+    if (n == 0)
+    {
+        return 0;
+    }
+
+    uint64_t rank = (uint64_t)(n * percentile / 100.0f + 0.5f);
+    if (rank == 0)
+    {
+        rank = 1;
+    }
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; i++)
+    {
+        seen += getBucket(i);
+        if (seen >= rank)
+        {
+            uint64_t bound = bucketUpperBound(i) - 1;
+            return bound < getMax() ? (uint32_t)bound : getMax();
+        }
+    }
+
+    return getMax();
+}
+
+// Record duration between two timestamps
+void PacketLatency::record(LatencyStage stage, int64_t start, int64_t end)
+{
+    if (start <= 0 || end < start || stage >= LatencyStage::COUNT)
+    {
+        return;
+    }
+
+    int64_t duration = end - start;
+    histograms[static_cast<size_t>(stage)].record(duration > UINT32_MAX ? UINT32_MAX : (uint32_t)duration);
+}
+
+// Name of stage for API and logs
+const char *PacketLatency::getStageName(LatencyStage stage)
+{
+    switch (stage)
+    {
+    case LatencyStage::RADIO:
+        return "radio";
+    case LatencyStage::DECODE:
+        return "decode";
+    case LatencyStage::SENSOR_UPDATE:
+        return "sensorUpdate";
+    case LatencyStage::HTTP_FORWARD:
+        return "httpForward";
+    case LatencyStage::MQTT_QUEUE:
+        return "mqttQueue";
+    case LatencyStage::MQTT_PUBLISH:
+        return "mqttPublish";
+    case LatencyStage::TOTAL:
+        return "total";
+    default:
+        return "unknown";
+    }
+}
+
+// Clear all histograms
+void PacketLatency::reset()
+{
+    for (LatencyHistogram &histogram : histograms)
+    {
+        histogram.reset();
+    }
+}
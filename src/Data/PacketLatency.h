@@ -0,0 +1,105 @@
+/**
+ * expLORA Gateway Lite
+ *
+ * Packet latency statistics header file
+ *
+ * Copyright Pajenicko s.r.o., Igor Sverma (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+
+/**
+ * Latency histogram with fixed log2 buckets
+ *
+ * Bucket 0 counts zero durations, bucket n counts durations in
+ * [2^(n-1), 2^n) microseconds, the last bucket everything longer.
+ * Recording is lock-free and may be done from several tasks.
+ */
+class LatencyHistogram
+{
+public:
+    static const size_t BUCKET_COUNT = 32;
+
+private:
+    std::atomic<uint32_t> buckets[BUCKET_COUNT];
+    std::atomic<uint32_t> count;
+    std::atomic<uint64_t> total;
+    std::atomic<uint32_t> minimum;
+    std::atomic<uint32_t> maximum;
+
+public:
+    LatencyHistogram() { reset(); }
+
+    // Add one duration (us)
+    void record(uint32_t duration);
+
+    // Clear all counters
+    void reset();
+
+    // Bucket index of duration
+    static size_t bucketOf(uint32_t duration);
+
+    // Smallest duration that no longer falls into bucket (us)
+    static uint64_t bucketUpperBound(size_t bucket) { return bucket == 0 ? 1 : (uint64_t)1 << bucket; }
+
+    // Statistics (us)
+    uint32_t getCount() const { return count.load(std::memory_order_relaxed); }
+    uint32_t getBucket(size_t bucket) const { return buckets[bucket].load(std::memory_order_relaxed); }
+    uint32_t getMin() const { return getCount() > 0 ? minimum.load(std::memory_order_relaxed) : 0; }
+    uint32_t getMax() const { return maximum.load(std::memory_order_relaxed); }
+    uint32_t getAverage() const;
+
+    // Upper bound of bucket containing given percentile (0-100), capped by maximum
+    uint32_t getPercentile(float percentile) const;
+};
+
+// Stages of packet path, each measured from the end of the previous one
+enum class LatencyStage : uint8_t
+{
+    RADIO,         // DIO0 interrupt -> decode start (FIFO read, receive queue)
+    DECODE,        // Decryption, verification and packet validation
+    SENSOR_UPDATE, // SensorManager::updateSensorData() (readings in RAM and queueing for HTTP forwarding, no flash writes)
+    HTTP_FORWARD,  // Queued for custom URL -> HTTP response received (runs in parallel with MQTT stages)
+    MQTT_QUEUE,    // Decoded -> picked up by main loop for publishing
+    MQTT_PUBLISH,  // MQTTManager::publishSensorData()
+    TOTAL,         // DIO0 interrupt -> published to MQTT
+    COUNT
+};
+
+/**
+ * Latency histograms of all packet stages
+ */
+class PacketLatency
+{
+private:
+    static LatencyHistogram histograms[static_cast<size_t>(LatencyStage::COUNT)];
+
+public:
+    // Record duration between two esp_timer_get_time() stamps
+    static void record(LatencyStage stage, int64_t start, int64_t end);
+
+    // Access histogram of stage
+    static const LatencyHistogram &get(LatencyStage stage) { return histograms[static_cast<size_t>(stage)]; }
+
+    // Name of stage for API and logs
+    static const char *getStageName(LatencyStage stage);
+
+    // Clear all histograms
+    static void reset();
+};
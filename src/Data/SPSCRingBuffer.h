@@ -0,0 +1,91 @@
+/**
+ * expLORA Gateway Lite
+ *
+ * Single-producer single-consumer ring buffer header file
+ *
+ * Copyright Pajenicko s.r.o., Igor Sverma (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Lock-free ring buffer for exactly one producer and one consumer task
+ *
+ * Slots are filled and consumed in place (acquireWrite/commitWrite and
+ * peekRead/releaseRead), so large items such as radio frames are never copied
+ * through an intermediate buffer. Capacity must be a power of two.
+ */
+template <typename T, size_t N>
+class SPSCRingBuffer
+{
+    static_assert(N > 0 && (N & (N - 1)) == 0, "Ring buffer capacity must be a power of two");
+
+private:
+    T slots[N];
+    std::atomic<uint32_t> head; // Next slot to write (owned by producer)
+    std::atomic<uint32_t> tail; // Next slot to read (owned by consumer)
+
+public:
+    SPSCRingBuffer() : head(0), tail(0) {}
+
+    // Producer: get free slot to fill, nullptr if buffer is full
+    T *acquireWrite()
+    {
+        uint32_t h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) >= N)
+        {
+            return nullptr;
+        }
+        return &slots[h & (N - 1)];
+    }
+
+    // Producer: publish slot returned by acquireWrite()
+    void commitWrite()
+    {
+        head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // Consumer: get oldest filled slot, nullptr if buffer is empty
+    T *peekRead()
+    {
+        uint32_t t = tail.load(std::memory_order_relaxed);
+        if (t == head.load(std::memory_order_acquire))
+        {
+            return nullptr;
+        }
+        return &slots[t & (N - 1)];
+    }
+
+    // Consumer: return slot returned by peekRead() to producer
+    void releaseRead()
+    {
+        tail.store(tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // Number of filled slots (approximate when called from a third task)
+    size_t size() const
+    {
+        return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+    }
+
+    bool empty() const { return size() == 0; }
+
+    static constexpr size_t capacity() { return N; }
+};
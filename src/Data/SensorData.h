@@ -23,94 +23,86 @@
 
 #include <Arduino.h>
 #include <ArduinoJson.h>
+#include <memory>
+#include <vector>
 #include "SensorTypes.h"
+#include "FixedPoint.h"
+#include "UrlTemplate.h"
 
 /**
- * Structure for storing sensor data
+ * Live state of a sensor
+ *
+ * Identity and the latest readings, i.e. everything the radio path reads or
+ * writes for every packet. Kept free of heap-owning members so that readings
+ * of many sensors are packed together in SensorManager storage.
  *
- * This structure stores both configuration data and current measurement values
- * from sensors. Thanks to integration with SensorTypes, it allows flexible
- * handling of different sensor types and their specific data.
+ * Measurements are fixed point integers in the units sensors send them (the
+ * name says the scale, e.g. temperatureCenti is in hundredths of °C) with
+ * corrections already applied. They are converted to text only by the
+ * consumer through the get*String() helpers or FixedPoint::format().
  */
-struct SensorData
+struct SensorReadings
 {
     // Basic sensor identification
-    SensorType deviceType; // Device type
-    uint32_t serialNumber; // Serial number
-    uint32_t deviceKey;    // Key for data decryption
-    String name;           // User-defined sensor name
-
-    // Extended configuration
-    String customUrl; // Complete URL with placeholders
-    int altitude;     // Altitude (m) - for BME280
-
-    // Sensor status
-    unsigned long lastSeen; // Time of last seen packet
+    uint32_t serialNumber;  // Serial number
+    uint32_t deviceKey;     // Key for data decryption
+    SensorType deviceType;  // Device type
     bool configured;        // Whether the sensor is configured
+    uint16_t windDirection; // Wind direction (degrees) - METEO, placed here to fill padding
 
     // General sensor data - values are valid according to device type
-    float temperature; // Temperature (°C) - BME280, SCD40
-    float humidity;    // Humidity (%) - BME280, SCD40
-    float pressure;    // Pressure (hPa) - BME280
-    float ppm;         // CO2 concentration (ppm) - SCD40
-    float lux;         // Light intensity (lux) - VEML7700
-
-    // New variables for METEO sensor
-    float windSpeed;             // Wind speed (m/s)
-    uint16_t windDirection;      // Wind direction (degrees)
-    float rainAmount;            // Rain amount (mm)
-    float rainRate;              // Rain intensity (mm/h)
-    float dailyRainTotal;        // Daily precipitation total (mm) - resets at midnight
-    unsigned long lastRainReset; // Timestamp of last daily total reset
-
-    float temperatureCorrection; // Correction offset for temperature
-    float humidityCorrection;    // Correction offset for humidity
-    float pressureCorrection;    // Correction offset for pressure
-    float ppmCorrection;         // Correction offset for CO2 concentration
-    float luxCorrection;         // Correction offset for light intensity
-    float windSpeedCorrection;   // Correction factor for wind speed (multiplier)
-    int windDirectionCorrection; // Correction offset for wind direction (degrees)
-    float rainAmountCorrection;  // Correction factor for rain amount (multiplier)
-    float rainRateCorrection;    // Correction factor for rain rate (multiplier)
+    int16_t temperatureCenti; // Temperature (0.01 °C) - BME280, SCD40, METEO, DIY_TEMP
+    uint16_t humidityCenti;   // Humidity (0.01 %) - BME280, SCD40, METEO
+    uint16_t pressureDeci;    // Pressure (0.1 hPa) - BME280, METEO
+    uint16_t co2Ppm;          // CO2 concentration (ppm) - SCD40
+
+    // Variables for METEO sensor
+    uint32_t windSpeedCenti;           // Wind speed (0.01 m/s)
+    uint32_t luxCenti;                 // Light intensity (0.01 lux) - VEML7700
+    uint32_t rainAmountTenthMilli;     // Rain amount (0.0001 mm, sensor resolution is 0.0002 mm)
+    uint32_t rainRateMilli;            // Rain intensity (0.001 mm/h)
+    uint32_t dailyRainTotalTenthMilli; // Daily precipitation total (0.0001 mm) - resets at midnight
+    unsigned long lastRainReset;       // Timestamp of last daily total reset
+    uint16_t batteryMillivolts;        // Battery voltage (mV)
 
     // General device data
-    float batteryVoltage; // Battery voltage (V)
-    int rssi;             // Signal strength (dBm)
+    int rssi;               // Signal strength (dBm)
+    unsigned long lastSeen; // Time of last seen packet
 
     // Constructor for initialization with default values
-    SensorData() : deviceType(SensorType::UNKNOWN),
-                   serialNumber(0),
-                   deviceKey(0),
-                   name(""),
-                   customUrl(""),
-                   altitude(0),
-                   lastSeen(0),
-                   configured(false),
-                   temperature(0.0f),
-                   humidity(0.0f),
-                   pressure(0.0f),
-                   ppm(0.0f),
-                   lux(0.0f),
-                   batteryVoltage(0.0f),
-                   rssi(0),
-                   windSpeed(0.0f),
-                   windDirection(0),
-                   rainAmount(0.0f),
-                   rainRate(0.0f),
-                   dailyRainTotal(0.0f),
-                   lastRainReset(0),
-                   temperatureCorrection(0.0f),
-                   humidityCorrection(0.0f),
-                   pressureCorrection(0.0f),
-                   ppmCorrection(0.0f),
-                   luxCorrection(0.0f),
-                   windSpeedCorrection(1.0f), // Multiplier of 1.0 = no change
-                   windDirectionCorrection(0),
-                   rainAmountCorrection(1.0f),
-                   rainRateCorrection(1.0f)
+    SensorReadings() : serialNumber(0),
+                       deviceKey(0),
+                       deviceType(SensorType::UNKNOWN),
+                       configured(false),
+                       windDirection(0),
+                       temperatureCenti(0),
+                       humidityCenti(0),
+                       pressureDeci(0),
+                       co2Ppm(0),
+                       windSpeedCenti(0),
+                       luxCenti(0),
+                       rainAmountTenthMilli(0),
+                       rainRateMilli(0),
+                       dailyRainTotalTenthMilli(0),
+                       lastRainReset(0),
+                       batteryMillivolts(0),
+                       rssi(0),
+                       lastSeen(0)
     {
     }
 
+    // Measurements as text with given number of decimals (formatted from the integers)
+    String getTemperatureString(uint8_t decimals = 2) const { return FixedPoint::toString(temperatureCenti, 2, decimals); }
+    String getHumidityString(uint8_t decimals = 2) const { return FixedPoint::toString(humidityCenti, 2, decimals); }
+    String getPressureString(uint8_t decimals = 1) const { return FixedPoint::toString(pressureDeci, 1, decimals); }
+    String getPPMString() const { return FixedPoint::toString(co2Ppm, 0, 0); }
+    String getLuxString(uint8_t decimals = 1) const { return FixedPoint::toString(luxCenti, 2, decimals); }
+    String getWindSpeedString(uint8_t decimals = 1) const { return FixedPoint::toString(windSpeedCenti, 2, decimals); }
+    String getRainAmountString(uint8_t decimals = 1) const { return FixedPoint::toString(rainAmountTenthMilli, 4, decimals); }
+    String getRainRateString(uint8_t decimals = 1) const { return FixedPoint::toString(rainRateMilli, 3, decimals); }
+    String getDailyRainTotalString(uint8_t decimals = 1) const { return FixedPoint::toString(dailyRainTotalTenthMilli, 4, decimals); }
+    String getBatteryVoltageString(uint8_t decimals = 2) const { return FixedPoint::toString(batteryMillivolts, 3, decimals); }
+
     // Helper methods to verify if the sensor provides a specific type of data
     bool hasTemperature() const
     {
@@ -164,75 +156,6 @@ struct SensorData
         return getSensorTypeInfo(deviceType);
     }
 
-    // Convert to JSON for web API and storage
-    void toJson(JsonObject &json) const
-    {
-        json["deviceType"] = static_cast<uint8_t>(deviceType);
-        json["typeName"] = getTypeInfo().name;
-        json["serialNumber"] = String(serialNumber, HEX);
-        json["name"] = name;
-
-        // Add data specific to sensor type with validity check
-        // if (lastSeen > 0) {
-        if (hasTemperature())
-        {
-            json["temperature"] = round(temperature * 100) / 100.0;
-        }
-
-        if (hasHumidity())
-        {
-            json["humidity"] = round(humidity * 100) / 100.0;
-        }
-
-        if (hasPressure())
-        {
-            json["pressure"] = round(pressure * 100) / 100.0;
-        }
-
-        if (hasPPM())
-        {
-            json["ppm"] = round(ppm);
-        }
-
-        if (hasLux())
-        {
-            json["lux"] = round(lux * 10) / 10.0;
-        }
-
-        if (hasWindSpeed())
-        {
-            json["windSpeed"] = round(windSpeed * 10) / 10.0;
-        }
-
-        if (hasWindDirection())
-        {
-            json["windDirection"] = windDirection;
-        }
-
-        if (hasRainAmount())
-        {
-            json["rainAmount"] = round(rainAmount * 100) / 100.0;
-            json["dailyRainTotal"] = round(dailyRainTotal * 100) / 100.0;
-        }
-
-        if (hasRainRate())
-        {
-            json["rainRate"] = round(rainRate * 100) / 100.0;
-        }
-
-        json["batteryVoltage"] = round(batteryVoltage * 100) / 100.0;
-        json["rssi"] = rssi;
-
-        if (lastSeen > 0)
-        {
-            json["lastSeen"] = (millis() - lastSeen) / 1000; // seconds since last seen
-        }
-        else
-        {
-            json["lastSeen"] = -1;
-        }
-    }
-
     // Format data for web display
     String getDataString() const
     {
@@ -248,7 +171,7 @@ struct SensorData
         {
             if (!first)
                 dataStr += ", ";
-            dataStr += String(temperature, 2) + " °C";
+            dataStr += getTemperatureString() + " °C";
             first = false;
         }
 
@@ -256,7 +179,7 @@ struct SensorData
         {
             if (!first)
                 dataStr += ", ";
-            dataStr += String(humidity, 2) + " %";
+            dataStr += getHumidityString() + " %";
             first = false;
         }
 
@@ -264,7 +187,7 @@ struct SensorData
         {
             if (!first)
                 dataStr += ", ";
-            dataStr += String(pressure, 2) + " hPa";
+            dataStr += getPressureString() + " hPa";
             first = false;
         }
 
@@ -272,7 +195,7 @@ struct SensorData
         {
             if (!first)
                 dataStr += ", ";
-            dataStr += String(int(ppm)) + " ppm CO2";
+            dataStr += getPPMString() + " ppm CO2";
             first = false;
         }
 
@@ -280,7 +203,7 @@ struct SensorData
         {
             if (!first)
                 dataStr += ", ";
-            dataStr += String(lux, 1) + " lux";
+            dataStr += getLuxString() + " lux";
             first = false;
         }
 
@@ -288,7 +211,7 @@ struct SensorData
         {
             if (!first)
                 dataStr += ", ";
-            dataStr += String(windSpeed, 1) + " m/s";
+            dataStr += getWindSpeedString() + " m/s";
             first = false;
         }
 
@@ -304,8 +227,8 @@ struct SensorData
         {
             if (!first)
                 dataStr += ", ";
-            dataStr += String(rainAmount, 1) + " mm";
-            dataStr += " (daily precipitation total: " + String(dailyRainTotal, 1) + " mm)";
+            dataStr += getRainAmountString() + " mm";
+            dataStr += " (daily precipitation total: " + getDailyRainTotalString() + " mm)";
             first = false;
         }
 
@@ -313,14 +236,14 @@ struct SensorData
         {
             if (!first)
                 dataStr += ", ";
-            dataStr += String(rainRate, 1) + " mm/h";
+            dataStr += getRainRateString() + " mm/h";
             first = false;
         }
 
         // Add battery voltage
         if (!first)
             dataStr += ", ";
-        dataStr += String(batteryVoltage, 2) + " V";
+        dataStr += getBatteryVoltageString() + " V";
 
         return dataStr;
     }
@@ -347,4 +270,253 @@ struct SensorData
             return String(seconds / 3600) + " hours ago";
         }
     }
-};
\ No newline at end of file
+
+    // Convert to JSON for web API, name comes from the configuration
+    void toJson(JsonObject &json, const String &name) const
+    {
+        json["deviceType"] = static_cast<uint8_t>(deviceType);
+        json["typeName"] = getTypeInfo().name;
+        json["serialNumber"] = String(serialNumber, HEX);
+        json["name"] = name;
+
+        // Add data specific to sensor type with validity check
+        // if (lastSeen > 0) {
+        if (hasTemperature())
+        {
+            json["temperature"] = serialized(getTemperatureString(2));
+        }
+
+        if (hasHumidity())
+        {
+            json["humidity"] = serialized(getHumidityString(2));
+        }
+
+        if (hasPressure())
+        {
+            json["pressure"] = serialized(getPressureString(1));
+        }
+
+        if (hasPPM())
+        {
+            json["ppm"] = co2Ppm;
+        }
+
+        if (hasLux())
+        {
+            json["lux"] = serialized(getLuxString(1));
+        }
+
+        if (hasWindSpeed())
+        {
+            json["windSpeed"] = serialized(getWindSpeedString(1));
+        }
+
+        if (hasWindDirection())
+        {
+            json["windDirection"] = windDirection;
+        }
+
+        if (hasRainAmount())
+        {
+            json["rainAmount"] = serialized(getRainAmountString(2));
+            json["dailyRainTotal"] = serialized(getDailyRainTotalString(2));
+        }
+
+        if (hasRainRate())
+        {
+            json["rainRate"] = serialized(getRainRateString(2));
+        }
+
+        json["batteryVoltage"] = serialized(getBatteryVoltageString(2));
+        json["rssi"] = rssi;
+
+        if (lastSeen > 0)
+        {
+            json["lastSeen"] = (millis() - lastSeen) / 1000; // seconds since last seen
+        }
+        else
+        {
+            json["lastSeen"] = -1;
+        }
+    }
+};
+
+/**
+ * Configuration of a sensor
+ *
+ * Set from the web interface and read when a packet is calibrated or
+ * forwarded. Holds the Strings (name, custom URL) and the compiled URL
+ * template, so it is kept apart from the packed readings.
+ */
+struct SensorConfig
+{
+    float temperatureCorrection; // Correction offset for temperature
+    float humidityCorrection;    // Correction offset for humidity
+    float pressureCorrection;    // Correction offset for pressure
+    float ppmCorrection;         // Correction offset for CO2 concentration
+    float luxCorrection;         // Correction offset for light intensity
+    float windSpeedCorrection;   // Correction factor for wind speed (multiplier)
+    int windDirectionCorrection; // Correction offset for wind direction (degrees)
+    float rainAmountCorrection;  // Correction factor for rain amount (multiplier)
+    float rainRateCorrection;    // Correction factor for rain rate (multiplier)
+    int altitude;                // Altitude (m) - for BME280
+
+    // Corrections in units of the readings, see prepareCorrections()
+    int32_t temperatureOffset; // 0.01 °C
+    int32_t humidityOffset;    // 0.01 %
+    int32_t pressureOffset;    // 0.1 hPa
+    int32_t ppmOffset;         // ppm
+    int32_t luxOffset;         // 0.01 lux
+    int32_t windSpeedFactor;   // Thousandths
+    int32_t rainAmountFactor;  // Thousandths
+    int32_t rainRateFactor;    // Thousandths
+
+    String name;             // User-defined sensor name
+    String customUrl;        // Complete URL with placeholders
+    UrlTemplate urlTemplate; // customUrl parsed for forwarding, see SensorManager::saveSensors()
+
+    // Constructor for initialization with default values
+    SensorConfig() : temperatureCorrection(0.0f),
+                     humidityCorrection(0.0f),
+                     pressureCorrection(0.0f),
+                     ppmCorrection(0.0f),
+                     luxCorrection(0.0f),
+                     windSpeedCorrection(1.0f), // Multiplier of 1.0 = no change
+                     windDirectionCorrection(0),
+                     rainAmountCorrection(1.0f),
+                     rainRateCorrection(1.0f),
+                     altitude(0),
+                     name(""),
+                     customUrl("")
+    {
+        prepareCorrections();
+    }
+
+    // Convert corrections to fixed point once, so packets are corrected with integer arithmetic
+    // (call whenever corrections change, like urlTemplate.compile())
+    void prepareCorrections()
+    {
+        temperatureOffset = FixedPoint::fromFloat(temperatureCorrection, 2);
+        humidityOffset = FixedPoint::fromFloat(humidityCorrection, 2);
+        pressureOffset = FixedPoint::fromFloat(pressureCorrection, 1);
+        ppmOffset = FixedPoint::fromFloat(ppmCorrection, 0);
+        luxOffset = FixedPoint::fromFloat(luxCorrection, 2);
+        windSpeedFactor = FixedPoint::fromFloat(windSpeedCorrection, 3);
+        rainAmountFactor = FixedPoint::fromFloat(rainAmountCorrection, 3);
+        rainRateFactor = FixedPoint::fromFloat(rainRateCorrection, 3);
+    }
+};
+
+/**
+ * Structure for storing sensor data
+ *
+ * Complete copy of a sensor - readings and configuration - for callers that
+ * keep sensors by value (web pages, API). SensorManager stores both parts
+ * separately, see SensorView.
+ */
+struct SensorData : SensorReadings, SensorConfig
+{
+    SensorData() {}
+
+    SensorData(const SensorReadings &readings, const SensorConfig &config)
+        : SensorReadings(readings), SensorConfig(config)
+    {
+    }
+};
+
+struct SensorSnapshot;
+
+/**
+ * Read-only view of a sensor returned by SensorManager
+ *
+ * Holds a consistent copy of the readings and refers to the configuration in
+ * the published SensorSnapshot, which the view keeps alive - no Strings are
+ * copied and the view stays valid even if the sensor is reconfigured or
+ * deleted meanwhile. Evaluates to false for a missing sensor.
+ */
+class SensorView
+{
+private:
+    SensorReadings readingsCopy;
+    const SensorConfig *configPtr;
+    std::shared_ptr<const SensorSnapshot> owner; // Snapshot holding the configuration (empty while iterating it)
+
+public:
+    SensorView() : configPtr(nullptr) {}
+    SensorView(const SensorReadings &readings, const SensorConfig &config,
+               std::shared_ptr<const SensorSnapshot> snapshot = nullptr)
+        : readingsCopy(readings), configPtr(&config), owner(snapshot)
+    {
+    }
+
+    explicit operator bool() const { return configPtr != nullptr; }
+
+    const SensorReadings &readings() const { return readingsCopy; }
+    const SensorConfig &config() const { return *configPtr; }
+
+    // Readings are accessed most, so they are reachable directly (sensor->temperatureCenti)
+    const SensorReadings *operator->() const { return &readingsCopy; }
+
+    // Copy both parts into a SensorData
+    SensorData toSensorData() const { return SensorData(readingsCopy, *configPtr); }
+
+    // Convert to JSON for web API
+    void toJson(JsonObject &json) const { readingsCopy.toJson(json, configPtr->name); }
+};
+
+/**
+ * Configuration part of a SensorSnapshot
+ *
+ * Built by SensorManager whenever configuration changes and shared by all
+ * snapshots taken until the next change, so refreshing readings never
+ * copies names, URLs or URL templates.
+ */
+struct SensorSnapshotConfig
+{
+    uint32_t generation;               // SensorManager configuration generation it was built at
+    std::vector<SensorConfig> configs; // Configuration of each sensor in slot order
+    std::vector<int> indices;          // Slot index of each sensor (for edit and delete links)
+    std::vector<int> positions;        // Position of each slot in configs, -1 for free slots
+
+    SensorSnapshotConfig() : generation(0) {}
+};
+
+/**
+ * Immutable copy of all configured sensors
+ *
+ * SensorManager publishes a new snapshot whenever configuration changes
+ * (read-copy-update): readers load the current one without taking the sensor
+ * lock, and a snapshot lives as long as somebody holds it. Readings in the
+ * snapshot are refreshed by getSnapshot() at most once per change of sensor
+ * data and shared by all readers, so web pages and MQTT discovery neither
+ * block the radio path nor copy the sensors again. A refresh copies only the
+ * readings, the configuration part is shared with the previous snapshot.
+ */
+struct SensorSnapshot
+{
+    uint32_t version;                                          // SensorManager data version the readings were taken at
+    std::vector<SensorReadings> readings;                      // Readings of each configured sensor in slot order
+    std::shared_ptr<const SensorSnapshotConfig> configuration; // Configuration of the same sensors
+
+    SensorSnapshot() : version(0), configuration(std::make_shared<SensorSnapshotConfig>()) {}
+    explicit SensorSnapshot(std::shared_ptr<const SensorSnapshotConfig> config) : version(0), configuration(config) {}
+
+    // Number of sensors
+    size_t size() const { return readings.size(); }
+    bool empty() const { return readings.empty(); }
+
+    // Sensor at position (the view refers to configuration held by this snapshot)
+    SensorView operator[](size_t position) const { return SensorView(readings[position], configuration->configs[position]); }
+    const SensorConfig &config(size_t position) const { return configuration->configs[position]; }
+
+    // Slot index of sensor at position
+    int indexAt(size_t position) const { return configuration->indices[position]; }
+
+    // Position of sensor in given slot, -1 if there is none
+    int positionOf(int index) const
+    {
+        return index >= 0 && index < (int)configuration->positions.size() ? configuration->positions[index] : -1;
+    }
+};
+
+typedef std::shared_ptr<const SensorSnapshot> SensorSnapshotPtr;
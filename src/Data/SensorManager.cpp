@@ -22,11 +22,18 @@
 #include "SensorManager.h"
 #include <ArduinoJson.h>
 #include <LittleFS.h>
-#include <HTTPClient.h>
+#include <WiFi.h>
+#include <esp_timer.h>
+#include "PacketLatency.h"
+#include "../Protocol/HttpForwarder.h"
+#include "../Storage/SensorRegistryFile.h"
 
 // Constructor
 SensorManager::SensorManager(Logger &log, const char *file)
-    : sensorCount(0), logger(log), sensorsFile(file)
+    : sensorCount(0), logger(log), httpForwarder(nullptr), configGeneration(0), dataVersion(0),
+      snapshot(std::make_shared<SensorSnapshot>()), sensorsFile(file), loadTime(0),
+      dirty(false), firstDirtyTime(0), lastDirtyTime(0), serializedVersion(0),
+      configDirty(false), configDirtyTime(0), stateJournal(log), writtenVersion(0), saveCount(0), bytesWritten(0)
 {
 }
 
@@ -40,7 +47,92 @@ SensorManager::~SensorManager()
 bool SensorManager::init()
 {
     logger.info("Initializing sensor manager");
-    return loadSensors();
+
+    // Configuration from before the binary registry is imported once
+    if (!LittleFS.exists(sensorsFile) && LittleFS.exists(SENSORS_JSON_FILE))
+    {
+        logger.info("Migrating sensors from " + String(SENSORS_JSON_FILE) + " to " + String(sensorsFile));
+        if (!loadSensorsJson(SENSORS_JSON_FILE))
+        {
+            return false;
+        }
+        saveSensors(true);
+        restoreState();
+    }
+    else if (!loadSensors())
+    {
+        return false;
+    }
+
+    return true;
+}
+
+// Restore sensor state from journal
+void SensorManager::restoreState()
+{
+    std::lock_guard<std::mutex> journalLock(journalMutex);
+
+    std::vector<StateJournal::Record> records;
+
+    {
+        std::lock_guard<std::mutex> lock(sensorMutex);
+
+        // Values loaded from an older sensors file are overridden by journaled ones
+        auto apply = [this](uint32_t serialNumber, StateJournal::Field field, uint32_t value)
+        {
+            int index = indexOfSerial(serialNumber);
+            if (index < 0)
+            {
+                return; // Sensor was deleted
+            }
+
+            SensorReadings &sensor = sensors.beginWrite(index);
+            if (field == StateJournal::Field::DAILY_RAIN_TOTAL)
+            {
+                sensor.dailyRainTotalTenthMilli = FixedPoint::fromFloat(StateJournal::toFloat(value), 4);
+            }
+            else if (field == StateJournal::Field::LAST_RAIN_RESET)
+            {
+                sensor.lastRainReset = value;
+            }
+            sensors.endWrite(index);
+        };
+        stateJournal.replay(apply);
+        dataVersion++;
+
+        // Snapshot already matches and journal is empty
+        if (stateJournal.getReplayedRecords() > 0 && stateJournal.getJournalRecords() == 0 &&
+            !stateJournal.needsCompaction())
+        {
+            return;
+        }
+
+        for (size_t i = 0; i < sensorCount; i++)
+        {
+            collectState(i, records);
+        }
+    }
+
+    // Fold journal into snapshot after every load, so replay stays short and
+    // a corrupted tail is dropped before anything is appended after it
+    if (!records.empty() || stateJournal.getReplayedRecords() > 0 || stateJournal.needsCompaction())
+    {
+        stateJournal.compact(records.data(), records.size());
+    }
+}
+
+// Add journal records with state of sensor
+void SensorManager::collectState(int index, std::vector<StateJournal::Record> &records)
+{
+    const SensorReadings &sensor = sensors.readings(index);
+    if (!sensor.configured || !sensor.hasRainAmount())
+    {
+        return;
+    }
+
+    records.push_back(StateJournal::makeRecord(sensor.serialNumber, StateJournal::Field::DAILY_RAIN_TOTAL,
+                                                 FixedPoint::toFloat(sensor.dailyRainTotalTenthMilli, 4)));
+    records.push_back(StateJournal::makeRecord(sensor.serialNumber, StateJournal::Field::LAST_RAIN_RESET, (uint32_t)sensor.lastRainReset));
 }
 
 // Constants for pressure conversion
@@ -67,81 +159,153 @@ int SensorManager::addSensor(SensorType deviceType, uint32_t serialNumber, uint3
     std::lock_guard<std::mutex> lock(sensorMutex);
 
     // Check if sensor already exists
-    int existingIndex = findSensorBySN(serialNumber);
+    int existingIndex = indexOfSerial(serialNumber);
     if (existingIndex >= 0)
     {
         // Update existing sensor
-        sensors[existingIndex].deviceType = deviceType;
-        sensors[existingIndex].deviceKey = deviceKey;
-        sensors[existingIndex].name = name;
-        sensors[existingIndex].configured = true;
+        unindexSensor(existingIndex);
+        SensorReadings &sensor = sensors.beginWrite(existingIndex);
+        sensor.deviceType = deviceType;
+        sensor.deviceKey = deviceKey;
+        sensor.configured = true;
+        sensors.endWrite(existingIndex);
+        sensors.config(existingIndex).name = name;
+        indexSensor(existingIndex);
+        dataVersion++;
+        publishSnapshot();
 
         logger.info("Updated existing sensor: " + name + " (SN: " + String(serialNumber, HEX) + ")");
-        saveSensors(false);
+        markConfigDirty();
         return existingIndex;
     }
 
-    // Check if we still have space
-    if (sensorCount >= MAX_SENSORS)
-    {
-        logger.error("Failed to add sensor: maximum number of sensors reached");
-        return -1;
-    }
-
     // Find first free slot
     int newIndex = -1;
-    for (size_t i = 0; i < MAX_SENSORS; i++)
+    for (size_t i = 0; i < sensorCount; i++)
     {
-        if (!sensors[i].configured)
+        if (!sensors.readings(i).configured)
         {
             newIndex = i;
             break;
         }
     }
 
-    // If no free slot, use the last index
+    // If no free slot, append one
     if (newIndex == -1)
     {
+        if (!reserveSlots(sensorCount + 1))
+        {
+            logger.error("Failed to add sensor: maximum number of sensors reached or out of memory");
+            return -1;
+        }
         newIndex = sensorCount;
         sensorCount++;
     }
-    else if (newIndex >= sensorCount)
-    {
-        sensorCount = newIndex + 1;
-    }
 
     // Initialize new sensor
-    sensors[newIndex].deviceType = deviceType;
-    sensors[newIndex].serialNumber = serialNumber;
-    sensors[newIndex].deviceKey = deviceKey;
-    sensors[newIndex].name = name;
-    sensors[newIndex].customUrl = "";
-    sensors[newIndex].lastSeen = 0;
-    sensors[newIndex].temperature = 0.0f;
-    sensors[newIndex].humidity = 0.0f;
-    sensors[newIndex].pressure = 0.0f;
-    sensors[newIndex].ppm = 0.0f;
-    sensors[newIndex].lux = 0.0f;
-    sensors[newIndex].batteryVoltage = 0.0f;
-    sensors[newIndex].rssi = 0;
-    sensors[newIndex].configured = true;
+    SensorReadings &sensor = sensors.beginWrite(newIndex);
+    sensor.deviceType = deviceType;
+    sensor.serialNumber = serialNumber;
+    sensor.deviceKey = deviceKey;
+    sensor.lastSeen = 0;
+    sensor.temperatureCenti = 0;
+    sensor.humidityCenti = 0;
+    sensor.pressureDeci = 0;
+    sensor.co2Ppm = 0;
+    sensor.luxCenti = 0;
+    sensor.batteryMillivolts = 0;
+    sensor.rssi = 0;
+    sensor.configured = true;
+    sensors.endWrite(newIndex);
+    sensors.config(newIndex).name = name;
+    sensors.config(newIndex).customUrl = "";
+    sensors.config(newIndex).urlTemplate.compile(sensors.config(newIndex).customUrl);
+    indexSensor(newIndex);
+    dataVersion++;
+    publishSnapshot();
 
     logger.info("Added new sensor: " + name + " (SN: " + String(serialNumber, HEX) + ")");
-    saveSensors(false);
+    markConfigDirty();
     return newIndex;
 }
 
 // Find sensor by serial number
-int SensorManager::findSensorBySN(uint32_t serialNumber)
+int SensorManager::findSensorBySN(uint32_t serialNumber) const
 {
-    for (size_t i = 0; i < sensorCount; i++)
+    std::lock_guard<std::mutex> lock(sensorMutex);
+    return indexOfSerial(serialNumber);
+}
+
+// Find configured sensor by serial number
+int SensorManager::indexOfSerial(uint32_t serialNumber) const
+{
+    auto it = serialIndex.find(serialNumber);
+    return it != serialIndex.end() ? it->second : -1;
+}
+
+// Allocate slots 0..count-1
+bool SensorManager::reserveSlots(size_t count)
+{
+    if (!sensors.reserve(count))
+    {
+        return false;
+    }
+    stateDirty.resize(sensors.getCapacity(), false);
+    return true;
+}
+
+// Compute key tag of sensor
+// Serial number bytes 2..4 of a packet are encrypted with key bytes 2, 3 and 0
+// (plus the rolling term derived from ciphertext only), so folding the key bytes
+// into the serial number gives a value that can be computed from the raw packet.
+uint32_t SensorManager::computeKeyTag(uint32_t serialNumber, uint32_t deviceKey)
+{
+    uint8_t *key_bytes = (uint8_t *)&deviceKey;
+    uint32_t keyMask = ((uint32_t)key_bytes[2] << 16) | ((uint32_t)key_bytes[3] << 8) | key_bytes[0];
+    return (serialNumber ^ keyMask) & 0xFFFFFF;
+}
+
+// Add sensor to key tag and serial number indexes
+void SensorManager::indexSensor(int index)
+{
+    keyTagIndex.emplace(computeKeyTag(sensors.readings(index).serialNumber, sensors.readings(index).deviceKey), index);
+    serialIndex.emplace(sensors.readings(index).serialNumber, index); // First sensor with a serial number wins
+}
+
+// Remove sensor from key tag and serial number indexes
+void SensorManager::unindexSensor(int index)
+{
+    auto serial = serialIndex.find(sensors.readings(index).serialNumber);
+    if (serial != serialIndex.end() && serial->second == index)
+    {
+        serialIndex.erase(serial);
+    }
+
+    auto range = keyTagIndex.equal_range(computeKeyTag(sensors.readings(index).serialNumber, sensors.readings(index).deviceKey));
+    for (auto it = range.first; it != range.second; ++it)
     {
-        if (sensors[i].configured && sensors[i].serialNumber == serialNumber)
+        if (it->second == index)
         {
-            return i;
+            keyTagIndex.erase(it);
+            return;
         }
     }
-    return -1;
+}
+
+// Find candidate sensors for a packet key tag
+size_t SensorManager::findSensorsByKeyTag(uint32_t keyTag, int *indices, uint32_t *keys, size_t maxCount) const
+{
+    std::lock_guard<std::mutex> lock(sensorMutex);
+
+    size_t count = 0;
+    auto range = keyTagIndex.equal_range(keyTag & 0xFFFFFF);
+    for (auto it = range.first; it != range.second && count < maxCount; ++it)
+    {
+        indices[count] = it->second;
+        keys[count] = sensors.readings(it->second).deviceKey;
+        count++;
+    }
+    return count;
 }
 
 // Update sensor data
@@ -149,182 +313,194 @@ bool SensorManager::updateSensor(int index, const SensorData &data)
 {
     std::lock_guard<std::mutex> lock(sensorMutex);
 
-    if (index < 0 || index >= sensorCount || !sensors[index].configured)
+    if (index < 0 || index >= (int)sensorCount || !sensors.readings(index).configured)
     {
         logger.warning("Attempt to update non-existent sensor at index " + String(index));
         return false;
     }
 
     // Update data while preserving configuration
-    sensors[index].deviceType = data.deviceType;
-    sensors[index].temperature = data.temperature;
-    sensors[index].humidity = data.humidity;
-    sensors[index].pressure = data.pressure;
-    sensors[index].ppm = data.ppm;
-    sensors[index].lux = data.lux;
-    sensors[index].batteryVoltage = data.batteryVoltage;
-    sensors[index].rssi = data.rssi;
-    sensors[index].lastSeen = millis();
+    SensorReadings &sensor = sensors.beginWrite(index);
+    sensor.deviceType = data.deviceType;
+    sensor.temperatureCenti = data.temperatureCenti;
+    sensor.humidityCenti = data.humidityCenti;
+    sensor.pressureDeci = data.pressureDeci;
+    sensor.co2Ppm = data.co2Ppm;
+    sensor.luxCenti = data.luxCenti;
+    sensor.batteryMillivolts = data.batteryMillivolts;
+    sensor.rssi = data.rssi;
+    sensor.lastSeen = millis();
+    sensors.endWrite(index);
+    dataVersion++;
 
     return true;
 }
 
+// Append "name old→new unit" to comma separated correction log
+static void appendCorrection(char (&log)[LOG_MESSAGE_SIZE], size_t &used, const char *name, const char *before,
+                             const char *after, const char *unit)
+{
+    if (used >= sizeof(log))
+    {
+        return;
+    }
+    int written = snprintf(log + used, sizeof(log) - used, "%s%s %s→%s%s", used > 0 ? ", " : "", name, before,
+                           after, unit);
+    used = written > 0 ? used + written : used;
+}
+
 // Update sensor data by type
-bool SensorManager::updateSensorData(int index, float temperature, float humidity, float pressure,
-                                     float ppm, float lux, float batteryVoltage, int rssi,
-                                     float windSpeed, uint16_t windDirection,
-                                     float rainAmount, float rainRate)
+bool SensorManager::updateSensorData(int index, int16_t temperatureCenti, uint16_t humidityCenti, uint16_t pressureDeci,
+                                     uint16_t co2Ppm, uint32_t luxCenti, uint16_t batteryMillivolts, int rssi,
+                                     uint32_t windSpeedCenti, uint16_t windDirection,
+                                     uint32_t rainAmountTenthMilli, uint32_t rainRateMilli)
 {
+    int64_t updateStart = esp_timer_get_time();
     std::lock_guard<std::mutex> lock(sensorMutex);
 
-    if (index < 0 || index >= sensorCount || !sensors[index].configured)
+    if (index < 0 || index >= (int)sensorCount || !sensors.readings(index).configured)
     {
         logger.warning("Attempt to update non-existent sensor at index " + String(index));
         return false;
     }
 
-    // Store original values for logging
-    float originalTemp = temperature;
-    float originalHum = humidity;
-    float originalPress = pressure;
-    float originalPPM = ppm;
-    float originalLux = lux;
-    float originalWindSpeed = windSpeed;
-    uint16_t originalWindDir = windDirection;
-    float originalRainAmount = rainAmount;
-    float originalRainRate = rainRate;
-
-    // Apply corrections to input values before updating
-    temperature += sensors[index].temperatureCorrection;
-    humidity += sensors[index].humidityCorrection;
-    pressure += sensors[index].pressureCorrection;
-    ppm += sensors[index].ppmCorrection;
-    lux += sensors[index].luxCorrection;
-    windSpeed *= sensors[index].windSpeedCorrection;
+    // Packet path touches the packed readings and only the numeric part of the configuration.
+    // Readers retry until endWrite(), so they never see a half-updated sensor.
+    SensorReadings &sensor = sensors.beginWrite(index);
+    const SensorConfig &config = sensors.config(index);
+
+    // Apply corrections (prepared in fixed point units) before updating
+    int32_t temperature = temperatureCenti + config.temperatureOffset;
+    int32_t humidity = humidityCenti + config.humidityOffset;
+    int32_t pressure = pressureDeci + config.pressureOffset;
+    int32_t ppm = co2Ppm + config.ppmOffset;
+    int32_t lux = (int32_t)luxCenti + config.luxOffset;
+    int32_t windSpeed = FixedPoint::scale(windSpeedCenti, config.windSpeedFactor);
+    int32_t rainAmount = FixedPoint::scale(rainAmountTenthMilli, config.rainAmountFactor);
+    int32_t rainRate = FixedPoint::scale(rainRateMilli, config.rainRateFactor);
 
     // For wind direction, ensure value stays in 0-359 range
-    windDirection = (windDirection + sensors[index].windDirectionCorrection) % 360;
-
-    rainAmount *= sensors[index].rainAmountCorrection;
-    rainRate *= sensors[index].rainRateCorrection;
-
-    // Log if corrections were applied
-    bool correctionsApplied = false;
-    String correctionLog = "Corrections applied to " + sensors[index].name + ": ";
+    uint16_t correctedWindDirection = ((windDirection + config.windDirectionCorrection) % 360 + 360) % 360;
 
-    if (sensors[index].hasTemperature() && sensors[index].temperatureCorrection != 0)
+    // Log if corrections were applied (message is only built when it is logged)
+    if (LOGF_ENABLED(DEBUG))
     {
-        correctionLog += "Temp " + String(originalTemp, 2) + "→" + String(temperature, 2) + "°C, ";
-        correctionsApplied = true;
-    }
+        char correctionLog[LOG_MESSAGE_SIZE];
+        size_t used = 0;
 
-    if (sensors[index].hasHumidity() && sensors[index].humidityCorrection != 0)
-    {
-        correctionLog += "Hum " + String(originalHum, 2) + "→" + String(humidity, 2) + "%, ";
-        correctionsApplied = true;
-    }
+        if (sensor.hasTemperature() && config.temperatureOffset != 0)
+        {
+            appendCorrection(correctionLog, used, "Temp", FixedPoint::Text(temperatureCenti, 2, 2).c_str(),
+                             FixedPoint::Text(temperature, 2, 2).c_str(), "°C");
+        }
 
-    if (sensors[index].hasPressure() && sensors[index].pressureCorrection != 0)
-    {
-        correctionLog += "Press " + String(originalPress, 2) + "→" + String(pressure, 2) + "hPa, ";
-        correctionsApplied = true;
-    }
+        if (sensor.hasHumidity() && config.humidityOffset != 0)
+        {
+            appendCorrection(correctionLog, used, "Hum", FixedPoint::Text(humidityCenti, 2, 2).c_str(),
+                             FixedPoint::Text(humidity, 2, 2).c_str(), "%");
+        }
 
-    if (sensors[index].hasPPM() && sensors[index].ppmCorrection != 0)
-    {
-        correctionLog += "CO2 " + String(originalPPM, 0) + "→" + String(ppm, 0) + "ppm, ";
-        correctionsApplied = true;
-    }
+        if (sensor.hasPressure() && config.pressureOffset != 0)
+        {
+            appendCorrection(correctionLog, used, "Press", FixedPoint::Text(pressureDeci, 1, 1).c_str(),
+                             FixedPoint::Text(pressure, 1, 1).c_str(), "hPa");
+        }
 
-    if (sensors[index].hasLux() && sensors[index].luxCorrection != 0)
-    {
-        correctionLog += "Lux " + String(originalLux, 1) + "→" + String(lux, 1) + "lx, ";
-        correctionsApplied = true;
-    }
+        if (sensor.hasPPM() && config.ppmOffset != 0)
+        {
+            appendCorrection(correctionLog, used, "CO2", FixedPoint::Text(co2Ppm, 0, 0).c_str(),
+                             FixedPoint::Text(ppm, 0, 0).c_str(), "ppm");
+        }
 
-    if (sensors[index].hasWindSpeed() && sensors[index].windSpeedCorrection != 1.0f)
-    {
-        correctionLog += "Wind " + String(originalWindSpeed, 1) + "→" + String(windSpeed, 1) + "m/s, ";
-        correctionsApplied = true;
-    }
+        if (sensor.hasLux() && config.luxOffset != 0)
+        {
+            appendCorrection(correctionLog, used, "Lux", FixedPoint::Text(luxCenti, 2, 1).c_str(),
+                             FixedPoint::Text(lux, 2, 1).c_str(), "lx");
+        }
 
-    if (sensors[index].hasWindDirection() && sensors[index].windDirectionCorrection != 0)
-    {
-        correctionLog += "Dir " + String(originalWindDir) + "→" + String(windDirection) + "°, ";
-        correctionsApplied = true;
-    }
+        if (sensor.hasWindSpeed() && config.windSpeedFactor != 1000)
+        {
+            appendCorrection(correctionLog, used, "Wind", FixedPoint::Text(windSpeedCenti, 2, 1).c_str(),
+                             FixedPoint::Text(windSpeed, 2, 1).c_str(), "m/s");
+        }
 
-    if (sensors[index].hasRainAmount() && sensors[index].rainAmountCorrection != 1.0f)
-    {
-        correctionLog += "Rain " + String(originalRainAmount, 1) + "→" + String(rainAmount, 1) + "mm, ";
-        correctionsApplied = true;
-    }
+        if (sensor.hasWindDirection() && config.windDirectionCorrection != 0)
+        {
+            appendCorrection(correctionLog, used, "Dir", FixedPoint::Text(windDirection, 0, 0).c_str(),
+                             FixedPoint::Text(correctedWindDirection, 0, 0).c_str(), "°");
+        }
 
-    if (sensors[index].hasRainRate() && sensors[index].rainRateCorrection != 1.0f)
-    {
-        correctionLog += "Rate " + String(originalRainRate, 1) + "→" + String(rainRate, 1) + "mm/h, ";
-        correctionsApplied = true;
-    }
+        if (sensor.hasRainAmount() && config.rainAmountFactor != 1000)
+        {
+            appendCorrection(correctionLog, used, "Rain", FixedPoint::Text(rainAmountTenthMilli, 4, 1).c_str(),
+                             FixedPoint::Text(rainAmount, 4, 1).c_str(), "mm");
+        }
 
-    // Log corrections if any were applied
-    if (correctionsApplied)
-    {
-        // Remove trailing comma and space
-        correctionLog = correctionLog.substring(0, correctionLog.length() - 2);
-        logger.debug(correctionLog);
+        if (sensor.hasRainRate() && config.rainRateFactor != 1000)
+        {
+            appendCorrection(correctionLog, used, "Rate", FixedPoint::Text(rainRateMilli, 3, 1).c_str(),
+                             FixedPoint::Text(rainRate, 3, 1).c_str(), "mm/h");
+        }
+
+        // Log corrections if any were applied
+        if (used > 0)
+        {
+            Logger::logf(LogLevel::DEBUG, "Corrections applied to %s: %s", config.name.c_str(), correctionLog);
+        }
     }
 
-    // Adjust pressure for altitude
+    // Adjust pressure for altitude (the only floating point step, and only with altitude set)
     // Only adjust if the sensor has pressure capability and altitude is set
-    if (sensors[index].hasPressure() && sensors[index].altitude > 0)
+    if (sensor.hasPressure() && config.altitude > 0)
     {
-        float adjustedPressure = relativeToAbsolutePressure(pressure, sensors[index].altitude, temperature);
-        logger.debug("Adjusted pressure from " + String(pressure, 2) + " hPa to " +
-                     String(adjustedPressure, 2) + " hPa at altitude " +
-                     String(sensors[index].altitude) + " m");
-        pressure = adjustedPressure;
+        double adjustedPressure = relativeToAbsolutePressure(FixedPoint::toFloat(pressure, 1), config.altitude,
+                                                             FixedPoint::toFloat(temperature, 2));
+        int32_t adjusted = FixedPoint::fromFloat(adjustedPressure, 1);
+        LOGF_DEBUG("Adjusted pressure from %s hPa to %s hPa at altitude %d m", FixedPoint::Text(pressure, 1, 1).c_str(),
+                   FixedPoint::Text(adjusted, 1, 1).c_str(), config.altitude);
+        pressure = adjusted;
     }
 
     // Update only relevant values according to sensor type
-    if (sensors[index].hasTemperature())
+    if (sensor.hasTemperature())
     {
-        sensors[index].temperature = temperature;
+        sensor.temperatureCenti = constrain(temperature, INT16_MIN, INT16_MAX);
     }
 
-    if (sensors[index].hasHumidity())
+    if (sensor.hasHumidity())
     {
-        sensors[index].humidity = humidity;
+        sensor.humidityCenti = constrain(humidity, 0, UINT16_MAX);
     }
 
-    if (sensors[index].hasPressure())
+    if (sensor.hasPressure())
     {
-        sensors[index].pressure = pressure;
+        sensor.pressureDeci = constrain(pressure, 0, UINT16_MAX);
     }
 
-    if (sensors[index].hasPPM())
+    if (sensor.hasPPM())
     {
-        sensors[index].ppm = ppm;
+        sensor.co2Ppm = constrain(ppm, 0, UINT16_MAX);
     }
 
-    if (sensors[index].hasLux())
+    if (sensor.hasLux())
     {
-        sensors[index].lux = lux;
+        sensor.luxCenti = lux > 0 ? lux : 0;
     }
 
     // Meteorological data
-    if (sensors[index].hasWindSpeed())
+    if (sensor.hasWindSpeed())
     {
-        sensors[index].windSpeed = windSpeed;
+        sensor.windSpeedCenti = windSpeed > 0 ? windSpeed : 0;
     }
 
-    if (sensors[index].hasWindDirection())
+    if (sensor.hasWindDirection())
     {
-        sensors[index].windDirection = windDirection;
+        sensor.windDirection = correctedWindDirection;
     }
 
-    if (sensors[index].hasRainAmount())
+    if (sensor.hasRainAmount())
     {
-        sensors[index].rainAmount = rainAmount;
+        sensor.rainAmountTenthMilli = rainAmount > 0 ? rainAmount : 0;
 
         // Check if we need to reset daily total (new day)
         if (Logger::isTimeInitialized())
@@ -339,41 +515,44 @@ bool SensorManager::updateSensorData(int index, float temperature, float humidit
                 // Create timestamps for comparing dates
                 // Date of last reset
                 struct tm lastResetTime;
-                localtime_r((time_t *)&sensors[index].lastRainReset, &lastResetTime);
+                localtime_r((time_t *)&sensor.lastRainReset, &lastResetTime);
 
                 // If last reset was on a different day than today, reset the counter
-                if (sensors[index].lastRainReset == 0 ||
+                if (sensor.lastRainReset == 0 ||
                     lastResetTime.tm_mday != timeinfo.tm_mday ||
                     lastResetTime.tm_mon != timeinfo.tm_mon ||
                     lastResetTime.tm_year != timeinfo.tm_year)
                 {
 
-                    logger.info("Resetting daily rain total for sensor: " + sensors[index].name);
-                    sensors[index].dailyRainTotal = 0.0f;
-                    sensors[index].lastRainReset = now;
+                    LOGF_INFO("Resetting daily rain total for sensor: %s", config.name.c_str());
+                    sensor.dailyRainTotalTenthMilli = 0;
+                    sensor.lastRainReset = now;
+                    markDirty(index);
                 }
             }
         }
 
         // Add current rain amount to daily total
-        sensors[index].dailyRainTotal += rainAmount;
+        sensor.dailyRainTotalTenthMilli += sensor.rainAmountTenthMilli;
 
-        // Log the updated daily total if it has changed
+        // Daily total and its reset are journaled by process(), not from the radio path
         if (rainAmount > 0)
         {
-           saveSensors(false); // Save immediately after updating daily total
+            markDirty(index);
         }
     }
 
-    if (sensors[index].hasRainRate())
+    if (sensor.hasRainRate())
     {
-        sensors[index].rainRate = rainRate;
+        sensor.rainRateMilli = rainRate > 0 ? rainRate : 0;
     }
 
     // Always update general data
-    sensors[index].batteryVoltage = batteryVoltage;
-    sensors[index].rssi = rssi;
-    sensors[index].lastSeen = millis();
+    sensor.batteryMillivolts = batteryMillivolts;
+    sensor.rssi = rssi;
+    sensor.lastSeen = millis();
+    sensors.endWrite(index);
+    dataVersion++;
 
     if (WiFi.status() == WL_CONNECTED)
     {
@@ -381,125 +560,45 @@ bool SensorManager::updateSensorData(int index, float temperature, float humidit
     }
     else
     {
-        logger.debug("Not forwarding data - WiFi not connected");
+        LOGF_DEBUG("Not forwarding data - WiFi not connected");
     }
 
+    PacketLatency::record(LatencyStage::SENSOR_UPDATE, updateStart, esp_timer_get_time());
     return true;
 }
 
+// Queue sensor data for forwarding to custom URL
 bool SensorManager::forwardSensorData(int index)
 {
-    if (index < 0 || index >= sensorCount || !sensors[index].configured)
+    if (index < 0 || index >= (int)sensorCount || !sensors.readings(index).configured)
     {
         logger.warning("Attempt to forward data for non-existent sensor at index " + String(index));
         return false;
     }
 
     // Check if the sensor has a custom endpoint configured
-    if (sensors[index].customUrl.length() == 0)
+    if (sensors.config(index).customUrl.length() == 0)
     {
         // No endpoint configured, nothing to do
         return true;
     }
 
-    // Create a WiFi client for HTTP request
-    WiFiClient client;
-    HTTPClient http;
-
-    // Format the custom URL by replacing placeholders
-    String url = sensors[index].customUrl;
-
-    // Skip if no URL is configured
-    if (url.length() == 0)
-    {
-        return true;
-    }
-
-    // Check if HTTP or HTTPS
-    bool isHttps = url.startsWith("https://");
-
-    // Process the URL - replace placeholders with actual values
-    if (sensors[index].hasTemperature())
-    {
-        url.replace("*TEMP*", String(sensors[index].temperature, 2));
-    }
-    if (sensors[index].hasHumidity())
-    {
-        url.replace("*HUM*", String(sensors[index].humidity, 2));
-    }
-    if (sensors[index].hasPressure())
-    {
-        url.replace("*PRESS*", String(sensors[index].pressure, 2));
-    }
-    if (sensors[index].hasPPM())
-    {
-        url.replace("*PPM*", String(sensors[index].ppm, 0));
-    }
-    if (sensors[index].hasLux())
-    {
-        url.replace("*LUX*", String(sensors[index].lux, 1));
-    }
-
-    // Added placeholders for METEO data
-    if (sensors[index].hasWindSpeed())
-    {
-        url.replace("*WIND_SPEED*", String(sensors[index].windSpeed, 1));
-    }
-    if (sensors[index].hasWindDirection())
-    {
-        url.replace("*WIND_DIR*", String(sensors[index].windDirection));
-    }
-    if (sensors[index].hasRainAmount())
-    {
-        url.replace("*RAIN*", String(sensors[index].rainAmount, 1));
-        url.replace("*DAILY_RAIN*", String(sensors[index].dailyRainTotal, 1)); // New placeholder
-    }
-    if (sensors[index].hasRainRate())
-    {
-        url.replace("*RAIN_RATE*", String(sensors[index].rainRate, 1));
-    }
-
-    // Replace other common placeholders
-    url.replace("*BAT*", String(sensors[index].batteryVoltage, 2));
-    url.replace("*RSSI*", String(sensors[index].rssi));
-    url.replace("*SN*", String(sensors[index].serialNumber, HEX));
-    url.replace("*TYPE*", String(static_cast<uint8_t>(sensors[index].deviceType)));
-
-    logger.debug("Forwarding data for sensor " + sensors[index].name + " to URL: " + url);
-
-    // For HTTPS, use a secure client but with insecure flag
-    if (isHttps)
+    if (httpForwarder == nullptr)
     {
-        WiFiClientSecure *secureClient = new WiFiClientSecure();
-        secureClient->setInsecure(); // Skip certificate validation
-        http.begin(*secureClient, url);
-    }
-    else
-    {
-        http.begin(client, url);
+        LOGF_DEBUG("Not forwarding data - HTTP forwarding not available");
+        return false;
     }
 
-    // Send the request
-    int httpCode = http.GET();
-
-    // Check result
-    if (httpCode > 0)
+    // Fill in values using template compiled when configuration was saved
+    size_t length = sensors.config(index).urlTemplate.expand(sensors.readings(index), forwardUrl, sizeof(forwardUrl));
+    if (length == 0)
     {
-        logger.debug("HTTP request sent, response code: " + String(httpCode));
-        if (httpCode == HTTP_CODE_OK)
-        {
-            String payload = http.getString();
-            logger.debug("Response: " + payload.substring(0, 100)); // Only log first 100 chars
-        }
-    }
-    else
-    {
-        logger.warning("HTTP request failed: " + http.errorToString(httpCode));
+        logger.warning("Custom URL of sensor " + sensors.config(index).name + " is too long or has too many placeholders");
+        return false;
     }
 
-    http.end();
-
-    return (httpCode == HTTP_CODE_OK);
+    // Request is sent by the forwarder task, so the sensor lock is not held during network I/O
+    return httpForwarder->enqueue(sensors.readings(index).serialNumber, forwardUrl);
 }
 
 // Update sensor configuration
@@ -513,43 +612,51 @@ bool SensorManager::updateSensorConfig(int index, const String &name, SensorType
 {
     std::lock_guard<std::mutex> lock(sensorMutex);
 
-    if (index < 0 || index >= sensorCount || !sensors[index].configured)
+    if (index < 0 || index >= (int)sensorCount || !sensors.readings(index).configured)
     {
         logger.warning("Attempt to update non-existent sensor at index " + String(index));
         return false;
     }
 
     // Check if serial number is already used by another sensor
-    int existingIndex = findSensorBySN(serialNumber);
+    int existingIndex = indexOfSerial(serialNumber);
     if (existingIndex >= 0 && existingIndex != index)
     {
         logger.warning("Cannot update sensor config: Serial number " +
                        String(serialNumber, HEX) + " already used by sensor " +
-                       sensors[existingIndex].name);
+                       sensors.config(existingIndex).name);
         return false;
     }
 
     // Update basic configuration
-    sensors[index].name = name;
-    sensors[index].deviceType = deviceType;
-    sensors[index].serialNumber = serialNumber;
-    sensors[index].deviceKey = deviceKey;
-    sensors[index].customUrl = customUrl;
-    sensors[index].altitude = altitude;
+    unindexSensor(index);
+    sensors.config(index).name = name;
+    SensorReadings &sensor = sensors.beginWrite(index);
+    sensor.deviceType = deviceType;
+    sensor.serialNumber = serialNumber;
+    sensor.deviceKey = deviceKey;
+    sensors.endWrite(index);
+    indexSensor(index);
+    sensors.config(index).customUrl = customUrl;
+    sensors.config(index).urlTemplate.compile(customUrl);
+    sensors.config(index).altitude = altitude;
 
     // Update correction values
-    sensors[index].temperatureCorrection = tempCorr;
-    sensors[index].humidityCorrection = humCorr;
-    sensors[index].pressureCorrection = pressCorr;
-    sensors[index].ppmCorrection = ppmCorr;
-    sensors[index].luxCorrection = luxCorr;
-    sensors[index].windSpeedCorrection = windSpeedCorr;
-    sensors[index].windDirectionCorrection = windDirCorr;
-    sensors[index].rainAmountCorrection = rainAmountCorr;
-    sensors[index].rainRateCorrection = rainRateCorr;
+    sensors.config(index).temperatureCorrection = tempCorr;
+    sensors.config(index).humidityCorrection = humCorr;
+    sensors.config(index).pressureCorrection = pressCorr;
+    sensors.config(index).ppmCorrection = ppmCorr;
+    sensors.config(index).luxCorrection = luxCorr;
+    sensors.config(index).windSpeedCorrection = windSpeedCorr;
+    sensors.config(index).windDirectionCorrection = windDirCorr;
+    sensors.config(index).rainAmountCorrection = rainAmountCorr;
+    sensors.config(index).rainRateCorrection = rainRateCorr;
+    sensors.config(index).prepareCorrections();
+    dataVersion++;
+    publishSnapshot();
 
     logger.info("Updated configuration for sensor: " + name + " (SN: " + String(serialNumber, HEX) + ")");
-    saveSensors(false);
+    markConfigDirty();
     return true;
 }
 
@@ -558,20 +665,24 @@ bool SensorManager::deleteSensor(int index)
 {
     std::lock_guard<std::mutex> lock(sensorMutex);
 
-    if (index < 0 || index >= sensorCount || !sensors[index].configured)
+    if (index < 0 || index >= (int)sensorCount || !sensors.readings(index).configured)
     {
         logger.warning("Attempt to delete non-existent sensor at index " + String(index));
         return false;
     }
 
-    String name = sensors[index].name;
-    uint32_t serialNumber = sensors[index].serialNumber;
+    String name = sensors.config(index).name;
+    uint32_t serialNumber = sensors.readings(index).serialNumber;
 
     // Mark as unconfigured instead of physically removing
-    sensors[index].configured = false;
+    unindexSensor(index);
+    sensors.beginWrite(index).configured = false;
+    sensors.endWrite(index);
+    dataVersion++;
+    publishSnapshot();
 
     logger.info("Deleted sensor: " + name + " (SN: " + String(serialNumber, HEX) + ")");
-    saveSensors(false);
+    markConfigDirty();
     return true;
 }
 
@@ -581,132 +692,433 @@ size_t SensorManager::getSensorCount() const
     return sensorCount;
 }
 
-// Get sensor by index (const version)
-const SensorData *SensorManager::getSensor(int index) const
+// Get sensor by index without locking
+SensorView SensorManager::getSensor(int index) const
 {
-    if (index < 0 || index >= sensorCount || !sensors[index].configured)
+    SensorSnapshotPtr published = std::atomic_load(&snapshot);
+    int position = published->positionOf(index);
+    SensorReadings readings;
+    if (position < 0 || !readSensor(*published, position, readings))
     {
-        return nullptr;
+        return SensorView();
     }
-    return &sensors[index];
+    return SensorView(readings, published->config(position), published);
 }
 
-// Get sensor by index (non-const version)
-SensorData *SensorManager::getSensor(int index)
+// Current readings of sensor at position in snapshot
+bool SensorManager::readSensor(const SensorSnapshot &published, int position, SensorReadings &readings) const
 {
-    if (index < 0 || index >= sensorCount || !sensors[index].configured)
-    {
-        return nullptr;
-    }
-    return &sensors[index];
+    // Slot may have been deleted or reused after the snapshot was published
+    return sensors.readReadings(published.indexAt(position), readings) && readings.configured &&
+           readings.serialNumber == published.readings[position].serialNumber;
 }
 
-// Get list of all sensors
-std::vector<SensorData> SensorManager::getAllSensors() const
+// Publish snapshot of current configuration
+void SensorManager::publishSnapshot()
 {
-    std::lock_guard<std::mutex> lock(sensorMutex);
+    std::shared_ptr<SensorSnapshotConfig> configuration = std::make_shared<SensorSnapshotConfig>();
+    configuration->generation = ++configGeneration;
+    configuration->positions.assign(sensorCount, -1);
 
-    std::vector<SensorData> result;
+    std::shared_ptr<SensorSnapshot> copy = std::make_shared<SensorSnapshot>(configuration);
+    copy->version = dataVersion.load();
     for (size_t i = 0; i < sensorCount; i++)
     {
-        result.push_back(sensors[i]);
+        if (sensors.readings(i).configured)
+        {
+            configuration->positions[i] = configuration->configs.size();
+            configuration->configs.push_back(sensors.config(i));
+            configuration->indices.push_back(i);
+            copy->readings.push_back(sensors.readings(i));
+        }
     }
-    return result;
+
+    // Readers still holding the previous snapshot keep it alive until they are done
+    std::atomic_store(&snapshot, SensorSnapshotPtr(copy));
 }
 
-// Get list of all active sensors (configured)
-std::vector<SensorData> SensorManager::getActiveSensors() const
+// Get shared copy of all configured sensors without locking
+SensorSnapshotPtr SensorManager::getSnapshot() const
 {
-    std::lock_guard<std::mutex> lock(sensorMutex);
+    SensorSnapshotPtr published = std::atomic_load(&snapshot);
+    uint32_t version = dataVersion.load();
+    if (published->version == version)
+    {
+        return published;
+    }
 
-    std::vector<SensorData> result;
-    for (size_t i = 0; i < sensorCount; i++)
+    // Readings changed since publication - configuration is shared with the
+    // published snapshot, only readings are taken again through the seqlocks
+    std::shared_ptr<SensorSnapshot> copy = std::make_shared<SensorSnapshot>(published->configuration);
+    copy->version = version;
+    copy->readings = published->readings;
+    for (size_t i = 0; i < copy->readings.size(); i++)
     {
-        if (sensors[i].configured)
+        SensorReadings readings;
+        if (readSensor(*published, i, readings))
         {
-            result.push_back(sensors[i]);
+            copy->readings[i] = readings;
         }
     }
-    return result;
+
+    // Share refreshed copy with other readers unless configuration was published meanwhile
+    SensorSnapshotPtr refreshed = copy;
+    std::atomic_compare_exchange_strong(&snapshot, &published, refreshed);
+    return refreshed;
+}
+
+// Version of sensor data
+uint32_t SensorManager::getDataVersion() const
+{
+    return dataVersion.load();
 }
 
 // Save sensor configuration to file
 bool SensorManager::saveSensors(bool lockMutex)
 {
-    if (lockMutex)
+    std::vector<uint8_t> buffer;
+    uint32_t version;
+    size_t count;
     {
-        std::lock_guard<std::mutex> lock(sensorMutex);
+        // Lock must cover serialization (a lock_guard inside the if released it right away)
+        std::unique_lock<std::mutex> lock(sensorMutex, std::defer_lock);
+        if (lockMutex)
+        {
+            lock.lock();
+        }
+        count = serializeSensors(buffer);
+        version = serializedVersion;
+        configDirty = false;
     }
 
-    // Open file for writing
-    File file = LittleFS.open(sensorsFile, "w");
-    if (!file)
+    return writeSensorsFile(buffer, version, count);
+}
+
+// Build binary registry of sensor configuration
+size_t SensorManager::serializeSensors(std::vector<uint8_t> &buffer)
+{
+    serializedVersion++;
+    return SensorRegistryFile::encode(sensors, sensorCount, buffer);
+}
+
+// Export sensor configuration as JSON
+String SensorManager::exportSensorsJson() const
+{
+    // Configuration is taken from the published snapshot, the sensor lock is not needed
+    // (serial numbers and keys are published with it, readings need no refresh)
+    SensorSnapshotPtr published = std::atomic_load(&snapshot);
+
+    // Names and URLs are copied into the document, keys are string literals
+    size_t capacity = JSON_OBJECT_SIZE(1) + JSON_ARRAY_SIZE(published->size());
+    for (const SensorConfig &config : published->configuration->configs)
     {
-        logger.info("Failed to open sensors file for writing: " + String(sensorsFile));
-        return false;
+        capacity += JSON_OBJECT_SIZE(15) + config.name.length() + config.customUrl.length() + 2;
     }
 
-    // Create JSON document
-    DynamicJsonDocument doc(4096); // Sufficiently large buffer
+    DynamicJsonDocument doc(capacity);
     JsonArray sensorArray = doc.createNestedArray("sensors");
 
-    // Add sensors to JSON
-    for (size_t i = 0; i < sensorCount; i++)
+    for (size_t i = 0; i < published->size(); i++)
+    {
+        const SensorReadings &sensor = published->readings[i];
+        const SensorConfig &config = published->config(i);
+        JsonObject sensorObj = sensorArray.createNestedObject();
+        sensorObj["deviceType"] = static_cast<uint8_t>(sensor.deviceType);
+        sensorObj["serialNumber"] = sensor.serialNumber;
+        sensorObj["deviceKey"] = sensor.deviceKey;
+        sensorObj["name"] = config.name;
+        sensorObj["customUrl"] = config.customUrl;
+        sensorObj["altitude"] = config.altitude;
+
+        sensorObj["temperatureCorrection"] = config.temperatureCorrection;
+        sensorObj["humidityCorrection"] = config.humidityCorrection;
+        sensorObj["pressureCorrection"] = config.pressureCorrection;
+        sensorObj["ppmCorrection"] = config.ppmCorrection;
+        sensorObj["luxCorrection"] = config.luxCorrection;
+        sensorObj["windSpeedCorrection"] = config.windSpeedCorrection;
+        sensorObj["windDirectionCorrection"] = config.windDirectionCorrection;
+        sensorObj["rainAmountCorrection"] = config.rainAmountCorrection;
+        sensorObj["rainRateCorrection"] = config.rainRateCorrection;
+    }
+
+    String json;
+    serializeJson(doc, json);
+    return json;
+}
+
+// Replace sensor configuration with sensors from JSON
+bool SensorManager::importSensorsJson(const String &json)
+{
+    // Input is not const char *, so every string is copied into the document
+    DynamicJsonDocument doc(json.length() * 2 + 1024);
+    DeserializationError error = deserializeJson(doc, json);
+    if (error)
+    {
+        logger.error("Failed to parse imported sensors: " + String(error.c_str()));
+        return false;
+    }
+
+    JsonArray sensorArray = doc["sensors"].as<JsonArray>();
+    if (sensorArray.isNull())
+    {
+        logger.error("Imported sensors contain no sensors array");
+        return false;
+    }
+
+    std::vector<uint8_t> buffer;
+    uint32_t version;
+    size_t count;
     {
-        if (sensors[i].configured)
+        std::lock_guard<std::mutex> lock(sensorMutex);
+
+        // Daily rain totals are runtime state - keep them for sensors that stay
+        std::vector<StateJournal::Record> rainState;
+        for (size_t i = 0; i < sensorCount; i++)
+        {
+            collectState(i, rainState);
+        }
+
+        clearSensors();
+        applySensorsJson(sensorArray);
+
+        for (const StateJournal::Record &record : rainState)
         {
-            JsonObject sensor = sensorArray.createNestedObject();
-            sensor["deviceType"] = static_cast<uint8_t>(sensors[i].deviceType);
-            sensor["serialNumber"] = sensors[i].serialNumber;
-            sensor["deviceKey"] = sensors[i].deviceKey;
-            sensor["name"] = sensors[i].name;
-            sensor["customUrl"] = sensors[i].customUrl;
-            sensor["altitude"] = sensors[i].altitude;
-
-            // Also save daily rain total and time of last reset
-            if (sensors[i].hasRainAmount())
+            int index = indexOfSerial(record.serialNumber);
+            if (index < 0)
             {
-                sensor["dailyRainTotal"] = sensors[i].dailyRainTotal;
-                sensor["lastRainReset"] = sensors[i].lastRainReset;
+                continue;
             }
 
-            sensor["temperatureCorrection"] = sensors[i].temperatureCorrection;
-            sensor["humidityCorrection"] = sensors[i].humidityCorrection;
-            sensor["pressureCorrection"] = sensors[i].pressureCorrection;
-            sensor["ppmCorrection"] = sensors[i].ppmCorrection;
-            sensor["luxCorrection"] = sensors[i].luxCorrection;
-            sensor["windSpeedCorrection"] = sensors[i].windSpeedCorrection;
-            sensor["windDirectionCorrection"] = sensors[i].windDirectionCorrection;
-            sensor["rainAmountCorrection"] = sensors[i].rainAmountCorrection;
-            sensor["rainRateCorrection"] = sensors[i].rainRateCorrection;
+            SensorReadings &sensor = sensors.beginWrite(index);
+            if (static_cast<StateJournal::Field>(record.field) == StateJournal::Field::DAILY_RAIN_TOTAL)
+            {
+                sensor.dailyRainTotalTenthMilli = FixedPoint::fromFloat(StateJournal::toFloat(record.value), 4);
+            }
+            else
+            {
+                sensor.lastRainReset = record.value;
+            }
+            sensors.endWrite(index);
         }
+        publishSnapshot();
+
+        // File is written after the lock is released, so the radio path is not blocked by flash
+        count = serializeSensors(buffer);
+        version = serializedVersion;
+        configDirty = false;
     }
-    logger.info("Serializing sensors to JSON");
-    // Serialize JSON to file
-    if (serializeJson(doc, file) == 0)
+
+    logger.info("Imported " + String(count) + " sensors");
+    return writeSensorsFile(buffer, version, count);
+}
+
+// Write snapshot to sensors file
+bool SensorManager::writeSensorsFile(const std::vector<uint8_t> &buffer, uint32_t version, size_t count)
+{
+    std::lock_guard<std::mutex> lock(fileMutex);
+
+    // A newer snapshot was written while this one waited for the file
+    if ((int32_t)(version - writtenVersion) <= 0)
+    {
+        return true;
+    }
+
+    // Written to a temporary file and renamed over the old one, so a reset
+    // during the write cannot leave a torn file that fails the CRC check
+    String tempFile = String(sensorsFile) + ".tmp";
+    File file = LittleFS.open(tempFile, "w");
+    if (!file)
     {
-        logger.info("Failed to write sensors to file");
-        file.close();
+        logger.error("Failed to open sensors file for writing: " + tempFile);
         return false;
     }
 
+    size_t written = file.write(buffer.data(), buffer.size());
     file.close();
-    logger.info("Saved " + String(sensorArray.size()) + " sensors to " + String(sensorsFile));
+
+    if (written != buffer.size())
+    {
+        logger.error("Failed to write sensors to file");
+        LittleFS.remove(tempFile);
+        return false;
+    }
+
+    if (!LittleFS.rename(tempFile, sensorsFile))
+    {
+        logger.error("Failed to replace sensors file: " + String(sensorsFile));
+        return false;
+    }
+
+    writtenVersion = version;
+    saveCount++;
+    bytesWritten += written;
+
+    logger.info("Saved " + String(count) + " sensors to " + String(sensorsFile));
     return true;
 }
 
-// Load sensor configuration from file
-bool SensorManager::loadSensors()
+// Mark sensor state for journaling by process()
+void SensorManager::markDirty(int index)
+{
+    stateDirty[index] = true;
+
+    unsigned long now = millis();
+    if (!dirty)
+    {
+        dirty = true;
+        firstDirtyTime = now;
+    }
+    lastDirtyTime = now;
+}
+
+// Mark configuration for saving by process()
+void SensorManager::markConfigDirty()
+{
+    configDirty = true;
+    configDirtyTime = millis();
+}
+
+// Write sensors file if configuration changed since it was written
+bool SensorManager::savePendingConfig()
+{
+    {
+        std::lock_guard<std::mutex> lock(sensorMutex);
+        if (!configDirty)
+        {
+            return true;
+        }
+    }
+
+    // Serialized again under the lock, a change made meanwhile is included
+    return saveSensors(true);
+}
+
+// Save pending configuration and journal pending runtime changes once their delay expired
+void SensorManager::process()
+{
+    bool saveConfig;
+    bool journalState;
+    {
+        std::lock_guard<std::mutex> lock(sensorMutex);
+        unsigned long now = millis();
+
+        // A burst of changes (bulk add, import of sensors seen on air) is written once
+        saveConfig = configDirty && now - configDirtyTime >= SENSOR_CONFIG_SAVE_DELAY;
+        journalState = dirty && (now - lastDirtyTime >= SENSOR_SAVE_DEBOUNCE ||
+                                 now - firstDirtyTime >= SENSOR_SAVE_MAX_DELAY);
+    }
+
+    if (saveConfig)
+    {
+        savePendingConfig();
+    }
+    if (journalState)
+    {
+        flush();
+    }
+}
+
+// Save pending configuration and journal pending runtime changes now
+bool SensorManager::flush()
+{
+    bool configSaved = savePendingConfig();
+
+    // Held across collecting and appending, so records reach the journal in order
+    std::lock_guard<std::mutex> journalLock(journalMutex);
+
+    std::vector<StateJournal::Record> records;
+
+    {
+        std::lock_guard<std::mutex> lock(sensorMutex);
+        if (!dirty)
+        {
+            return configSaved;
+        }
+
+        for (size_t i = 0; i < sensorCount; i++)
+        {
+            if (stateDirty[i])
+            {
+                collectState(i, records);
+                stateDirty[i] = false;
+            }
+        }
+        dirty = false;
+    }
+
+    // Journal is written without holding the sensor lock, so packets and API readers are not blocked
+    bool result = stateJournal.append(records.data(), records.size());
+
+    if (stateJournal.needsCompaction())
+    {
+        records.clear();
+        {
+            std::lock_guard<std::mutex> lock(sensorMutex);
+            for (size_t i = 0; i < sensorCount; i++)
+            {
+                collectState(i, records);
+            }
+        }
+        result = stateJournal.compact(records.data(), records.size()) && result;
+    }
+
+    return result && configSaved;
+}
+
+// Whether runtime changes are waiting to be saved
+bool SensorManager::hasUnsavedChanges() const
 {
     std::lock_guard<std::mutex> lock(sensorMutex);
+    return dirty || configDirty;
+}
 
-    // Reset sensor count
+// Average number of bytes written to flash per hour since boot
+uint32_t SensorManager::getBytesWrittenPerHour() const
+{
+    unsigned long uptime = millis();
+    if (uptime == 0)
+    {
+        return 0;
+    }
+    return (uint32_t)(getBytesWritten() * 3600000ULL / uptime);
+}
+
+// Remove all sensors (caller must hold sensorMutex)
+void SensorManager::clearSensors()
+{
     sensorCount = 0;
-    for (size_t i = 0; i < MAX_SENSORS; i++)
+    for (size_t i = 0; i < sensors.getCapacity(); i++)
+    {
+        sensors.clear(i);
+    }
+    keyTagIndex.clear();
+    serialIndex.clear();
+    dataVersion++;
+    dirty = false;
+    configDirty = false;
+    publishSnapshot();
+    stateDirty.assign(sensors.getCapacity(), false);
+}
+
+// Load sensor configuration from file
+bool SensorManager::loadSensors()
+{
+    if (!readSensorsFile())
     {
-        sensors[i].configured = false;
+        return false;
     }
 
+    // Journaled state is newer than the state the sensors file was written with
+    restoreState();
+    return true;
+}
+
+// Read sensors file into slots
+bool SensorManager::readSensorsFile()
+{
+    std::lock_guard<std::mutex> lock(sensorMutex);
+    clearSensors();
+
     // Check if file exists
     if (!LittleFS.exists(sensorsFile))
     {
@@ -714,6 +1126,8 @@ bool SensorManager::loadSensors()
         return true; // Not an error, we just start with an empty configuration
     }
 
+    int64_t start = esp_timer_get_time();
+
     // Open file for reading
     File file = LittleFS.open(sensorsFile, "r");
     if (!file)
@@ -722,8 +1136,60 @@ bool SensorManager::loadSensors()
         return false;
     }
 
-    // Create JSON document
-    DynamicJsonDocument doc(4096); // Sufficiently large buffer
+    // Whole registry is read at once and decoded in place
+    std::vector<uint8_t> buffer(file.size());
+    size_t bytes = file.read(buffer.data(), buffer.size());
+    file.close();
+
+    size_t count = 0;
+    String error;
+    bool valid = bytes == buffer.size() &&
+                 SensorRegistryFile::decode(buffer.data(), buffer.size(), sensors, count, error);
+    if (!valid)
+    {
+        logger.error("Invalid sensors file " + String(sensorsFile) + ": " + (error.length() > 0 ? error : String("read failed")));
+        clearSensors();
+        return false;
+    }
+    if (error.length() > 0)
+    {
+        logger.warning("Too many sensors in configuration file, ignoring some");
+    }
+
+    reserveSlots(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        sensors.config(i).urlTemplate.compile(sensors.config(i).customUrl);
+        sensors.beginWrite(i).configured = true;
+        sensors.endWrite(i);
+        indexSensor(i);
+    }
+    sensorCount = count;
+    publishSnapshot();
+
+    loadTime = (uint32_t)(esp_timer_get_time() - start);
+    logger.info("Loaded " + String(sensorCount) + " sensors from configuration in " + String(loadTime) + " us");
+    return true;
+}
+
+// Load sensor configuration from JSON file
+bool SensorManager::loadSensorsJson(const char *path)
+{
+    std::lock_guard<std::mutex> lock(sensorMutex);
+    clearSensors();
+
+    int64_t start = esp_timer_get_time();
+
+    // Open file for reading
+    File file = LittleFS.open(path, "r");
+    if (!file)
+    {
+        logger.error("Failed to open sensors file for reading: " + String(path));
+        return false;
+    }
+
+    // Strings are copied from the stream into the document
+    DynamicJsonDocument doc(file.size() * 2 + 1024);
 
     // Deserialize JSON from file
     DeserializationError error = deserializeJson(doc, file);
@@ -735,11 +1201,20 @@ bool SensorManager::loadSensors()
         return false;
     }
 
-    // Load sensors from JSON
-    JsonArray sensorArray = doc["sensors"].as<JsonArray>();
+    applySensorsJson(doc["sensors"].as<JsonArray>());
+    publishSnapshot();
+
+    loadTime = (uint32_t)(esp_timer_get_time() - start);
+    logger.info("Loaded " + String(sensorCount) + " sensors from " + String(path) + " in " + String(loadTime) + " us");
+    return true;
+}
+
+// Add sensors from JSON array
+size_t SensorManager::applySensorsJson(JsonArray sensorArray)
+{
     for (JsonObject sensorObj : sensorArray)
     {
-        if (sensorCount < MAX_SENSORS)
+        if (reserveSlots(sensorCount + 1))
         {
             uint8_t typeValue = sensorObj["deviceType"];
             SensorType deviceType = static_cast<SensorType>(typeValue);
@@ -749,95 +1224,99 @@ bool SensorManager::loadSensors()
             String customUrl = sensorObj["customUrl"].as<String>();
 
             // Create sensor
-            sensors[sensorCount].deviceType = deviceType;
-            sensors[sensorCount].serialNumber = serialNumber;
-            sensors[sensorCount].deviceKey = deviceKey;
-            sensors[sensorCount].name = name;
-            sensors[sensorCount].customUrl = customUrl;
-            sensors[sensorCount].lastSeen = 0;
-            sensors[sensorCount].temperature = 0.0f;
-            sensors[sensorCount].humidity = 0.0f;
-            sensors[sensorCount].pressure = 0.0f;
-            sensors[sensorCount].ppm = 0.0f;
-            sensors[sensorCount].lux = 0.0f;
-            sensors[sensorCount].batteryVoltage = 0.0f;
-            sensors[sensorCount].rssi = 0;
-            sensors[sensorCount].configured = true;
-
-            // Load daily rain total if it exists
+            SensorReadings &sensor = sensors.beginWrite(sensorCount);
+            sensor.deviceType = deviceType;
+            sensor.serialNumber = serialNumber;
+            sensor.deviceKey = deviceKey;
+            sensors.config(sensorCount).name = name;
+            sensors.config(sensorCount).customUrl = customUrl;
+            sensors.config(sensorCount).urlTemplate.compile(customUrl);
+            sensor.lastSeen = 0;
+            sensor.temperatureCenti = 0;
+            sensor.humidityCenti = 0;
+            sensor.pressureDeci = 0;
+            sensor.co2Ppm = 0;
+            sensor.luxCenti = 0;
+            sensor.batteryMillivolts = 0;
+            sensor.rssi = 0;
+            sensor.configured = true;
+
+            // Daily rain total was stored here before the state journal - still read for migration
             if (sensorObj.containsKey("dailyRainTotal"))
             {
-                sensors[sensorCount].dailyRainTotal = sensorObj["dailyRainTotal"].as<float>();
+                sensor.dailyRainTotalTenthMilli = FixedPoint::fromFloat(sensorObj["dailyRainTotal"].as<float>(), 4);
             }
             else
             {
-                sensors[sensorCount].dailyRainTotal = 0.0f;
+                sensor.dailyRainTotalTenthMilli = 0;
             }
 
             // Load time of last reset if it exists
             if (sensorObj.containsKey("lastRainReset"))
             {
-                sensors[sensorCount].lastRainReset = sensorObj["lastRainReset"].as<unsigned long>();
+                sensor.lastRainReset = sensorObj["lastRainReset"].as<unsigned long>();
             }
             else
             {
-                sensors[sensorCount].lastRainReset = 0;
+                sensor.lastRainReset = 0;
             }
+            sensors.endWrite(sensorCount);
 
             if (sensorObj.containsKey("altitude"))
             {
-                sensors[sensorCount].altitude = sensorObj["altitude"].as<int>();
+                sensors.config(sensorCount).altitude = sensorObj["altitude"].as<int>();
             }
             else
             {
-                sensors[sensorCount].altitude = 0;
+                sensors.config(sensorCount).altitude = 0;
             }
 
             if (sensorObj.containsKey("temperatureCorrection"))
             {
-                sensors[sensorCount].temperatureCorrection = sensorObj["temperatureCorrection"].as<float>();
+                sensors.config(sensorCount).temperatureCorrection = sensorObj["temperatureCorrection"].as<float>();
             }
             if (sensorObj.containsKey("humidityCorrection"))
             {
-                sensors[sensorCount].humidityCorrection = sensorObj["humidityCorrection"].as<float>();
+                sensors.config(sensorCount).humidityCorrection = sensorObj["humidityCorrection"].as<float>();
             }
             if (sensorObj.containsKey("pressureCorrection"))
             {
-                sensors[sensorCount].pressureCorrection = sensorObj["pressureCorrection"].as<float>();
+                sensors.config(sensorCount).pressureCorrection = sensorObj["pressureCorrection"].as<float>();
             }
             if (sensorObj.containsKey("ppmCorrection"))
             {
-                sensors[sensorCount].ppmCorrection = sensorObj["ppmCorrection"].as<float>();
+                sensors.config(sensorCount).ppmCorrection = sensorObj["ppmCorrection"].as<float>();
             }
             if (sensorObj.containsKey("luxCorrection"))
             {
-                sensors[sensorCount].luxCorrection = sensorObj["luxCorrection"].as<float>();
+                sensors.config(sensorCount).luxCorrection = sensorObj["luxCorrection"].as<float>();
             }
             if (sensorObj.containsKey("windSpeedCorrection"))
             {
-                sensors[sensorCount].windSpeedCorrection = sensorObj["windSpeedCorrection"].as<float>();
+                sensors.config(sensorCount).windSpeedCorrection = sensorObj["windSpeedCorrection"].as<float>();
             }
             if (sensorObj.containsKey("windDirectionCorrection"))
             {
-                sensors[sensorCount].windDirectionCorrection = sensorObj["windDirectionCorrection"].as<int>();
+                sensors.config(sensorCount).windDirectionCorrection = sensorObj["windDirectionCorrection"].as<int>();
             }
             if (sensorObj.containsKey("rainAmountCorrection"))
             {
-                sensors[sensorCount].rainAmountCorrection = sensorObj["rainAmountCorrection"].as<float>();
+                sensors.config(sensorCount).rainAmountCorrection = sensorObj["rainAmountCorrection"].as<float>();
             }
             if (sensorObj.containsKey("rainRateCorrection"))
             {
-                sensors[sensorCount].rainRateCorrection = sensorObj["rainRateCorrection"].as<float>();
+                sensors.config(sensorCount).rainRateCorrection = sensorObj["rainRateCorrection"].as<float>();
             }
+            sensors.config(sensorCount).prepareCorrections();
+            indexSensor(sensorCount);
             sensorCount++;
         }
         else
         {
-            logger.warning("Too many sensors in configuration file, ignoring some");
+            logger.warning("Too many sensors in configuration file or out of memory, ignoring some");
             break;
         }
     }
 
-    logger.info("Loaded " + String(sensorCount) + " sensors from configuration");
-    return true;
+    return sensorCount;
 }
\ No newline at end of file
@@ -23,26 +23,130 @@
 
 #include <Arduino.h>
 #include <mutex>
+#include <atomic>
 #include <vector>
+#include <unordered_map>
+#include <ArduinoJson.h>
 #include "SensorData.h"
+#include "SensorStore.h"
 #include "Logging.h"
+#include "../Storage/StateJournal.h"
+
+class HttpForwarder;
 
 /**
  * Class for managing a collection of sensors
  *
  * Handles adding, modifying, and deleting sensors, searching for them,
- * and managing their data. Stores sensor configuration in the file system.
+ * and managing their data. Stores sensor configuration in a binary registry
+ * file (JSON is used only for import and export);
+ * fast-changing state (daily rain totals) goes to the state journal, so the
+ * configuration file is only rewritten when configuration changes.
+ *
+ * Writers are serialized by sensorMutex. Readers (web server, MQTT) never
+ * take it: readings are copied through per-slot seqlocks in SensorStore and
+ * configuration is read from the published SensorSnapshot, so they can
+ * neither block the radio path nor see a half-written sensor.
  */
 class SensorManager
 {
 private:
-    SensorData sensors[MAX_SENSORS]; // Array of sensors - limited to MAX_SENSORS
-    size_t sensorCount;              // Current number of sensors
+    SensorStore sensors;             // Sensor slots, grown on demand up to MAX_SENSORS
+    size_t sensorCount;              // Number of used slots (including deleted sensors)
     mutable std::mutex sensorMutex;  // Mutex for safe multi-threaded access
     Logger &logger;                  // Reference to logger
+    HttpForwarder *httpForwarder;    // Queue for custom URL forwarding (optional)
+
+    // Expanded custom URL of sensor being forwarded (used under sensorMutex)
+    char forwardUrl[HTTP_FORWARD_URL_SIZE];
+
+    // Index of sensors by key tag (serial number folded with key bytes)
+    std::unordered_multimap<uint32_t, int> keyTagIndex;
+
+    // Index of configured sensors by serial number
+    std::unordered_map<uint32_t, int> serialIndex;
+
+    // Incremented whenever configuration is published (sensor added, changed, deleted or loaded)
+    std::atomic<uint32_t> configGeneration;
+
+    // Incremented on every change of sensor data (changed under sensorMutex)
+    std::atomic<uint32_t> dataVersion;
+
+    // Published snapshot of configured sensors - only accessed through
+    // std::atomic_load/std::atomic_store, replaced under sensorMutex when
+    // configuration changes and by getSnapshot() when readings changed
+    mutable SensorSnapshotPtr snapshot;
 
     // Filename for storing sensor configuration
     const char *sensorsFile;
+    uint32_t loadTime; // Duration of last configuration load (us)
+
+    // Write-behind journaling of runtime state (guarded by sensorMutex)
+    bool dirty;                      // Some sensor state changed since last flush
+    std::vector<bool> stateDirty;    // Per slot state changed since last flush
+    unsigned long firstDirtyTime;    // millis() of first unsaved change
+    unsigned long lastDirtyTime;     // millis() of last unsaved change
+    uint32_t serializedVersion;      // Incremented for every serialized snapshot
+    bool configDirty;                // Configuration changed since sensors file was written
+    unsigned long configDirtyTime;   // millis() of last unsaved configuration change
+
+    // Journal of runtime state - lock before sensorMutex when both are needed
+    StateJournal stateJournal;
+    std::mutex journalMutex;
+
+    // Sensors file writes - newer snapshot always wins
+    std::mutex fileMutex;
+    uint32_t writtenVersion; // Snapshot version last written (guarded by fileMutex)
+
+    // Write statistics
+    std::atomic<uint32_t> saveCount;
+    std::atomic<uint64_t> bytesWritten;
+
+    // Mark sensor state for journaling by process() (caller must hold sensorMutex)
+    void markDirty(int index);
+
+    // Mark configuration for saving by process() (caller must hold sensorMutex)
+    void markConfigDirty();
+
+    // Write sensors file if configuration changed since it was written
+    bool savePendingConfig();
+
+    // Add journal records with state of sensor (caller must hold sensorMutex)
+    void collectState(int index, std::vector<StateJournal::Record> &records);
+
+    // Restore sensor state from journal (called after loading configuration)
+    void restoreState();
+
+    // Read sensors file into slots, without journaled state
+    bool readSensorsFile();
+
+    // Build binary registry of sensor configuration, returns number of sensors (caller must hold sensorMutex)
+    size_t serializeSensors(std::vector<uint8_t> &buffer);
+
+    // Write snapshot to sensors file unless a newer one was written already
+    bool writeSensorsFile(const std::vector<uint8_t> &buffer, uint32_t version, size_t count);
+
+    // Remove all sensors (caller must hold sensorMutex)
+    void clearSensors();
+
+    // Add sensors from JSON array, returns number of sensors (caller must hold sensorMutex)
+    size_t applySensorsJson(JsonArray sensorArray);
+
+    // Add/remove sensor to/from key tag and serial number indexes (caller must hold sensorMutex)
+    void indexSensor(int index);
+    void unindexSensor(int index);
+
+    // Find configured sensor by serial number (caller must hold sensorMutex)
+    int indexOfSerial(uint32_t serialNumber) const;
+
+    // Allocate slots 0..count-1 (caller must hold sensorMutex)
+    bool reserveSlots(size_t count);
+
+    // Publish snapshot of current configuration (caller must hold sensorMutex)
+    void publishSnapshot();
+
+    // Current readings of sensor at position in snapshot, false if its slot was reused meanwhile
+    bool readSensor(const SensorSnapshot &published, int position, SensorReadings &readings) const;
 
 public:
     // Constructor
@@ -54,51 +158,106 @@ public:
     // Sensor manager initialization
     bool init();
 
-    // Add a new sensor
+    // Add a new sensor (configuration is saved by process(), or call saveSensors())
     int addSensor(SensorType deviceType, uint32_t serialNumber, uint32_t deviceKey, const String &name);
 
     // Find sensor by serial number
-    int findSensorBySN(uint32_t serialNumber);
+    int findSensorBySN(uint32_t serialNumber) const;
+
+    // Compute key tag of sensor - the serial number XORed with the key bytes
+    // that encrypt it, see LoRaProtocol::computePacketKeyTag()
+    static uint32_t computeKeyTag(uint32_t serialNumber, uint32_t deviceKey);
+
+    // Find candidate sensors for a packet key tag, returns number of candidates
+    size_t findSensorsByKeyTag(uint32_t keyTag, int *indices, uint32_t *keys, size_t maxCount) const;
+
+    // Get generation of sensor configuration (changes on add/update/delete/load)
+    uint32_t getConfigGeneration() const { return configGeneration.load(); }
 
     // Update sensor data
     bool updateSensor(int index, const SensorData &data);
 
-    // Update sensor data by type (overloaded method for easier use)
-    bool updateSensorData(int index, float temperature, float humidity, float pressure,
-                          float ppm, float lux, float batteryVoltage, int rssi,
-                          float windSpeed = 0.0f, uint16_t windDirection = 0,
-                          float rainAmount = 0.0f, float rainRate = 0.0f);
+    // Update sensor data by type with fixed point values as sent by sensors (see SensorReadings)
+    bool updateSensorData(int index, int16_t temperatureCenti, uint16_t humidityCenti, uint16_t pressureDeci,
+                          uint16_t co2Ppm, uint32_t luxCenti, uint16_t batteryMillivolts, int rssi,
+                          uint32_t windSpeedCenti = 0, uint16_t windDirection = 0,
+                          uint32_t rainAmountTenthMilli = 0, uint32_t rainRateMilli = 0);
 
-    // Update sensor configuration
+    // Update sensor configuration (saved by process(), or call saveSensors())
     bool updateSensorConfig(int index, const String &name, SensorType deviceType,
                             uint32_t serialNumber, uint32_t deviceKey,
                             const String &customUrl, int altitude,
                             float tempCorr, float humCorr, float pressCorr, float ppmCorr, float luxCorr,
                             float windSpeedCorr, int windDirCorr, float rainAmountCorr, float rainRateCorr);
 
-    // Delete sensor
+    // Delete sensor (saved by process(), or call saveSensors())
     bool deleteSensor(int index);
 
     // Get number of sensors
     size_t getSensorCount() const;
 
-    // Get sensor by index
-    const SensorData *getSensor(int index) const;
-    SensorData *getSensor(int index);
+    // Get sensor by index without locking (view evaluates to false if there is no configured sensor)
+    SensorView getSensor(int index) const;
 
-    // Get list of all sensors
-    std::vector<SensorData> getAllSensors() const;
+    // Call visitor(index, view) for each configured sensor without locking -
+    // configuration comes from the published snapshot, readings are current
+    template <typename Visitor>
+    void forEachSensor(Visitor visitor) const
+    {
+        SensorSnapshotPtr published = std::atomic_load(&snapshot);
+        SensorReadings readings;
+        for (size_t i = 0; i < published->size(); i++)
+        {
+            if (readSensor(*published, i, readings))
+            {
+                visitor(published->indexAt(i), SensorView(readings, published->config(i)));
+            }
+        }
+    }
 
-    // Get list of all active sensors (configured)
-    std::vector<SensorData> getActiveSensors() const;
+    // Get shared copy of all configured sensors without locking (readings refreshed only after they changed)
+    SensorSnapshotPtr getSnapshot() const;
+
+    // Version of sensor data, changes with every update
+    uint32_t getDataVersion() const;
 
     // Save sensor configuration to file
     bool saveSensors(bool lockMutex);
 
-    // Load sensor configuration from file
+    // Load sensor configuration from file and replay journaled state
     bool loadSensors();
 
-    // Forward sensor data to HTTP
+    // Load sensor configuration from JSON file (format used before the binary registry)
+    bool loadSensorsJson(const char *path);
+
+    // Export/import sensor configuration as JSON (import replaces all sensors and saves them)
+    String exportSensorsJson() const;
+    bool importSensorsJson(const String &json);
+
+    // Duration of last configuration load (us)
+    uint32_t getLoadTime() const { return loadTime; }
+
+    // Allocated sensor slots and their memory
+    size_t getCapacity() const { return sensors.getCapacity(); }
+    size_t getMemoryUsage() const { return sensors.getMemoryUsage(); }
+
+    // Save pending configuration and journal pending runtime changes once their delay expired (call in main loop)
+    void process();
+
+    // Save pending configuration and journal pending runtime changes now (before reboot or OTA)
+    bool flush();
+
+    // Persistence statistics
+    bool hasUnsavedChanges() const;
+    uint32_t getSaveCount() const { return saveCount.load(); }
+    uint64_t getBytesWritten() const { return bytesWritten.load() + stateJournal.getBytesWritten(); }
+    const StateJournal &getStateJournal() const { return stateJournal; }
+    uint32_t getBytesWrittenPerHour() const;
+
+    // Set queue used for forwarding to custom URLs
+    void setHttpForwarder(HttpForwarder *forwarder) { httpForwarder = forwarder; }
+
+    // Queue sensor data for forwarding to its custom URL (caller must hold sensorMutex)
     bool forwardSensorData(int index);
 
     // Convert relative pressure to absolute pressure
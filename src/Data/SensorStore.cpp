@@ -0,0 +1,147 @@
+/**
+ * expLORA Gateway Lite
+ *
+ * Sensor storage implementation file
+ *
+ * Copyright Pajenicko s.r.o., Igor Sverma (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "SensorStore.h"
+#include <new>
+#include "../Hardware/PSRAM_Manager.h"
+
+// Constructor
+SensorStore::SensorStore() : chunkCount(0)
+{
+    memset(readingChunks, 0, sizeof(readingChunks));
+    memset(configChunks, 0, sizeof(configChunks));
+    memset(sequenceChunks, 0, sizeof(sequenceChunks));
+}
+
+// Destructor
+SensorStore::~SensorStore()
+{
+    for (size_t i = 0; i < chunkCount; i++)
+    {
+        for (size_t j = 0; j < CHUNK_SIZE; j++)
+        {
+            readingChunks[i][j].~SensorReadings();
+            configChunks[i][j].~SensorConfig();
+        }
+        PSRAMManager::freeMemory(readingChunks[i]);
+        PSRAMManager::freeMemory(configChunks[i]);
+        PSRAMManager::freeMemory(sequenceChunks[i]);
+    }
+}
+
+// Make sure slots 0..count-1 exist
+bool SensorStore::reserve(size_t count)
+{
+    if (count > MAX_SENSORS)
+    {
+        return false;
+    }
+
+    while (getCapacity() < count)
+    {
+        void *readingMemory = PSRAMManager::allocateMemory(CHUNK_SIZE * sizeof(SensorReadings));
+        void *configMemory = PSRAMManager::allocateMemory(CHUNK_SIZE * sizeof(SensorConfig));
+        void *sequenceMemory = PSRAMManager::allocateMemory(CHUNK_SIZE * sizeof(std::atomic<uint32_t>));
+        if (readingMemory == nullptr || configMemory == nullptr || sequenceMemory == nullptr)
+        {
+            PSRAMManager::freeMemory(readingMemory);
+            PSRAMManager::freeMemory(configMemory);
+            PSRAMManager::freeMemory(sequenceMemory);
+            return false;
+        }
+
+        // Configuration holds Strings, so slots must be constructed in place
+        SensorReadings *readingChunk = static_cast<SensorReadings *>(readingMemory);
+        SensorConfig *configChunk = static_cast<SensorConfig *>(configMemory);
+        std::atomic<uint32_t> *sequenceChunk = static_cast<std::atomic<uint32_t> *>(sequenceMemory);
+        for (size_t j = 0; j < CHUNK_SIZE; j++)
+        {
+            new (&readingChunk[j]) SensorReadings();
+            new (&configChunk[j]) SensorConfig();
+            new (&sequenceChunk[j]) std::atomic<uint32_t>(0);
+        }
+
+        // Chunk pointers are set before readers can see the new capacity
+        size_t chunk = chunkCount.load(std::memory_order_relaxed);
+        readingChunks[chunk] = readingChunk;
+        configChunks[chunk] = configChunk;
+        sequenceChunks[chunk] = sequenceChunk;
+        chunkCount.store(chunk + 1, std::memory_order_release);
+    }
+
+    return true;
+}
+
+// Start changing readings of slot
+SensorReadings &SensorStore::beginWrite(size_t index)
+{
+    std::atomic<uint32_t> &counter = sequence(index);
+    counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+    // Odd counter must be visible before any of the new values
+    std::atomic_thread_fence(std::memory_order_release);
+    return readings(index);
+}
+
+// Finish changing readings of slot
+void SensorStore::endWrite(size_t index)
+{
+    std::atomic<uint32_t> &counter = sequence(index);
+    counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+// Consistent copy of slot readings without locking
+bool SensorStore::readReadings(size_t index, SensorReadings &out) const
+{
+    if (index >= getCapacity())
+    {
+        return false;
+    }
+
+    const std::atomic<uint32_t> &counter = sequence(index);
+    for (unsigned attempt = 0;; attempt++)
+    {
+        uint32_t before = counter.load(std::memory_order_acquire);
+        if ((before & 1) == 0)
+        {
+            memcpy(&out, &readings(index), sizeof(SensorReadings));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (counter.load(std::memory_order_relaxed) == before)
+            {
+                return true;
+            }
+        }
+
+        // Writer may be a preempted lower priority task on this core - let it finish
+        if (attempt >= SENSOR_STORE_READ_SPINS)
+        {
+            delay(1);
+        }
+    }
+}
+
+// Reset slot to an unconfigured sensor
+void SensorStore::clear(size_t index)
+{
+    beginWrite(index) = SensorReadings();
+    endWrite(index);
+    config(index) = SensorConfig();
+}
@@ -0,0 +1,96 @@
+/**
+ * expLORA Gateway Lite
+ *
+ * Sensor storage header file
+ *
+ * Copyright Pajenicko s.r.o., Igor Sverma (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+#include "SensorData.h"
+#include "../config.h"
+
+/**
+ * Growable storage of sensor slots
+ *
+ * Slots are allocated in chunks of SENSOR_STORE_CHUNK_SIZE through
+ * PSRAMManager (PSRAM when available), so memory grows with the number of
+ * sensors up to MAX_SENSORS. Chunks are never moved or freed while the store
+ * exists, so a slot index - the sensor handle used throughout the gateway -
+ * and references to slots stay valid as the store grows.
+ *
+ * Readings and configuration are kept in separate chunks (structure of
+ * arrays): the radio path and sensor scans touch only the packed readings,
+ * the Strings of the configuration are read only when they are needed.
+ *
+ * Each slot has a sequence counter (seqlock): writers, which must be
+ * serialized by the caller, bracket changes of readings with
+ * beginWrite()/endWrite(), and readers on other tasks take a consistent copy
+ * with readReadings() without locking. Configuration is not covered, it is
+ * published to readers through SensorSnapshot.
+ */
+class SensorStore
+{
+public:
+    static const size_t CHUNK_SIZE = SENSOR_STORE_CHUNK_SIZE;
+    static const size_t MAX_CHUNKS = (MAX_SENSORS + CHUNK_SIZE - 1) / CHUNK_SIZE;
+
+private:
+    SensorReadings *readingChunks[MAX_CHUNKS];
+    SensorConfig *configChunks[MAX_CHUNKS];
+    std::atomic<uint32_t> *sequenceChunks[MAX_CHUNKS]; // Odd while readings of the slot are written
+    std::atomic<size_t> chunkCount;
+
+    std::atomic<uint32_t> &sequence(size_t index) const { return sequenceChunks[index / CHUNK_SIZE][index % CHUNK_SIZE]; }
+
+public:
+    SensorStore();
+    ~SensorStore();
+
+    SensorStore(const SensorStore &) = delete;
+    SensorStore &operator=(const SensorStore &) = delete;
+
+    // Make sure slots 0..count-1 exist, false if count exceeds MAX_SENSORS or memory is exhausted
+    bool reserve(size_t count);
+
+    // Number of allocated slots
+    size_t getCapacity() const { return chunkCount.load(std::memory_order_acquire) * CHUNK_SIZE; }
+
+    // Bytes allocated for slots (without heap memory owned by Strings)
+    size_t getMemoryUsage() const
+    {
+        return getCapacity() * (sizeof(SensorReadings) + sizeof(SensorConfig) + sizeof(std::atomic<uint32_t>));
+    }
+
+    // Access slot (index must be below getCapacity(), readings may only be changed between beginWrite() and endWrite())
+    SensorReadings &readings(size_t index) { return readingChunks[index / CHUNK_SIZE][index % CHUNK_SIZE]; }
+    const SensorReadings &readings(size_t index) const { return readingChunks[index / CHUNK_SIZE][index % CHUNK_SIZE]; }
+    SensorConfig &config(size_t index) { return configChunks[index / CHUNK_SIZE][index % CHUNK_SIZE]; }
+    const SensorConfig &config(size_t index) const { return configChunks[index / CHUNK_SIZE][index % CHUNK_SIZE]; }
+
+    // Writer: start/finish changing readings of slot (readers retry meanwhile)
+    SensorReadings &beginWrite(size_t index);
+    void endWrite(size_t index);
+
+    // Reader: consistent copy of slot readings without locking, false if slot is not allocated
+    bool readReadings(size_t index, SensorReadings &out) const;
+
+    // Reset slot to an unconfigured sensor (writer)
+    void clear(size_t index);
+};
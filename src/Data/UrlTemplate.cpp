@@ -0,0 +1,279 @@
+/**
+ * expLORA Gateway Lite
+ *
+ * Custom URL template implementation file
+ *
+ * Copyright Pajenicko s.r.o., Igor Sverma (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "UrlTemplate.h"
+#include "SensorData.h"
+#include "FixedPoint.h"
+
+// Placeholder names recognized in custom URLs
+static const struct
+{
+    const char *name;
+    UrlTemplate::Field field;
+} URL_PLACEHOLDERS[] = {
+    {"TEMP", UrlTemplate::Field::TEMPERATURE},
+    {"HUM", UrlTemplate::Field::HUMIDITY},
+    {"PRESS", UrlTemplate::Field::PRESSURE},
+    {"PPM", UrlTemplate::Field::PPM},
+    {"LUX", UrlTemplate::Field::LUX},
+    {"WIND_SPEED", UrlTemplate::Field::WIND_SPEED},
+    {"WIND_DIR", UrlTemplate::Field::WIND_DIRECTION},
+    {"RAIN", UrlTemplate::Field::RAIN},
+    {"DAILY_RAIN", UrlTemplate::Field::DAILY_RAIN},
+    {"RAIN_RATE", UrlTemplate::Field::RAIN_RATE},
+    {"BAT", UrlTemplate::Field::BATTERY},
+    {"RSSI", UrlTemplate::Field::RSSI},
+    {"SN", UrlTemplate::Field::SERIAL_NUMBER},
+    {"TYPE", UrlTemplate::Field::TYPE},
+};
+
+// Field of placeholder name
+UrlTemplate::Field UrlTemplate::fieldOf(const char *name, size_t length)
+{
+    for (const auto &placeholder : URL_PLACEHOLDERS)
+    {
+        if (strlen(placeholder.name) == length && memcmp(placeholder.name, name, length) == 0)
+        {
+            return placeholder.field;
+        }
+    }
+    return Field::LITERAL;
+}
+
+// Append token
+bool UrlTemplate::addToken(Field field, size_t offset, size_t length)
+{
+    if (length == 0)
+    {
+        return true;
+    }
+
+    // Adjacent literals are merged
+    if (field == Field::LITERAL && tokenCount > 0 && tokens[tokenCount - 1].field == Field::LITERAL &&
+        tokens[tokenCount - 1].offset + tokens[tokenCount - 1].length == offset)
+    {
+        tokens[tokenCount - 1].length += length;
+        return true;
+    }
+
+    if (tokenCount >= URL_TEMPLATE_MAX_TOKENS)
+    {
+        return false;
+    }
+
+    tokens[tokenCount].field = field;
+    tokens[tokenCount].offset = offset;
+    tokens[tokenCount].length = length;
+    tokenCount++;
+    return true;
+}
+
+// Parse URL into tokens
+bool UrlTemplate::compile(const String &url)
+{
+    text = url;
+    tokenCount = 0;
+    valid = false;
+
+    const char *source = text.c_str();
+    size_t length = text.length();
+    if (length > UINT16_MAX)
+    {
+        return false;
+    }
+
+    size_t literalStart = 0;
+    size_t pos = 0;
+
+    while (pos < length)
+    {
+        const char *open = (const char *)memchr(source + pos, '*', length - pos);
+        if (open == nullptr)
+        {
+            break;
+        }
+
+        size_t start = open - source;
+        const char *close = (const char *)memchr(open + 1, '*', length - start - 1);
+        if (close == nullptr)
+        {
+            break;
+        }
+
+        size_t end = close - source;
+        Field field = fieldOf(open + 1, end - start - 1);
+
+        if (field == Field::LITERAL)
+        {
+            // Not a placeholder - closing asterisk may open the next one
+            pos = end;
+            continue;
+        }
+
+        if (!addToken(Field::LITERAL, literalStart, start - literalStart) ||
+            !addToken(field, start, end + 1 - start))
+        {
+            return false;
+        }
+
+        literalStart = end + 1;
+        pos = end + 1;
+    }
+
+    valid = addToken(Field::LITERAL, literalStart, length - literalStart);
+    return valid;
+}
+
+// Recompile only if URL differs from compiled one
+bool UrlTemplate::update(const String &url)
+{
+    if (valid && text == url)
+    {
+        return true;
+    }
+    return compile(url);
+}
+
+// Format fixed point value like snprintf(), a result that does not fit is reported as remaining
+static int formatFixed(char *out, size_t remaining, int32_t value, uint8_t scale, uint8_t decimals)
+{
+    size_t length = FixedPoint::format(out, remaining, value, scale, decimals);
+    return length > 0 ? (int)length : (int)remaining;
+}
+
+// Write URL with sensor values into buffer
+size_t UrlTemplate::expand(const SensorReadings &sensor, char *buffer, size_t size) const
+{
+    if (!valid || size == 0)
+    {
+        return 0;
+    }
+
+    const char *source = text.c_str();
+    size_t used = 0;
+
+    for (uint8_t i = 0; i < tokenCount; i++)
+    {
+        const Token &token = tokens[i];
+        char *out = buffer + used;
+        size_t remaining = size - used;
+        int written = -1;
+
+        switch (token.field)
+        {
+        case Field::TEMPERATURE:
+            if (sensor.hasTemperature())
+            {
+                written = formatFixed(out, remaining, sensor.temperatureCenti, 2, 2);
+            }
+            break;
+        case Field::HUMIDITY:
+            if (sensor.hasHumidity())
+            {
+                written = formatFixed(out, remaining, sensor.humidityCenti, 2, 2);
+            }
+            break;
+        case Field::PRESSURE:
+            if (sensor.hasPressure())
+            {
+                // Two decimals as custom URLs always had, although the reading has one
+                written = formatFixed(out, remaining, (int32_t)sensor.pressureDeci * 10, 2, 2);
+            }
+            break;
+        case Field::PPM:
+            if (sensor.hasPPM())
+            {
+                written = formatFixed(out, remaining, sensor.co2Ppm, 0, 0);
+            }
+            break;
+        case Field::LUX:
+            if (sensor.hasLux())
+            {
+                written = formatFixed(out, remaining, sensor.luxCenti, 2, 1);
+            }
+            break;
+        case Field::WIND_SPEED:
+            if (sensor.hasWindSpeed())
+            {
+                written = formatFixed(out, remaining, sensor.windSpeedCenti, 2, 1);
+            }
+            break;
+        case Field::WIND_DIRECTION:
+            if (sensor.hasWindDirection())
+            {
+                written = snprintf(out, remaining, "%u", (unsigned)sensor.windDirection);
+            }
+            break;
+        case Field::RAIN:
+            if (sensor.hasRainAmount())
+            {
+                written = formatFixed(out, remaining, sensor.rainAmountTenthMilli, 4, 1);
+            }
+            break;
+        case Field::DAILY_RAIN:
+            if (sensor.hasRainAmount())
+            {
+                written = formatFixed(out, remaining, sensor.dailyRainTotalTenthMilli, 4, 1);
+            }
+            break;
+        case Field::RAIN_RATE:
+            if (sensor.hasRainRate())
+            {
+                written = formatFixed(out, remaining, sensor.rainRateMilli, 3, 1);
+            }
+            break;
+        case Field::BATTERY:
+            written = formatFixed(out, remaining, sensor.batteryMillivolts, 3, 2);
+            break;
+        case Field::RSSI:
+            written = snprintf(out, remaining, "%d", sensor.rssi);
+            break;
+        case Field::SERIAL_NUMBER:
+            written = snprintf(out, remaining, "%lx", (unsigned long)sensor.serialNumber);
+            break;
+        case Field::TYPE:
+            written = snprintf(out, remaining, "%u", (unsigned)static_cast<uint8_t>(sensor.deviceType));
+            break;
+        default:
+            break;
+        }
+
+        if (written < 0)
+        {
+            // Literal segment, or placeholder of a value this sensor type does not have
+            if (token.length >= remaining)
+            {
+                return 0;
+            }
+            memcpy(out, source + token.offset, token.length);
+            written = token.length;
+        }
+        else if ((size_t)written >= remaining)
+        {
+            return 0;
+        }
+
+        used += written;
+    }
+
+    buffer[used] = '\0';
+    return used;
+}
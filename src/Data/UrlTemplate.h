@@ -0,0 +1,98 @@
+/**
+ * expLORA Gateway Lite
+ *
+ * Custom URL template header file
+ *
+ * Copyright Pajenicko s.r.o., Igor Sverma (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include "../config.h"
+
+struct SensorReadings;
+
+/**
+ * Precompiled custom URL with placeholders
+ *
+ * The URL is split once (when sensor configuration changes) into literal
+ * segments and field references such as *TEMP* or *SN*. Expanding it for
+ * a packet is a single pass into a caller-provided buffer without heap
+ * allocation. Placeholders of values the sensor type does not provide
+ * are kept in the URL as written.
+ */
+class UrlTemplate
+{
+public:
+    // Field referenced by a placeholder
+    enum class Field : uint8_t
+    {
+        LITERAL,
+        TEMPERATURE,
+        HUMIDITY,
+        PRESSURE,
+        PPM,
+        LUX,
+        WIND_SPEED,
+        WIND_DIRECTION,
+        RAIN,
+        DAILY_RAIN,
+        RAIN_RATE,
+        BATTERY,
+        RSSI,
+        SERIAL_NUMBER,
+        TYPE
+    };
+
+private:
+    // Literal segment of text, or placeholder (offset/length cover the *NAME* text)
+    struct Token
+    {
+        Field field;
+        uint16_t offset;
+        uint16_t length;
+    };
+
+    String text; // URL the template was compiled from
+    Token tokens[URL_TEMPLATE_MAX_TOKENS];
+    uint8_t tokenCount;
+    bool valid;
+
+    // Append token, false if template has too many tokens
+    bool addToken(Field field, size_t offset, size_t length);
+
+    // Field of placeholder name (without asterisks), LITERAL if unknown
+    static Field fieldOf(const char *name, size_t length);
+
+public:
+    UrlTemplate() : tokenCount(0), valid(true) {}
+
+    // Parse URL into tokens, false if it has too many segments
+    bool compile(const String &url);
+
+    // Recompile only if URL differs from compiled one
+    bool update(const String &url);
+
+    // Whether URL is empty
+    bool empty() const { return text.length() == 0; }
+
+    // Whether last compile succeeded
+    bool isValid() const { return valid; }
+
+    // Write URL with sensor values into buffer, returns length or 0 if it does not fit
+    size_t expand(const SensorReadings &sensor, char *buffer, size_t size) const;
+};
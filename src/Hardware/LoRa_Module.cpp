@@ -21,19 +21,36 @@
 
 #include "LoRa_Module.h"
 #include <Arduino.h>
+#include <esp_timer.h>
 
 // Initialization of static variables
 volatile bool LoRaModule::interruptOccurred = false;
+volatile int64_t LoRaModule::interruptTime = 0;
+portMUX_TYPE LoRaModule::interruptMux = portMUX_INITIALIZER_UNLOCKED;
+TaskHandle_t LoRaModule::receiveTaskHandle = NULL;
 
 // Interrupt handler
 void IRAM_ATTR LoRaModule::handleInterrupt()
 {
+    // 64-bit store is not atomic on the 32-bit core
+    portENTER_CRITICAL_ISR(&interruptMux);
+    interruptTime = esp_timer_get_time();
+    portEXIT_CRITICAL_ISR(&interruptMux);
     interruptOccurred = true;
+
+    // Wake receive task
+    if (receiveTaskHandle != NULL)
+    {
+        BaseType_t higherPriorityTaskWoken = pdFALSE;
+        vTaskNotifyGiveFromISR(receiveTaskHandle, &higherPriorityTaskWoken);
+        portYIELD_FROM_ISR(higherPriorityTaskWoken);
+    }
 }
 
 // Constructor
 LoRaModule::LoRaModule(Logger &log, SPIManager *spiMgr, int cs, int rst, int dio0)
-    : csPin(cs), rstPin(rst), dio0Pin(dio0), spiManager(spiMgr), logger(log)
+    : csPin(cs), rstPin(rst), dio0Pin(dio0), spiManager(spiMgr), logger(log),
+      frameConsumer(NULL), droppedFrames(0)
 {
 
     // If no SPIManager instance was provided, create a new one
@@ -232,106 +249,113 @@ bool LoRaModule::reset()
     return true;
 }
 
-// Write to register
-void LoRaModule::writeRegister(uint8_t reg, uint8_t value)
+// Read consecutive registers (CS cycle only, caller holds SPI transaction)
+void LoRaModule::selectRead(uint8_t reg, uint8_t *values, size_t count)
 {
     digitalWrite(csPin, LOW);
+    spiManager->transfer(reg & 0x7F); // 0x7F indicates read
+    spiManager->transferBytes(nullptr, values, count);
+    digitalWrite(csPin, HIGH);
+}
 
-    spiManager->beginTransaction(SPISettings(1000000, MSBFIRST, SPI_MODE0));
+// Write register (CS cycle only, caller holds SPI transaction)
+void LoRaModule::selectWrite(uint8_t reg, uint8_t value)
+{
+    digitalWrite(csPin, LOW);
     spiManager->transfer(reg | 0x80); // 0x80 indicates write
     spiManager->transfer(value);
-    spiManager->endTransaction();
-
     digitalWrite(csPin, HIGH);
 }
 
+// Write to register
+void LoRaModule::writeRegister(uint8_t reg, uint8_t value)
+{
+    spiManager->beginTransaction();
+    selectWrite(reg, value);
+    spiManager->endTransaction();
+}
+
 // Read from register
 uint8_t LoRaModule::readRegister(uint8_t reg)
 {
-    digitalWrite(csPin, LOW);
+    uint8_t value = 0;
+    readRegisters(reg, &value, 1);
+    return value;
+}
 
-    spiManager->beginTransaction(SPISettings(1000000, MSBFIRST, SPI_MODE0));
-    spiManager->transfer(reg & 0x7F); // 0x7F indicates read
-    uint8_t value = spiManager->transfer(0x00);
+// Read consecutive registers in one burst (address auto-increments)
+void LoRaModule::readRegisters(uint8_t reg, uint8_t *values, size_t count)
+{
+    spiManager->beginTransaction();
+    selectRead(reg, values, count);
     spiManager->endTransaction();
-
-    digitalWrite(csPin, HIGH);
-    return value;
 }
 
 // Receive packet
-bool LoRaModule::receivePacket(uint8_t *buffer, uint8_t *length)
+// Registers FIFO_RX_CURRENT_ADDR (0x10) to PKT_RSSI_VALUE (0x1A) are contiguous, so
+// IRQ flags, length, FIFO address, SNR and RSSI come in a single burst. Together with
+// FIFO pointer setup, payload read and IRQ clear this is one SPI transaction.
+bool LoRaModule::receivePacket(uint8_t *buffer, uint8_t *length, int16_t *rssi, float *snr)
 {
-    // Check if reception is complete
-    uint8_t irqFlags = readRegister(REG_IRQ_FLAGS);
+    uint8_t status[REG_PKT_RSSI_VALUE - REG_FIFO_RX_CURRENT_ADDR + 1];
+
+    spiManager->beginTransaction();
+    selectRead(REG_FIFO_RX_CURRENT_ADDR, status, sizeof(status));
+
+    uint8_t currentAddr = status[0];
+    uint8_t irqFlags = status[REG_IRQ_FLAGS - REG_FIFO_RX_CURRENT_ADDR];
+    uint8_t packetLength = status[REG_RX_NB_BYTES - REG_FIFO_RX_CURRENT_ADDR];
 
     // Check reception complete flag
     if (!(irqFlags & 0x40))
     {
+        spiManager->endTransaction();
         return false;
     }
 
-    // Read number of received bytes
-    uint8_t packetLength = readRegister(REG_RX_NB_BYTES);
-
     // Basic check of data length
-    if (packetLength == 0 || packetLength > 255)
+    if (packetLength == 0)
     {
-        logger.warning("Invalid packet length: " + String(packetLength));
         // Clear interrupt flags
-        writeRegister(REG_IRQ_FLAGS, 0xFF);
-        return false;
-    }
-
-    *length = packetLength;
+        selectWrite(REG_IRQ_FLAGS, 0xFF);
+        spiManager->endTransaction();
 
-    // Get current address in FIFO
-    uint8_t currentAddr = readRegister(REG_FIFO_RX_CURRENT_ADDR);
-
-    // Check that address makes sense
-    if (currentAddr > 255)
-    {
-        logger.warning("Invalid FIFO address: " + String(currentAddr));
-        // Clear interrupt flags
-        writeRegister(REG_IRQ_FLAGS, 0xFF);
+        LOGF_WARNING("Invalid packet length: %u", (unsigned)packetLength);
         return false;
     }
 
-    // Set FIFO address
-    writeRegister(REG_FIFO_ADDR_PTR, currentAddr);
+    // Set FIFO address and read data from FIFO
+    selectWrite(REG_FIFO_ADDR_PTR, currentAddr);
+    selectRead(REG_FIFO, buffer, packetLength);
 
-    // Read data from FIFO
-    digitalWrite(csPin, LOW);
+    // Clear interrupt flags
+    selectWrite(REG_IRQ_FLAGS, 0xFF);
+    spiManager->endTransaction();
 
-    spiManager->beginTransaction(SPISettings(1000000, MSBFIRST, SPI_MODE0));
-    spiManager->transfer(REG_FIFO & 0x7F); // 0x7F indicates read
+    *length = packetLength;
 
-    // Transfer data
-    for (int i = 0; i < packetLength; i++)
+    if (rssi != nullptr)
     {
-        buffer[i] = spiManager->transfer(0x00);
+        *rssi = convertRSSI(status[REG_PKT_RSSI_VALUE - REG_FIFO_RX_CURRENT_ADDR]);
+    }
+    if (snr != nullptr)
+    {
+        *snr = convertSNR(status[REG_PKT_SNR_VALUE - REG_FIFO_RX_CURRENT_ADDR]);
     }
-
-    spiManager->endTransaction();
-    digitalWrite(csPin, HIGH);
-
-    // Clear interrupt flags
-    writeRegister(REG_IRQ_FLAGS, 0xFF);
 
     return true;
 }
 
-// Get RSSI
-int LoRaModule::getRSSI()
+// Convert PKT_RSSI_VALUE register to dBm
+int16_t LoRaModule::convertRSSI(uint8_t raw)
 {
-    int16_t rssi = readRegister(REG_PKT_RSSI_VALUE) - 137;
-    return rssi;
+    return raw - 137;
 }
 
-// Get SNR of last packet
-float LoRaModule::getSNR()
+// Convert PKT_SNR_VALUE register to dB
+float LoRaModule::convertSNR(uint8_t raw)
 {
-    int8_t snr = readRegister(REG_PKT_SNR_VALUE);
+    int8_t snr = raw;
     if (snr & 0x80)
     {
         snr = ((~snr + 1) & 0xFF) >> 2;
@@ -344,6 +368,18 @@ float LoRaModule::getSNR()
     return snr * 0.25;
 }
 
+// Get RSSI
+int LoRaModule::getRSSI()
+{
+    return convertRSSI(readRegister(REG_PKT_RSSI_VALUE));
+}
+
+// Get SNR of last packet
+float LoRaModule::getSNR()
+{
+    return convertSNR(readRegister(REG_PKT_SNR_VALUE));
+}
+
 // Check if interrupt occurred
 bool LoRaModule::hasInterrupt()
 {
@@ -356,6 +392,94 @@ void LoRaModule::clearInterrupt()
     interruptOccurred = false;
 }
 
+// Start receive task
+bool LoRaModule::startReceiveTask()
+{
+    if (receiveTaskHandle != NULL)
+    {
+        return true;
+    }
+
+    BaseType_t result = xTaskCreatePinnedToCore(
+        receiveTask,           // Task function
+        "LoRaRxTask",          // Task name
+        LORA_RX_TASK_STACK,    // Stack size (bytes)
+        this,                  // Parameter to pass
+        LORA_RX_TASK_PRIORITY, // Task priority
+        &receiveTaskHandle,    // Task handle
+        LORA_TASK_CORE         // Core
+    );
+
+    if (result != pdPASS)
+    {
+        logger.error("Failed to create LoRa receive task");
+        receiveTaskHandle = NULL;
+        return false;
+    }
+
+    logger.info("LoRa receive task started on core " + String(LORA_TASK_CORE));
+    return true;
+}
+
+// Receive task - waits for DIO0 interrupt and drains FIFO
+void LoRaModule::receiveTask(void *parameter)
+{
+    LoRaModule *module = (LoRaModule *)parameter;
+
+    for (;;)
+    {
+        // Wait for interrupt, with timeout so that a missed edge does not stall reception
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(LORA_RX_POLL_INTERVAL));
+        module->drainFifo();
+    }
+}
+
+// Move received packet from radio FIFO to ring buffer
+void LoRaModule::drainFifo()
+{
+    // Time of this frame's DIO0 - taken before the FIFO is read, as reading it clears the
+    // IRQ flags and DIO0 of the next frame could overwrite interruptTime meanwhile
+    portENTER_CRITICAL(&interruptMux);
+    int64_t timestamp = interruptTime;
+    portEXIT_CRITICAL(&interruptMux);
+
+    clearInterrupt();
+
+    // If decoder is behind, still read the packet to release the radio, but drop it
+    LoRaFrame *frame = rxRing.acquireWrite();
+    bool overflow = (frame == nullptr);
+    if (overflow)
+    {
+        frame = &overflowFrame;
+    }
+
+    uint8_t length = 0;
+    int16_t rssi = 0;
+    float snr = 0.0f;
+    if (!receivePacket(frame->data, &length, &rssi, &snr))
+    {
+        return;
+    }
+
+    if (overflow)
+    {
+        droppedFrames++;
+        LOGF_WARNING("LoRa receive queue full, packet dropped (%lu total)", (unsigned long)droppedFrames);
+        return;
+    }
+
+    frame->length = length;
+    frame->timestamp = timestamp;
+    frame->rssi = rssi;
+    frame->snr = snr;
+    rxRing.commitWrite();
+
+    if (frameConsumer != NULL)
+    {
+        xTaskNotifyGive(frameConsumer);
+    }
+}
+
 // Check if module is connected
 bool LoRaModule::isConnected()
 {
@@ -25,6 +25,8 @@
 #include <SPI.h>
 #include "../config.h"
 #include "../Data/Logging.h"
+#include "../Data/SPSCRingBuffer.h"
+#include "RadioInterface.h"
 #include "SPI_Manager.h"
 #include "board_config.h"
 
@@ -34,7 +36,7 @@
  * Handles initialization, configuration, and communication with RFM95W LoRa module.
  * Abstracts SPI communication and interrupt handling.
  */
-class LoRaModule
+class LoRaModule : public RadioInterface
 {
 private:
     int csPin;              // Chip select pin
@@ -44,14 +46,35 @@ private:
 
     Logger &logger; // Reference to logger
 
-    static volatile bool interruptOccurred;  // Interrupt flag (static for use in ISR)
-    static void IRAM_ATTR handleInterrupt(); // Interrupt handler
+    static volatile bool interruptOccurred;    // Interrupt flag (static for use in ISR)
+    static volatile int64_t interruptTime;     // Time of last interrupt (us since boot)
+    static portMUX_TYPE interruptMux;          // Guards interruptTime between ISR and task
+    static TaskHandle_t receiveTaskHandle;     // Receive task woken by interrupt
+    static void IRAM_ATTR handleInterrupt();   // Interrupt handler
+
+    // Frames received but not yet decoded
+    SPSCRingBuffer<LoRaFrame, LORA_RX_RING_SIZE> rxRing;
+    LoRaFrame overflowFrame;      // Scratch frame used to drain FIFO when ring is full
+    TaskHandle_t frameConsumer;   // Task notified when a frame is queued
+    volatile uint32_t droppedFrames; // Frames lost because ring was full
+
+    // Receive task - drains radio FIFO into ring buffer
+    static void receiveTask(void *parameter);
+    void drainFifo();
 
     // Setup pins and SPI
     bool setupPins();
     // Reset module
     void resetModule();
 
+    // Register access within an already started SPI transaction
+    void selectRead(uint8_t reg, uint8_t *values, size_t count);
+    void selectWrite(uint8_t reg, uint8_t value);
+
+    // Convert raw packet status registers
+    static int16_t convertRSSI(uint8_t raw);
+    static float convertSNR(uint8_t raw);
+
 public:
     // Constructor
     LoRaModule(Logger &log, SPIManager *spiMgr = nullptr, int cs = LORA_CS, int rst = LORA_RST, int dio0 = LORA_DIO0);
@@ -60,7 +83,7 @@ public:
     ~LoRaModule();
 
     // Initialize LoRa module
-    bool init();
+    bool init() override;
 
     // Reset module
     bool reset();
@@ -71,8 +94,11 @@ public:
     // Read from register
     uint8_t readRegister(uint8_t reg);
 
-    // Receive packet
-    bool receivePacket(uint8_t *buffer, uint8_t *length);
+    // Read consecutive registers in one burst
+    void readRegisters(uint8_t reg, uint8_t *values, size_t count);
+
+    // Receive packet, optionally returning its RSSI and SNR
+    bool receivePacket(uint8_t *buffer, uint8_t *length, int16_t *rssi = nullptr, float *snr = nullptr);
 
     // Get RSSI
     int getRSSI();
@@ -87,7 +113,23 @@ public:
     static void clearInterrupt();
 
     // Check if module is connected
-    bool isConnected();
+    bool isConnected() override;
+
+    // Start high-priority task that moves received packets from radio to ring buffer
+    bool startReceiveTask() override;
+
+    // Set task notified whenever a new frame is queued
+    void setFrameConsumer(TaskHandle_t task) override { frameConsumer = task; }
+
+    // Access oldest queued frame (consumer side), nullptr if none
+    LoRaFrame *peekFrame() override { return rxRing.peekRead(); }
+
+    // Release frame returned by peekFrame()
+    void releaseFrame() override { rxRing.releaseRead(); }
+
+    // Receive queue statistics
+    size_t getQueuedFrames() const override { return rxRing.size(); }
+    uint32_t getDroppedFrames() const override { return droppedFrames; }
 
     // Get chip version
     uint8_t getVersion();
@@ -0,0 +1,71 @@
+/**
+ * expLORA Gateway Lite
+ *
+ * Radio abstraction header file
+ *
+ * Copyright Pajenicko s.r.o., Igor Sverma (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * Raw frame received by radio and waiting for decoding
+ */
+struct LoRaFrame
+{
+    int64_t timestamp; // Time of DIO0 interrupt (us since boot)
+    int16_t rssi;      // Packet RSSI (dBm)
+    float snr;         // Packet SNR (dB)
+    uint8_t length;    // Number of valid bytes in data
+    uint8_t data[255]; // Encrypted packet as received
+};
+
+/**
+ * Interface of packet radio used by LoRaProtocol
+ *
+ * The radio queues received frames; LoRaProtocol consumes them from its decode
+ * task. Implemented by LoRaModule (SX127x hardware) and SimulatedRadio
+ * (software radio for benchmarks and testing without the board).
+ */
+class RadioInterface
+{
+public:
+    virtual ~RadioInterface() {}
+
+    // Initialize radio
+    virtual bool init() = 0;
+
+    // Start producing frames (receive task for hardware radio)
+    virtual bool startReceiveTask() = 0;
+
+    // Set task notified whenever a new frame is queued
+    virtual void setFrameConsumer(TaskHandle_t task) = 0;
+
+    // Access oldest queued frame, nullptr if none
+    virtual LoRaFrame *peekFrame() = 0;
+
+    // Release frame returned by peekFrame()
+    virtual void releaseFrame() = 0;
+
+    // Receive queue statistics
+    virtual size_t getQueuedFrames() const = 0;
+    virtual uint32_t getDroppedFrames() const = 0;
+
+    // Check if radio is available
+    virtual bool isConnected() = 0;
+};
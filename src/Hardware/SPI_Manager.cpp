@@ -23,7 +23,8 @@
 
 // Constructor
 SPIManager::SPIManager(Logger &log, int sck, int miso, int mosi)
-    : spi(nullptr), logger(log), sckPin(sck), misoPin(miso), mosiPin(mosi), initialized(false)
+    : spi(nullptr), logger(log), sckPin(sck), misoPin(miso), mosiPin(mosi), initialized(false),
+      clockFrequency(LORA_SPI_FREQUENCY)
 {
 }
 
@@ -85,6 +86,12 @@ SPIClass *SPIManager::getSPI()
     return spi;
 }
 
+// Begin transaction with configured clock
+void SPIManager::beginTransaction()
+{
+    beginTransaction(SPISettings(clockFrequency, MSBFIRST, SPI_MODE0));
+}
+
 // Begin transaction
 void SPIManager::beginTransaction(SPISettings settings)
 {
@@ -124,10 +131,31 @@ void SPIManager::transfer(uint8_t *data, size_t length)
         init();
     }
 
-    for (size_t i = 0; i < length; i++)
+    spi->transfer(data, length);
+}
+
+// Bulk transfer
+void SPIManager::transferBytes(const uint8_t *out, uint8_t *in, size_t length)
+{
+    if (!initialized)
     {
-        data[i] = spi->transfer(data[i]);
+        init();
     }
+
+    spi->transferBytes(out, in, length);
+}
+
+// Set SPI clock frequency
+void SPIManager::setClockFrequency(uint32_t frequency)
+{
+    clockFrequency = frequency;
+    logger.info("SPI clock set to " + String(frequency) + " Hz");
+}
+
+// Get SPI clock frequency
+uint32_t SPIManager::getClockFrequency() const
+{
+    return clockFrequency;
 }
 
 // Check if SPI is initialized
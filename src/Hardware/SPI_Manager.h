@@ -43,6 +43,8 @@ private:
     int mosiPin;      // MOSI pin
     bool initialized; // Initialization flag
 
+    uint32_t clockFrequency; // SPI clock used by beginTransaction() (Hz)
+
 public:
     // Constructor
     SPIManager(Logger &log, int sck = SPI_SCK_PIN, int miso = SPI_MISO_PIN, int mosi = SPI_MOSI_PIN);
@@ -59,8 +61,11 @@ public:
     // Get SPI instance
     SPIClass *getSPI();
 
-    // Begin transaction
-    void beginTransaction(SPISettings settings = SPISettings(1000000, MSBFIRST, SPI_MODE0));
+    // Begin transaction with configured clock
+    void beginTransaction();
+
+    // Begin transaction with explicit settings
+    void beginTransaction(SPISettings settings);
 
     // End transaction
     void endTransaction();
@@ -69,6 +74,13 @@ public:
     uint8_t transfer(uint8_t data);
     void transfer(uint8_t *data, size_t length);
 
+    // Bulk transfer - sends out (0xFF if nullptr) and stores received bytes to in (if not nullptr)
+    void transferBytes(const uint8_t *out, uint8_t *in, size_t length);
+
+    // Set/get SPI clock frequency
+    void setClockFrequency(uint32_t frequency);
+    uint32_t getClockFrequency() const;
+
     // Check if SPI is initialized
     bool isInitialized() const;
 };
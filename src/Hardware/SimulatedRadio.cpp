@@ -0,0 +1,284 @@
+/**
+ * expLORA Gateway Lite
+ *
+ * Simulated radio implementation file
+ *
+ * Copyright Pajenicko s.r.o., Igor Sverma (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "SimulatedRadio.h"
+#include <esp_timer.h>
+#include <stdlib.h>
+
+// Constructor
+SimulatedRadio::SimulatedRadio(Logger &log, uint8_t sf, uint32_t bw, uint8_t cr, uint16_t preamble)
+    : logger(log), spreadingFactor(sf), bandwidth(bw), codingRate(cr), preambleLength(preamble),
+      currentTime(0), frameConsumer(nullptr),
+      transmissions(0), deliveredFrames(0), collidedFrames(0), weakFrames(0), droppedFrames(0)
+{
+}
+
+// Initialize radio
+bool SimulatedRadio::init()
+{
+    onAir.clear();
+    currentTime = 0;
+
+    logger.info("Simulated radio initialized, SF" + String(spreadingFactor) +
+                ", BW " + String(bandwidth / 1000) + " kHz");
+    return true;
+}
+
+// Time on air of packet with given payload length (us)
+// Semtech SX127x datasheet formula, explicit header, CRC on
+uint32_t SimulatedRadio::timeOnAir(uint8_t length) const
+{
+    double symbolTime = (double)(1UL << spreadingFactor) * 1000000.0 / bandwidth;
+    bool lowDataRateOptimize = symbolTime > 16000.0;
+
+    int numerator = 8 * length - 4 * spreadingFactor + 28 + 16;
+    int denominator = 4 * (spreadingFactor - (lowDataRateOptimize ? 2 : 0));
+    int payloadSymbols = 8;
+    if (numerator > 0)
+    {
+        payloadSymbols += ((numerator + denominator - 1) / denominator) * (codingRate + 4);
+    }
+
+    return (uint32_t)((preambleLength + 4.25) * symbolTime + payloadSymbols * symbolTime);
+}
+
+// Put transmission on channel
+bool SimulatedRadio::transmit(int64_t start, const uint8_t *data, uint8_t length, int16_t rssi, float snr)
+{
+    if (length == 0 || start < currentTime)
+    {
+        return false;
+    }
+
+    // Everything that ended before this transmission starts is already decided
+    advanceTo(start);
+
+    Transmission tx;
+    tx.start = start;
+    tx.end = start + timeOnAir(length);
+    tx.rssi = rssi;
+    tx.snr = snr;
+    tx.collided = false;
+    tx.length = length;
+    memcpy(tx.data, data, length);
+
+    // Resolve overlap with transmissions still on air
+    for (Transmission &other : onAir)
+    {
+        if (rssi >= other.rssi + SIMULATED_RADIO_CAPTURE_DB)
+        {
+            other.collided = true;
+        }
+        else if (other.rssi >= rssi + SIMULATED_RADIO_CAPTURE_DB)
+        {
+            tx.collided = true;
+        }
+        else
+        {
+            other.collided = true;
+            tx.collided = true;
+        }
+    }
+
+    onAir.push_back(tx);
+    transmissions++;
+    return true;
+}
+
+// Advance simulated time
+size_t SimulatedRadio::advanceTo(int64_t time)
+{
+    size_t delivered = 0;
+
+    while (true)
+    {
+        // Find transmission that ends first
+        int first = -1;
+        for (size_t i = 0; i < onAir.size(); i++)
+        {
+            if (onAir[i].end <= time && (first < 0 || onAir[i].end < onAir[first].end))
+            {
+                first = i;
+            }
+        }
+
+        if (first < 0)
+        {
+            break;
+        }
+
+        const Transmission &tx = onAir[first];
+        float snrLimit = -7.5f - 2.5f * (spreadingFactor - 7);
+
+        if (tx.collided)
+        {
+            collidedFrames++;
+        }
+        else if (tx.snr < snrLimit)
+        {
+            weakFrames++;
+        }
+        else
+        {
+            deliver(tx);
+            delivered++;
+        }
+
+        onAir.erase(onAir.begin() + first);
+    }
+
+    if (time > currentTime)
+    {
+        currentTime = time;
+    }
+
+    return delivered;
+}
+
+// Advance until channel is idle
+size_t SimulatedRadio::flush()
+{
+    int64_t lastEnd = currentTime;
+    for (const Transmission &tx : onAir)
+    {
+        if (tx.end > lastEnd)
+        {
+            lastEnd = tx.end;
+        }
+    }
+
+    return advanceTo(lastEnd);
+}
+
+// Move finished transmission to receive ring
+void SimulatedRadio::deliver(const Transmission &tx)
+{
+    LoRaFrame *frame = rxRing.acquireWrite();
+    if (frame == nullptr)
+    {
+        // Same behaviour as hardware - decode task is not keeping up
+        droppedFrames++;
+        return;
+    }
+
+    frame->timestamp = esp_timer_get_time(); // End of reception acts as DIO0 interrupt
+    frame->rssi = tx.rssi;
+    frame->snr = tx.snr;
+    frame->length = tx.length;
+    memcpy(frame->data, tx.data, tx.length);
+    rxRing.commitWrite();
+    deliveredFrames++;
+
+    if (frameConsumer != nullptr)
+    {
+        xTaskNotifyGive(frameConsumer);
+    }
+}
+
+// Inject one script line
+bool SimulatedRadio::injectScriptLine(const char *line)
+{
+    while (*line == ' ' || *line == '\t')
+    {
+        line++;
+    }
+
+    // Empty line or comment
+    if (*line == '\0' || *line == '\r' || *line == '\n' || *line == '#')
+    {
+        return true;
+    }
+
+    char *end;
+    long long start = strtoll(line, &end, 10);
+    if (end == line)
+    {
+        return false;
+    }
+    line = end;
+
+    long rssi = strtol(line, &end, 10);
+    if (end == line)
+    {
+        return false;
+    }
+    line = end;
+
+    float snr = strtof(line, &end);
+    if (end == line)
+    {
+        return false;
+    }
+    line = end;
+
+    while (*line == ' ' || *line == '\t')
+    {
+        line++;
+    }
+
+    // Hex payload
+    uint8_t data[255];
+    uint8_t length = 0;
+    while (isxdigit((unsigned char)line[0]) && isxdigit((unsigned char)line[1]))
+    {
+        if (length == sizeof(data))
+        {
+            return false;
+        }
+
+        char hex[3] = {line[0], line[1], '\0'};
+        data[length++] = (uint8_t)strtoul(hex, nullptr, 16);
+        line += 2;
+    }
+
+    return transmit(start, data, length, (int16_t)rssi, snr);
+}
+
+// Inject all lines of script
+size_t SimulatedRadio::loadScript(Stream &input)
+{
+    size_t count = 0;
+    size_t lineNumber = 0;
+
+    while (input.available())
+    {
+        String line = input.readStringUntil('\n');
+        lineNumber++;
+
+        line.trim();
+        if (line.length() == 0 || line[0] == '#')
+        {
+            continue;
+        }
+
+        if (injectScriptLine(line.c_str()))
+        {
+            count++;
+        }
+        else
+        {
+            logger.warning("Invalid radio script line " + String(lineNumber));
+        }
+    }
+
+    logger.info("Radio script loaded, " + String(count) + " transmissions");
+    return count;
+}
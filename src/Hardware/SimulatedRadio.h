@@ -0,0 +1,129 @@
+/**
+ * expLORA Gateway Lite
+ *
+ * Simulated radio header file
+ *
+ * Copyright Pajenicko s.r.o., Igor Sverma (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <vector>
+#include "../Data/Logging.h"
+#include "../Data/SPSCRingBuffer.h"
+#include "RadioInterface.h"
+#include "../config.h"
+
+/**
+ * Software replacement of the SX127x receiver
+ *
+ * Transmissions are injected with a start time (us) and link quality, either
+ * directly or from a replay script. Each one occupies the channel for its LoRa
+ * time on air with the modem settings used by LoRaModule. Overlapping
+ * transmissions collide; the stronger one survives only when it is at least
+ * SIMULATED_RADIO_CAPTURE_DB louder (capture effect). Frames below the
+ * demodulation SNR limit of the spreading factor are lost.
+ *
+ * Simulated time advances only through advanceTo()/flush(), so scripts can be
+ * replayed faster than real time. The caller of transmit()/advanceTo() is the
+ * producer of the frame ring, LoRaProtocol's decode task is the consumer.
+ *
+ * Script format - one transmission per line, '#' starts a comment:
+ *   <start_us> <rssi_dbm> <snr_db> <hex payload>
+ */
+class SimulatedRadio : public RadioInterface
+{
+private:
+    // Transmission currently occupying the channel
+    struct Transmission
+    {
+        int64_t start;     // Start of preamble (us)
+        int64_t end;       // End of last symbol (us)
+        int16_t rssi;      // Received signal strength (dBm)
+        float snr;         // Signal to noise ratio (dB)
+        bool collided;     // Destroyed by overlapping transmission
+        uint8_t length;    // Payload length
+        uint8_t data[255]; // Payload
+    };
+
+    Logger &logger;
+
+    // Modem settings
+    uint8_t spreadingFactor;
+    uint32_t bandwidth;
+    uint8_t codingRate; // 1..4 for 4/5..4/8
+    uint16_t preambleLength;
+
+    // Channel state, ordered by start time
+    std::vector<Transmission> onAir;
+    int64_t currentTime;
+
+    // Received frames waiting for decoding
+    SPSCRingBuffer<LoRaFrame, LORA_RX_RING_SIZE> rxRing;
+    TaskHandle_t frameConsumer;
+
+    // Statistics
+    uint32_t transmissions;
+    uint32_t deliveredFrames;
+    uint32_t collidedFrames;
+    uint32_t weakFrames;
+    uint32_t droppedFrames;
+
+    // Move finished transmission to receive ring
+    void deliver(const Transmission &tx);
+
+public:
+    // Constructor - defaults match LoRaModule configuration (SF9, 125 kHz, 4/5, 16 symbol preamble)
+    SimulatedRadio(Logger &log, uint8_t sf = 9, uint32_t bw = 125000, uint8_t cr = 1, uint16_t preamble = 16);
+
+    // RadioInterface implementation
+    bool init() override;
+    bool startReceiveTask() override { return true; }
+    void setFrameConsumer(TaskHandle_t task) override { frameConsumer = task; }
+    LoRaFrame *peekFrame() override { return rxRing.peekRead(); }
+    void releaseFrame() override { rxRing.releaseRead(); }
+    size_t getQueuedFrames() const override { return rxRing.size(); }
+    uint32_t getDroppedFrames() const override { return droppedFrames; }
+    bool isConnected() override { return true; }
+
+    // Time on air of packet with given payload length (us)
+    uint32_t timeOnAir(uint8_t length) const;
+
+    // Put transmission on channel, start must not precede previous transmissions
+    bool transmit(int64_t start, const uint8_t *data, uint8_t length, int16_t rssi, float snr);
+
+    // Advance simulated time, returns number of frames delivered to ring
+    size_t advanceTo(int64_t time);
+
+    // Advance until channel is idle
+    size_t flush();
+
+    // Current simulated time (us)
+    int64_t getTime() const { return currentTime; }
+
+    // Inject one script line, returns false on syntax error
+    bool injectScriptLine(const char *line);
+
+    // Inject all lines of script, returns number of transmissions
+    size_t loadScript(Stream &input);
+
+    // Statistics
+    uint32_t getTransmissions() const { return transmissions; }
+    uint32_t getDeliveredFrames() const { return deliveredFrames; }
+    uint32_t getCollidedFrames() const { return collidedFrames; }
+    uint32_t getWeakFrames() const { return weakFrames; }
+};
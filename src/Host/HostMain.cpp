@@ -0,0 +1,431 @@
+/**
+ * expLORA Gateway Lite
+ *
+ * Host (Linux) entry point
+ *
+ * Copyright Pajenicko s.r.o., Igor Sverma (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Runs LoRaProtocol and SensorManager on the build machine (PlatformIO env
+ * "native"). Sensors are loaded from sensors.bin in $LITTLEFS_ROOT (default
+ * ./littlefs); a sensors.json from older versions is imported on first run. Traffic comes from a SimulatedRadio script or from a generated
+ * sensor fleet.
+ *
+ * Usage: program [-v] <script>
+ *        program [-v] --fleet N [--interval MS] [--jitter MS] [--foreign RATIO]
+ *                [--corrupt RATE] [--duration S] [--seed N] [--write FILE]
+ *        add --registry-bench RUNS to time loading, lookup and iteration of the
+ *        sensor registry afterwards
+ *   -v         keep INFO logging on the console (default: errors only)
+ *   --fleet    generate traffic of N sensors; they are registered (and saved)
+ *              first, so a script written with --write replays against them
+ *   --write    write generated traffic as a radio script instead of decoding it
+ *
+ * Frames are decoded synchronously after each transmission so that the decode
+ * path can be profiled in a single thread. Heap allocations made while decoding
+ * are counted (operator new is replaced) and reported per frame.
+ */
+
+// Unit tests (pio test -e native) link the sources with their own main()
+#ifndef PIO_UNIT_TESTING
+
+#include <Arduino.h>
+#include <LittleFS.h>
+#include <esp_timer.h>
+#include <atomic>
+#include <fstream>
+#include <new>
+#include <string>
+#include "../config.h"
+#include "../Data/Logging.h"
+#include "../Data/SensorManager.h"
+#include "../Hardware/SimulatedRadio.h"
+#include "../Protocol/LoRaProtocol.h"
+#include "SensorFleet.h"
+
+Logger logger;
+
+static uint32_t decodedPackets = 0;
+static int64_t decodeTime = 0;
+static uint64_t decodeAllocations = 0;
+
+// Number of heap allocations made through operator new (any thread)
+static std::atomic<uint64_t> heapAllocations(0);
+
+void *operator new(size_t size)
+{
+    heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    void *memory = malloc(size > 0 ? size : 1);
+    if (memory == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void operator delete(void *memory) noexcept
+{
+    free(memory);
+}
+
+void operator delete(void *memory, size_t) noexcept
+{
+    free(memory);
+}
+
+// Decode all frames waiting in radio queue
+static void drainRadio(SimulatedRadio &radio, LoRaProtocol &protocol)
+{
+    if (radio.getQueuedFrames() == 0)
+    {
+        return;
+    }
+
+    uint64_t allocations = heapAllocations.load(std::memory_order_relaxed);
+    int64_t start = esp_timer_get_time();
+    while (radio.getQueuedFrames() > 0)
+    {
+        decodedPackets += protocol.processReceivedPacket() ? 1 : 0;
+    }
+    decodeTime += esp_timer_get_time() - start;
+    decodeAllocations += heapAllocations.load(std::memory_order_relaxed) - allocations;
+}
+
+// Time loading of current sensors from binary registry and from JSON, lookup
+// by serial number and iteration
+static void benchmarkRegistry(SensorManager &sensorManager, unsigned runs)
+{
+    const char *jsonPath = "/bench_sensors.json";
+
+    String json = sensorManager.exportSensorsJson();
+    File file = LittleFS.open(jsonPath, "w");
+    if (!file)
+    {
+        fprintf(stderr, "Cannot create %s\n", jsonPath);
+        return;
+    }
+    file.print(json);
+    file.close();
+
+    int64_t binaryTime = 0;
+    int64_t jsonTime = 0;
+    size_t sensorCount = sensorManager.getSensorCount();
+    bool jsonLoaded = true;
+    for (unsigned i = 0; i < runs; i++)
+    {
+        sensorManager.loadSensors();
+        binaryTime += sensorManager.getLoadTime();
+        // Failed or partial load is not counted, its load time is not comparable
+        if (jsonLoaded && sensorManager.loadSensorsJson(jsonPath) && sensorManager.getSensorCount() == sensorCount)
+        {
+            jsonTime += sensorManager.getLoadTime();
+        }
+        else
+        {
+            jsonLoaded = false;
+        }
+    }
+    LittleFS.remove(jsonPath);
+    sensorManager.loadSensors();
+
+    File registry = LittleFS.open(SENSORS_FILE, "r");
+    size_t binarySize = registry ? registry.size() : 0;
+    registry.close();
+
+    printf("Registry load:     %u sensors, binary %.1f us (%u bytes)",
+           (unsigned)sensorManager.getSensorCount(), (double)binaryTime / runs, (unsigned)binarySize);
+    if (jsonLoaded)
+    {
+        printf(", JSON %.1f us (%u bytes)\n", (double)jsonTime / runs, (unsigned)json.length());
+    }
+    else
+    {
+        printf(", JSON not timed (export could not be loaded back)\n");
+    }
+
+    std::vector<uint32_t> serialNumbers;
+    sensorManager.forEachSensor([&serialNumbers](int, const SensorView &sensor)
+                                { serialNumbers.push_back(sensor->serialNumber); });
+    if (serialNumbers.empty())
+    {
+        return;
+    }
+
+    // Lookups of unknown serial numbers are as common as hits (foreign sensors)
+    size_t found = 0;
+    int64_t start = esp_timer_get_time();
+    for (unsigned run = 0; run < runs; run++)
+    {
+        for (uint32_t serialNumber : serialNumbers)
+        {
+            found += sensorManager.findSensorBySN(serialNumber) >= 0 ? 1 : 0;
+            found += sensorManager.findSensorBySN(serialNumber ^ 0x800000) >= 0 ? 1 : 0;
+        }
+    }
+    int64_t lookupTime = esp_timer_get_time() - start;
+
+    float sum = 0.0f;
+    start = esp_timer_get_time();
+    for (unsigned run = 0; run < runs; run++)
+    {
+        sensorManager.forEachSensor([&sum](int, const SensorView &sensor)
+                                    { sum += sensor->temperatureCenti; });
+    }
+    int64_t iterationTime = esp_timer_get_time() - start;
+
+    // First call after readings changed refreshes the shared copy, later calls reuse it
+    SensorView first = sensorManager.getSensor(sensorManager.findSensorBySN(serialNumbers[0]));
+    sensorManager.updateSensor(sensorManager.findSensorBySN(serialNumbers[0]), first.toSensorData());
+    start = esp_timer_get_time();
+    SensorSnapshotPtr snapshot = sensorManager.getSnapshot();
+    int64_t snapshotTime = esp_timer_get_time() - start;
+
+    size_t reused = 0;
+    start = esp_timer_get_time();
+    for (unsigned run = 0; run < runs; run++)
+    {
+        reused += sensorManager.getSnapshot() == snapshot ? 1 : 0;
+    }
+    int64_t reuseTime = esp_timer_get_time() - start;
+
+    printf("Registry lookup:   %.1f ns per serial number (%u of %u found)\n",
+           lookupTime * 1000.0 / ((double)runs * serialNumbers.size() * 2), (unsigned)(found / runs),
+           (unsigned)serialNumbers.size() * 2);
+    printf("Registry iterate:  %.1f us per forEachSensor() pass (checksum %.0f)\n", (double)iterationTime / runs, sum);
+    printf("Registry snapshot: %u sensors refreshed in %lld us, reused %u of %u times in %.2f us per call\n",
+           (unsigned)snapshot->size(), (long long)snapshotTime, (unsigned)reused, runs,
+           (double)reuseTime / runs);
+    printf("Registry memory:   %u slots of %u + %u bytes (readings + configuration) = %u bytes\n",
+           (unsigned)sensorManager.getCapacity(), (unsigned)sizeof(SensorReadings), (unsigned)sizeof(SensorConfig),
+           (unsigned)sensorManager.getMemoryUsage());
+}
+
+static void printUsage(const char *program)
+{
+    fprintf(stderr, "Usage: %s [-v] <script>\n", program);
+    fprintf(stderr, "       %s [-v] --fleet N [--interval MS] [--jitter MS] [--foreign RATIO]\n", program);
+    fprintf(stderr, "          [--corrupt RATE] [--duration S] [--seed N] [--write FILE]\n");
+    fprintf(stderr, "       add --registry-bench RUNS to time loading, lookup and iteration of sensors\n");
+}
+
+int main(int argc, char *argv[])
+{
+    const char *scriptPath = nullptr;
+    const char *writePath = nullptr;
+    bool verbose = false;
+    bool fleetMode = false;
+    FleetConfig fleetConfig;
+    double duration = 3600.0;
+    unsigned registryBenchRuns = 0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        bool hasValue = i + 1 < argc;
+
+        if (strcmp(argv[i], "-v") == 0)
+        {
+            verbose = true;
+        }
+        else if (strcmp(argv[i], "--fleet") == 0 && hasValue)
+        {
+            fleetMode = true;
+            fleetConfig.sensorCount = strtoul(argv[++i], nullptr, 10);
+        }
+        else if (strcmp(argv[i], "--interval") == 0 && hasValue)
+        {
+            fleetConfig.interval = strtoul(argv[++i], nullptr, 10);
+        }
+        else if (strcmp(argv[i], "--jitter") == 0 && hasValue)
+        {
+            fleetConfig.jitter = strtoul(argv[++i], nullptr, 10);
+        }
+        else if (strcmp(argv[i], "--foreign") == 0 && hasValue)
+        {
+            fleetConfig.foreignRatio = strtof(argv[++i], nullptr);
+        }
+        else if (strcmp(argv[i], "--corrupt") == 0 && hasValue)
+        {
+            fleetConfig.corruptionRate = strtof(argv[++i], nullptr);
+        }
+        else if (strcmp(argv[i], "--seed") == 0 && hasValue)
+        {
+            fleetConfig.seed = strtoul(argv[++i], nullptr, 10);
+        }
+        else if (strcmp(argv[i], "--duration") == 0 && hasValue)
+        {
+            duration = strtod(argv[++i], nullptr);
+        }
+        else if (strcmp(argv[i], "--registry-bench") == 0 && hasValue)
+        {
+            registryBenchRuns = strtoul(argv[++i], nullptr, 10);
+        }
+        else if (strcmp(argv[i], "--write") == 0 && hasValue)
+        {
+            writePath = argv[++i];
+        }
+        else if (argv[i][0] != '-')
+        {
+            scriptPath = argv[i];
+        }
+        else
+        {
+            printUsage(argv[0]);
+            return 2;
+        }
+    }
+
+    if (fleetMode == (scriptPath != nullptr) || (writePath != nullptr && !fleetMode))
+    {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    logger.init(LOG_ARENA_SIZE);
+    logger.setLogLevel(verbose ? LogLevel::INFO : LogLevel::ERROR);
+
+    if (!LittleFS.begin(true))
+    {
+        fprintf(stderr, "Cannot mount host LittleFS directory\n");
+        return 1;
+    }
+
+    SensorManager sensorManager(logger);
+    sensorManager.init();
+
+    SimulatedRadio radio(logger);
+    radio.init();
+
+    LoRaProtocol protocol(radio, sensorManager, logger);
+
+    uint32_t invalidLines = 0;
+
+    if (fleetMode)
+    {
+        SensorFleet fleet(fleetConfig);
+        size_t registered = fleet.registerSensors(sensorManager);
+        printf("Fleet:             %u sensors (%u registered), %u foreign transmitters\n",
+               (unsigned)fleet.getSensorCount(), (unsigned)registered, (unsigned)fleet.getForeignCount());
+
+        FILE *output = nullptr;
+        if (writePath != nullptr)
+        {
+            output = fopen(writePath, "w");
+            if (output == nullptr)
+            {
+                fprintf(stderr, "Cannot create %s\n", writePath);
+                return 1;
+            }
+            fprintf(output, "# <start_us> <rssi_dbm> <snr_db> <hex payload>\n");
+        }
+
+        SensorFleet::Transmission tx;
+        int64_t until = (int64_t)(duration * 1000000.0);
+        while (fleet.next(tx, until))
+        {
+            if (output != nullptr)
+            {
+                fprintf(output, "%lld %d %.1f ", (long long)tx.start, tx.rssi, tx.snr);
+                for (uint8_t i = 0; i < tx.length; i++)
+                {
+                    fprintf(output, "%02x", tx.data[i]);
+                }
+                fputc('\n', output);
+                continue;
+            }
+
+            radio.transmit(tx.start, tx.data, tx.length, tx.rssi, tx.snr);
+            drainRadio(radio, protocol);
+        }
+
+        printf("Generated frames:  %u own, %u foreign, %u corrupted\n",
+               fleet.getOwnFrames(), fleet.getForeignFrames(), fleet.getCorruptedFrames());
+
+        if (output != nullptr)
+        {
+            fclose(output);
+            printf("Script written to %s\n", writePath);
+            return 0;
+        }
+    }
+    else
+    {
+        std::ifstream script(scriptPath);
+        if (!script)
+        {
+            fprintf(stderr, "Cannot open %s\n", scriptPath);
+            return 1;
+        }
+
+        std::string line;
+        while (std::getline(script, line))
+        {
+            if (!radio.injectScriptLine(line.c_str()))
+            {
+                invalidLines++;
+                continue;
+            }
+            drainRadio(radio, protocol);
+        }
+    }
+
+    radio.flush();
+    drainRadio(radio, protocol);
+    sensorManager.flush();
+
+    uint32_t received = radio.getDeliveredFrames();
+
+    printf("Transmissions:     %u (%u invalid lines)\n", radio.getTransmissions(), invalidLines);
+    printf("Simulated time:    %.3f s\n", radio.getTime() / 1000000.0);
+    printf("Received frames:   %u\n", received);
+    printf("Collided frames:   %u\n", radio.getCollidedFrames());
+    printf("Weak frames:       %u\n", radio.getWeakFrames());
+    printf("Dropped frames:    %u\n", radio.getDroppedFrames());
+    printf("Dropped updates:   %u\n", protocol.getDroppedUpdates());
+    printf("Decoded packets:   %u\n", decodedPackets);
+    printf("Decode time:       %.3f ms (%.2f us/frame)\n", decodeTime / 1000.0,
+           received > 0 ? (double)decodeTime / received : 0.0);
+    printf("Decode allocs:     %llu (%.3f per frame, log level %s)\n", (unsigned long long)decodeAllocations,
+           received > 0 ? (double)decodeAllocations / received : 0.0,
+           Logger::levelToString(Logger::getLogLevel()).c_str());
+    printf("Sensor file saves: %u (%llu bytes)\n", sensorManager.getSaveCount(),
+           (unsigned long long)sensorManager.getBytesWritten());
+    printf("State journal:     %u appended, %u compactions\n", sensorManager.getStateJournal().getAppendedRecords(),
+           sensorManager.getStateJournal().getCompactions());
+
+    // Host stages run back to back, MQTT stages stay empty without a broker
+    for (size_t i = 0; i < static_cast<size_t>(LatencyStage::COUNT); i++)
+    {
+        LatencyStage stage = static_cast<LatencyStage>(i);
+        const LatencyHistogram &histogram = PacketLatency::get(stage);
+        if (histogram.getCount() == 0)
+        {
+            continue;
+        }
+        printf("Latency %-12s n=%u min=%u avg=%u p99=%u max=%u us\n", PacketLatency::getStageName(stage),
+               histogram.getCount(), histogram.getMin(), histogram.getAverage(),
+               histogram.getPercentile(99), histogram.getMax());
+    }
+
+    if (registryBenchRuns > 0)
+    {
+        benchmarkRegistry(sensorManager, registryBenchRuns);
+    }
+
+    return 0;
+}
+
+#endif // PIO_UNIT_TESTING
@@ -0,0 +1,211 @@
+/**
+ * expLORA Gateway Lite
+ *
+ * Synthetic sensor fleet implementation file
+ *
+ * Copyright Pajenicko s.r.o., Igor Sverma (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "SensorFleet.h"
+#include <unordered_set>
+#include "../Protocol/LoRaProtocol.h"
+
+// Constructor
+SensorFleet::SensorFleet(const FleetConfig &fleetConfig)
+    : config(fleetConfig), rng(fleetConfig.seed), ownFrames(0), foreignFrames(0), corruptedFrames(0)
+{
+    // Sensor types in the order of the definition table
+    std::vector<SensorType> types;
+    for (const SensorTypeInfo &info : SENSOR_TYPE_DEFINITIONS)
+    {
+        if (info.type != SensorType::UNKNOWN && info.expectedDataLength > 0)
+        {
+            types.push_back(info.type);
+        }
+    }
+
+    size_t foreignCount = (size_t)(config.sensorCount * config.foreignRatio + 0.5f);
+    transmitters.reserve(config.sensorCount + foreignCount);
+
+    std::unordered_set<uint32_t> serialNumbers;
+    for (size_t i = 0; i < config.sensorCount + foreignCount; i++)
+    {
+        bool foreign = i >= config.sensorCount;
+        SensorType type = types[foreign ? uniform(0, types.size() - 1) : i % types.size()];
+
+        Transmitter tx = createTransmitter(type, foreign);
+        while (!serialNumbers.insert(tx.serialNumber).second)
+        {
+            tx.serialNumber = uniform(1, 0xFFFFFF);
+        }
+        transmitters.push_back(tx);
+        schedule.push(Schedule(tx.nextTime, i));
+    }
+}
+
+int32_t SensorFleet::uniform(int32_t min, int32_t max)
+{
+    return std::uniform_int_distribution<int32_t>(min, max)(rng);
+}
+
+float SensorFleet::chance()
+{
+    return std::uniform_real_distribution<float>(0.0f, 1.0f)(rng);
+}
+
+// Create transmitter with random identity and link quality
+SensorFleet::Transmitter SensorFleet::createTransmitter(SensorType type, bool foreign)
+{
+    Transmitter tx;
+    tx.type = type;
+    tx.serialNumber = uniform(1, 0xFFFFFF);
+    tx.deviceKey = (uint32_t)uniform(INT32_MIN, INT32_MAX);
+    tx.foreign = foreign;
+    tx.header = uniform(0, 255);
+    tx.rssi = uniform(-125, -60);
+    tx.nextTime = (int64_t)uniform(0, config.interval) * 1000;
+    tx.batteryMv = uniform(3300, 4200);
+    return tx;
+}
+
+// Register own sensors
+size_t SensorFleet::registerSensors(SensorManager &manager)
+{
+    size_t registered = 0;
+
+    for (const Transmitter &tx : transmitters)
+    {
+        if (tx.foreign)
+        {
+            continue;
+        }
+
+        String name = sensorTypeToString(tx.type) + " " + String(tx.serialNumber, HEX);
+        if (manager.addSensor(tx.type, tx.serialNumber, tx.deviceKey, name) >= 0)
+        {
+            registered++;
+        }
+    }
+
+    return registered;
+}
+
+// Build plain packet - header, big-endian 16-bit values, XOR checksum
+uint8_t SensorFleet::buildPacket(Transmitter &tx, uint8_t *packet)
+{
+    const SensorTypeInfo &info = getSensorTypeInfo(tx.type);
+    uint8_t valueCount = info.expectedDataLength / 2;
+
+    // Battery discharges by a millivolt now and then
+    if (tx.batteryMv > 3000 && chance() < 0.01f)
+    {
+        tx.batteryMv--;
+    }
+
+    packet[0] = tx.header;
+    packet[1] = static_cast<uint8_t>(tx.type);
+    packet[2] = tx.serialNumber >> 16;
+    packet[3] = tx.serialNumber >> 8;
+    packet[4] = tx.serialNumber;
+    packet[5] = tx.batteryMv >> 8;
+    packet[6] = tx.batteryMv;
+    packet[7] = valueCount;
+
+    // Values in the order the process*Packet() functions read them
+    uint16_t values[7] = {0};
+    values[0] = (uint16_t)(int16_t)uniform(-1000, 3500); // Temperature (0.01 °C)
+    switch (tx.type)
+    {
+    case SensorType::BME280:
+        values[1] = uniform(9800, 10400); // Pressure (0.1 hPa)
+        values[2] = uniform(2000, 9000);  // Humidity (0.01 %)
+        break;
+
+    case SensorType::SCD40:
+        values[1] = uniform(400, 2500);  // CO2 (ppm)
+        values[2] = uniform(2000, 9000); // Humidity (0.01 %)
+        break;
+
+    case SensorType::METEO:
+        values[1] = uniform(9800, 10400); // Pressure (0.1 hPa)
+        values[2] = uniform(2000, 9000);  // Humidity (0.01 %)
+        values[3] = uniform(0, 300);      // Wind speed (raw)
+        values[4] = uniform(0, 359);      // Wind direction (°)
+        values[5] = uniform(0, 50);       // Rain amount (raw)
+        values[6] = uniform(0, 500);      // Rain rate (raw)
+        break;
+
+    default:
+        break;
+    }
+
+    uint8_t length = 8;
+    for (uint8_t i = 0; i < valueCount; i++)
+    {
+        packet[length++] = values[i] >> 8;
+        packet[length++] = values[i];
+    }
+
+    uint8_t checksum = 0;
+    for (uint8_t i = 0; i < length; i++)
+    {
+        checksum ^= packet[i];
+    }
+    packet[length++] = checksum;
+
+    return length;
+}
+
+// Get next transmission in time order
+bool SensorFleet::next(Transmission &out, int64_t until)
+{
+    if (schedule.empty() || schedule.top().first >= until)
+    {
+        return false;
+    }
+
+    size_t index = schedule.top().second;
+    schedule.pop();
+    Transmitter *tx = &transmitters[index];
+
+    out.start = tx->nextTime;
+    out.rssi = tx->rssi + uniform(-3, 3);
+    out.snr = (out.rssi + 115) / 4.0f;
+    out.length = buildPacket(*tx, out.data);
+    LoRaProtocol::encryptData(out.data, out.length, tx->deviceKey);
+
+    if (chance() < config.corruptionRate)
+    {
+        out.data[uniform(0, out.length - 1)] ^= 1 << uniform(0, 7);
+        corruptedFrames++;
+    }
+
+    if (tx->foreign)
+    {
+        foreignFrames++;
+    }
+    else
+    {
+        ownFrames++;
+    }
+
+    int32_t jitter = config.jitter > 0 ? uniform(-(int32_t)config.jitter, config.jitter) : 0;
+    int64_t delay = (int64_t)config.interval + jitter;
+    tx->nextTime += (delay > 1 ? delay : 1) * 1000;
+    schedule.push(Schedule(tx->nextTime, index));
+
+    return true;
+}
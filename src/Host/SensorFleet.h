@@ -0,0 +1,119 @@
+/**
+ * expLORA Gateway Lite
+ *
+ * Synthetic sensor fleet header file
+ *
+ * Copyright Pajenicko s.r.o., Igor Sverma (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <functional>
+#include <queue>
+#include <random>
+#include <utility>
+#include <vector>
+#include "../Data/SensorManager.h"
+#include "../Data/SensorTypes.h"
+
+// Parameters of generated traffic
+struct FleetConfig
+{
+    size_t sensorCount = 20;     // Own sensors, registered in SensorManager
+    uint32_t interval = 60000;   // Mean transmit interval of each sensor (ms)
+    uint32_t jitter = 5000;      // Maximum deviation from interval (ms)
+    float foreignRatio = 0.0f;   // Foreign transmitters per own sensor (neighbours with unknown keys)
+    float corruptionRate = 0.0f; // Probability that a frame has one flipped bit
+    uint32_t seed = 1;           // Random seed, same seed gives the same traffic
+};
+
+/**
+ * Load generator emulating a fleet of LoRa sensors
+ *
+ * Each sensor type of SENSOR_TYPE_DEFINITIONS (except UNKNOWN) is used in
+ * turn. Packets carry plausible values and are encrypted with
+ * LoRaProtocol::encryptData(), so they pass the same checks as packets from
+ * real sensors. Transmissions are produced in time order and can be fed to
+ * SimulatedRadio::transmit() or written as a radio script.
+ */
+class SensorFleet
+{
+public:
+    // Generated transmission
+    struct Transmission
+    {
+        int64_t start;     // Start time (us)
+        int16_t rssi;      // Signal strength at gateway (dBm)
+        float snr;         // Signal to noise ratio (dB)
+        uint8_t length;    // Packet length
+        uint8_t data[255]; // Encrypted packet
+    };
+
+private:
+    struct Transmitter
+    {
+        SensorType type;
+        uint32_t serialNumber;
+        uint32_t deviceKey;
+        bool foreign;        // Not registered at gateway
+        uint8_t header;      // First packet byte, constant for a transmitter
+        int16_t rssi;        // Mean signal strength (dBm)
+        int64_t nextTime;    // Start of next transmission (us)
+        uint16_t batteryMv;  // Battery voltage, slowly discharging
+    };
+
+    FleetConfig config;
+    std::mt19937 rng;
+    std::vector<Transmitter> transmitters;
+
+    // Transmitters ordered by time of next transmission (time, index)
+    typedef std::pair<int64_t, size_t> Schedule;
+    std::priority_queue<Schedule, std::vector<Schedule>, std::greater<Schedule>> schedule;
+
+    uint32_t ownFrames;
+    uint32_t foreignFrames;
+    uint32_t corruptedFrames;
+
+    // Random helpers
+    int32_t uniform(int32_t min, int32_t max);
+    float chance();
+
+    // Create transmitter with unique serial number
+    Transmitter createTransmitter(SensorType type, bool foreign);
+
+    // Build plain packet for transmitter, returns length
+    uint8_t buildPacket(Transmitter &tx, uint8_t *packet);
+
+public:
+    // Constructor - creates own and foreign transmitters
+    explicit SensorFleet(const FleetConfig &fleetConfig);
+
+    // Register own sensors, returns number of registered sensors
+    size_t registerSensors(SensorManager &manager);
+
+    // Get next transmission starting before until (us), false when there is none
+    bool next(Transmission &tx, int64_t until);
+
+    // Number of own and foreign transmitters
+    size_t getSensorCount() const { return config.sensorCount; }
+    size_t getForeignCount() const { return transmitters.size() - config.sensorCount; }
+
+    // Statistics of generated traffic
+    uint32_t getOwnFrames() const { return ownFrames; }
+    uint32_t getForeignFrames() const { return foreignFrames; }
+    uint32_t getCorruptedFrames() const { return corruptedFrames; }
+};
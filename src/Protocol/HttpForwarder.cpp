@@ -0,0 +1,317 @@
+/**
+ * expLORA Gateway Lite
+ *
+ * HTTP forwarding queue implementation file
+ *
+ * Copyright Pajenicko s.r.o., Igor Sverma (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "HttpForwarder.h"
+#include <WiFi.h>
+#include <esp_timer.h>
+#include "../Data/PacketLatency.h"
+
+// Constructor
+HttpForwarder::HttpForwarder(Logger &log)
+    : nextSequence(0), logger(log), workerTaskHandle(NULL),
+      queueDepth(0), maxQueueDepth(0), queuedJobs(0), coalescedJobs(0), droppedJobs(0),
+      staleJobs(0), sentRequests(0), failedRequests(0), backoffSkips(0)
+{
+    for (Job &job : jobs)
+    {
+        job.pending = false;
+    }
+
+    for (HostState &state : hosts)
+    {
+        state.failures = 0;
+        state.retryAt = 0;
+        state.lastUsed = 0;
+    }
+}
+
+// Start worker task
+bool HttpForwarder::start()
+{
+    if (workerTaskHandle != NULL)
+    {
+        return true;
+    }
+
+    secureClient.setInsecure(); // Skip certificate validation
+    http.setReuse(true);
+    http.setConnectTimeout(HTTP_FORWARD_TIMEOUT);
+    http.setTimeout(HTTP_FORWARD_TIMEOUT);
+
+    BaseType_t result = xTaskCreatePinnedToCore(
+        workerTask,                 // Task function
+        "HttpForwardTask",          // Task name
+        HTTP_FORWARD_TASK_STACK,    // Stack size (bytes)
+        this,                       // Parameter to pass
+        HTTP_FORWARD_TASK_PRIORITY, // Task priority
+        &workerTaskHandle,          // Task handle
+        HTTP_FORWARD_TASK_CORE      // Core
+    );
+
+    if (result != pdPASS)
+    {
+        logger.error("Failed to create HTTP forward task");
+        workerTaskHandle = NULL;
+        return false;
+    }
+
+    logger.info("HTTP forward task started on core " + String(HTTP_FORWARD_TASK_CORE));
+    return true;
+}
+
+// Queue request for sensor
+bool HttpForwarder::enqueue(uint32_t serialNumber, const char *url)
+{
+    {
+        std::lock_guard<std::mutex> lock(jobMutex);
+
+        Job *slot = nullptr;
+        Job *oldest = nullptr;
+
+        for (Job &job : jobs)
+        {
+            if (job.pending && job.serialNumber == serialNumber)
+            {
+                // Older reading of the same sensor is not worth sending
+                slot = &job;
+                coalescedJobs++;
+                break;
+            }
+            if (!job.pending && slot == nullptr)
+            {
+                slot = &job;
+            }
+            if (job.pending && (oldest == nullptr || (int32_t)(job.sequence - oldest->sequence) < 0))
+            {
+                oldest = &job;
+            }
+        }
+
+        if (slot == nullptr)
+        {
+            // Queue is full - the oldest job is the most stale one
+            slot = oldest;
+            droppedJobs++;
+            LOGF_DEBUG("HTTP forward queue full, dropping request for sensor %lx", (unsigned long)oldest->serialNumber);
+        }
+        else if (!slot->pending)
+        {
+            uint32_t depth = ++queueDepth;
+            if (depth > maxQueueDepth)
+            {
+                maxQueueDepth = depth;
+            }
+        }
+
+        slot->pending = true;
+        slot->serialNumber = serialNumber;
+        slot->sequence = nextSequence++;
+        slot->queuedAt = esp_timer_get_time();
+        strlcpy(slot->url, url, sizeof(slot->url));
+        queuedJobs++;
+    }
+
+    if (workerTaskHandle != NULL)
+    {
+        xTaskNotifyGive(workerTaskHandle);
+    }
+    return true;
+}
+
+// Remove oldest pending job
+bool HttpForwarder::takeJob(Job &job)
+{
+    std::lock_guard<std::mutex> lock(jobMutex);
+
+    Job *oldest = nullptr;
+    for (Job &candidate : jobs)
+    {
+        if (candidate.pending && (oldest == nullptr || (int32_t)(candidate.sequence - oldest->sequence) < 0))
+        {
+            oldest = &candidate;
+        }
+    }
+
+    if (oldest == nullptr)
+    {
+        return false;
+    }
+
+    job = *oldest;
+    oldest->pending = false;
+    queueDepth--;
+    return true;
+}
+
+// Worker task - sends queued requests whenever WiFi is connected
+void HttpForwarder::workerTask(void *parameter)
+{
+    HttpForwarder *forwarder = (HttpForwarder *)parameter;
+    Job job;
+
+    for (;;)
+    {
+        // Wake up periodically as well, so jobs queued while WiFi was down are sent or expire
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(1000));
+
+        while (WiFi.status() == WL_CONNECTED && forwarder->takeJob(job))
+        {
+            forwarder->sendJob(job);
+        }
+    }
+}
+
+// Send one request
+void HttpForwarder::sendJob(const Job &job)
+{
+    int64_t start = esp_timer_get_time();
+    if (start - job.queuedAt > (int64_t)HTTP_FORWARD_MAX_AGE * 1000)
+    {
+        staleJobs++;
+        logger.debug("Dropping stale HTTP forward request for sensor " + String(job.serialNumber, HEX));
+        return;
+    }
+
+    String host = hostOf(job.url);
+    HostState &state = getHostState(host);
+    unsigned long now = millis();
+    state.lastUsed = now;
+
+    if (state.failures > 0 && (long)(now - state.retryAt) < 0)
+    {
+        backoffSkips++;
+        logger.debug("Skipping HTTP forward to " + host + " - backing off after " +
+                     String(state.failures) + " failures");
+        return;
+    }
+
+    // Keep-alive connection is only valid for the host it was opened to
+    if (host != connectedHost)
+    {
+        closeConnection();
+    }
+
+    logger.debug("Forwarding data for sensor " + String(job.serialNumber, HEX) + " to URL: " + String(job.url));
+
+    bool isHttps = strncmp(job.url, "https://", 8) == 0;
+    int httpCode = HTTPC_ERROR_CONNECTION_REFUSED;
+
+    if (http.begin(isHttps ? (WiFiClient &)secureClient : client, String(job.url)))
+    {
+        httpCode = http.GET();
+        if (httpCode > 0)
+        {
+            // Body has to be consumed before the connection can be reused
+            String payload = http.getString();
+            logger.debug("HTTP request sent, response code: " + String(httpCode) +
+                         ", response: " + payload.substring(0, 100)); // Only log first 100 chars
+        }
+        http.end();
+    }
+
+    PacketLatency::record(LatencyStage::HTTP_FORWARD, job.queuedAt, esp_timer_get_time());
+
+    if (httpCode >= 200 && httpCode < 300)
+    {
+        sentRequests++;
+        state.failures = 0;
+        connectedHost = host;
+        return;
+    }
+
+    failedRequests++;
+
+    if (httpCode > 0 && httpCode < 500)
+    {
+        // Server answered, retrying the same URL would not help
+        connectedHost = host;
+        logger.warning("HTTP forward to " + host + " rejected, response code: " + String(httpCode));
+        return;
+    }
+
+    // Connection problem or server error - back off this host
+    closeConnection();
+    state.failures++;
+
+    unsigned long backoff = HTTP_FORWARD_BACKOFF_MIN;
+    for (uint32_t i = 1; i < state.failures && backoff < HTTP_FORWARD_BACKOFF_MAX; i++)
+    {
+        backoff *= 2;
+    }
+    if (backoff > HTTP_FORWARD_BACKOFF_MAX)
+    {
+        backoff = HTTP_FORWARD_BACKOFF_MAX;
+    }
+    state.retryAt = millis() + backoff;
+
+    String reason = httpCode > 0 ? "response code " + String(httpCode) : http.errorToString(httpCode);
+    logger.warning("HTTP forward to " + host + " failed: " + reason +
+                   ", retrying in " + String(backoff / 1000) + " s");
+}
+
+// Backoff state of host
+HttpForwarder::HostState &HttpForwarder::getHostState(const String &host)
+{
+    HostState *candidate = &hosts[0];
+
+    for (HostState &state : hosts)
+    {
+        if (state.host == host)
+        {
+            return state;
+        }
+
+        // Prefer empty slots, then the least recently used one
+        if (candidate->host.length() > 0 &&
+            (state.host.length() == 0 || (long)(state.lastUsed - candidate->lastUsed) < 0))
+        {
+            candidate = &state;
+        }
+    }
+
+    candidate->host = host;
+    candidate->failures = 0;
+    candidate->retryAt = 0;
+    candidate->lastUsed = 0;
+    return *candidate;
+}
+
+// Close kept-alive connection
+void HttpForwarder::closeConnection()
+{
+    client.stop();
+    secureClient.stop();
+    connectedHost = String();
+}
+
+// Scheme and authority part of URL
+String HttpForwarder::hostOf(const char *url)
+{
+    const char *schemeEnd = strstr(url, "://");
+    const char *end = schemeEnd != nullptr ? schemeEnd + 3 : url;
+
+    while (*end != '\0' && *end != '/' && *end != '?' && *end != '#')
+    {
+        end++;
+    }
+
+    return String(url).substring(0, end - url);
+}
@@ -0,0 +1,128 @@
+/**
+ * expLORA Gateway Lite
+ *
+ * HTTP forwarding queue header file
+ *
+ * Copyright Pajenicko s.r.o., Igor Sverma (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <HTTPClient.h>
+#include <WiFiClient.h>
+#include <WiFiClientSecure.h>
+#include <atomic>
+#include <mutex>
+#include "../config.h"
+#include "../Data/Logging.h"
+
+/**
+ * Asynchronous forwarding of sensor data to custom URLs
+ *
+ * SensorManager enqueues the finished URL and returns immediately, a worker
+ * task sends the requests. At most one job per sensor is pending - a newer
+ * reading replaces the queued one, and jobs older than HTTP_FORWARD_MAX_AGE
+ * are dropped. The connection is kept alive between requests to the same host,
+ * hosts that fail are skipped with exponential backoff.
+ */
+class HttpForwarder
+{
+private:
+    // Pending request for one sensor
+    struct Job
+    {
+        bool pending;
+        uint32_t serialNumber; // Sensor the job belongs to (coalescing key)
+        uint32_t sequence;     // Enqueue order
+        int64_t queuedAt;      // esp_timer_get_time() when (re)queued
+        char url[HTTP_FORWARD_URL_SIZE];
+    };
+
+    // Backoff state of one host (worker task only)
+    struct HostState
+    {
+        String host;            // "scheme://authority"
+        uint32_t failures;      // Consecutive failures
+        unsigned long retryAt;  // millis() when requests are allowed again
+        unsigned long lastUsed; // millis() of last request, for slot reuse
+    };
+
+    Job jobs[HTTP_FORWARD_QUEUE_SIZE];
+    std::mutex jobMutex; // Protects jobs and nextSequence
+    uint32_t nextSequence;
+
+    HostState hosts[HTTP_FORWARD_HOST_COUNT];
+
+    // Connection reused between requests (worker task only)
+    WiFiClient client;
+    WiFiClientSecure secureClient;
+    HTTPClient http;
+    String connectedHost; // Host of kept-alive connection, empty if none
+
+    Logger &logger;
+    TaskHandle_t workerTaskHandle;
+
+    // Statistics
+    std::atomic<uint32_t> queueDepth;
+    std::atomic<uint32_t> maxQueueDepth;
+    std::atomic<uint32_t> queuedJobs;
+    std::atomic<uint32_t> coalescedJobs;
+    std::atomic<uint32_t> droppedJobs;
+    std::atomic<uint32_t> staleJobs;
+    std::atomic<uint32_t> sentRequests;
+    std::atomic<uint32_t> failedRequests;
+    std::atomic<uint32_t> backoffSkips;
+
+    // Worker task - sends queued requests whenever WiFi is connected
+    static void workerTask(void *parameter);
+
+    // Remove oldest pending job, false if queue is empty
+    bool takeJob(Job &job);
+
+    // Send one request
+    void sendJob(const Job &job);
+
+    // Backoff state of host, a slot of the least recently used host is recycled
+    HostState &getHostState(const String &host);
+
+    // Close kept-alive connection
+    void closeConnection();
+
+    // Scheme and authority part of URL
+    static String hostOf(const char *url);
+
+public:
+    // Constructor
+    HttpForwarder(Logger &log);
+
+    // Start worker task
+    bool start();
+
+    // Queue request for sensor, replaces a pending request of the same sensor
+    bool enqueue(uint32_t serialNumber, const char *url);
+
+    // Statistics
+    uint32_t getQueueDepth() const { return queueDepth.load(); }
+    uint32_t getMaxQueueDepth() const { return maxQueueDepth.load(); }
+    uint32_t getQueuedJobs() const { return queuedJobs.load(); }
+    uint32_t getCoalescedJobs() const { return coalescedJobs.load(); }
+    uint32_t getDroppedJobs() const { return droppedJobs.load(); }
+    uint32_t getStaleJobs() const { return staleJobs.load(); }
+    uint32_t getSentRequests() const { return sentRequests.load(); }
+    uint32_t getFailedRequests() const { return failedRequests.load(); }
+    uint32_t getBackoffSkips() const { return backoffSkips.load(); }
+};
@@ -20,10 +20,12 @@
  */
 
 #include "LoRaProtocol.h"
+#include <esp_timer.h>
 
 // Constructor
-LoRaProtocol::LoRaProtocol(LoRaModule &module, SensorManager &manager, Logger &log)
-    : loraModule(module), sensorManager(manager), logger(log), lastProcessedSensorIndex(-1)
+LoRaProtocol::LoRaProtocol(RadioInterface &radioModule, SensorManager &manager, Logger &log)
+    : radio(radioModule), sensorManager(manager), logger(log), lastProcessedSensorIndex(-1),
+      lastFrameTimestamp(0), decodeTaskHandle(NULL), processedQueue(NULL), droppedUpdates(0)
 {
 }
 
@@ -33,40 +35,109 @@ LoRaProtocol::~LoRaProtocol()
     // Nothing specific to release
 }
 
-// Process received packet
-bool LoRaProtocol::processReceivedPacket()
+// Start decode task consuming frames queued by the LoRa receive task
+bool LoRaProtocol::startDecodeTask()
 {
-    yield();
-    // Check if data was received
-    if (!loraModule.hasInterrupt())
+    if (decodeTaskHandle != NULL)
+    {
+        return true;
+    }
+
+    processedQueue = xQueueCreate(LORA_RX_RING_SIZE * 2, sizeof(ProcessedSensor));
+    if (processedQueue == NULL)
     {
+        logger.error("Failed to create processed sensor queue");
         return false;
     }
 
-    // Reset interrupt flag
-    loraModule.clearInterrupt();
+    BaseType_t result = xTaskCreatePinnedToCore(
+        decodeTask,                // Task function
+        "LoRaDecodeTask",          // Task name
+        LORA_DECODE_TASK_STACK,    // Stack size (bytes)
+        this,                      // Parameter to pass
+        LORA_DECODE_TASK_PRIORITY, // Task priority
+        &decodeTaskHandle,         // Task handle
+        LORA_TASK_CORE             // Core
+    );
 
-    // Attempt to receive packet
-    uint8_t length = 0;
-    if (!loraModule.receivePacket(packetBuffer, &length))
+    if (result != pdPASS)
     {
-        logger.warning("Failed to receive packet from LoRa module");
+        logger.error("Failed to create LoRa decode task");
+        decodeTaskHandle = NULL;
         return false;
     }
 
-    // Log received packet in hexadecimal format
-    String hexData = "Received data (HEX): ";
-    for (uint8_t i = 0; i < length; i++)
+    radio.setFrameConsumer(decodeTaskHandle);
+    logger.info("LoRa decode task started on core " + String(LORA_TASK_CORE));
+    return true;
+}
+
+// Decode task - processes all queued frames whenever receive task signals new data
+void LoRaProtocol::decodeTask(void *parameter)
+{
+    LoRaProtocol *protocol = (LoRaProtocol *)parameter;
+
+    for (;;)
     {
-        if (packetBuffer[i] < 0x10)
-            hexData += "0";
-        hexData += String(packetBuffer[i], HEX) + " ";
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        while (protocol->radio.getQueuedFrames() > 0)
+        {
+            if (protocol->processReceivedPacket())
+            {
+                // Hand sensor over to main loop for MQTT publishing
+                ProcessedSensor processed;
+                processed.sensorIndex = protocol->lastProcessedSensorIndex;
+                processed.receivedAt = protocol->lastFrameTimestamp;
+                processed.queuedAt = esp_timer_get_time();
+                if (xQueueSend(protocol->processedQueue, &processed, 0) != pdTRUE)
+                {
+                    // Main loop is stalled - readings are stored, only this MQTT publish is lost
+                    protocol->droppedUpdates++;
+                    LOGF_WARNING("Processed sensor queue full, update of sensor %d not published (%lu total)",
+                                 processed.sensorIndex, (unsigned long)protocol->droppedUpdates.load());
+                }
+            }
+        }
+    }
+}
+
+// Get next sensor updated by decode task
+bool LoRaProtocol::getProcessedSensor(ProcessedSensor &processed)
+{
+    if (processedQueue == NULL)
+    {
+        return false;
     }
-    logger.debug(hexData);
+    return xQueueReceive(processedQueue, &processed, 0) == pdTRUE;
+}
 
-    // Get RSSI for diagnostics
-    int rssi = loraModule.getRSSI();
-    logger.debug("RSSI: " + String(rssi) + " dBm, SNR: " + String(loraModule.getSNR()) + " dB");
+// Process received packet
+bool LoRaProtocol::processReceivedPacket()
+{
+    // Take oldest frame from receive queue
+    LoRaFrame *frame = radio.peekFrame();
+    if (frame == nullptr)
+    {
+        return false;
+    }
+
+    // Copy packet out so that the ring slot is returned to the receive task right away
+    uint8_t length = frame->length;
+    int rssi = frame->rssi;
+    float snr = frame->snr;
+    int64_t receivedAt = frame->timestamp;
+    memcpy(packetBuffer, frame->data, length);
+    radio.releaseFrame();
+
+    int64_t decodeStart = esp_timer_get_time();
+    PacketLatency::record(LatencyStage::RADIO, receivedAt, decodeStart);
+
+    // Log received packet in hexadecimal format
+    LOGF_HEX(DEBUG, "Received data (HEX): ", packetBuffer, length);
+
+    // RSSI for diagnostics
+    LOGF_DEBUG("RSSI: %d dBm, SNR: %.2f dB", rssi, snr);
 
     // Attempt to decrypt packet
     int sensorIndex = tryDecryptWithAllKeys(packetBuffer, length, decryptedBuffer);
@@ -74,26 +145,14 @@ bool LoRaProtocol::processReceivedPacket()
     // If no known sensor is found
     if (sensorIndex < 0)
     {
-        logger.debug("Unknown sensor detected - cannot process packet");
+        LOGF_DEBUG("Unknown sensor detected - cannot process packet");
         return false;
     }
 
     // Log decrypted data
-    hexData = "Decrypted data (HEX): ";
-    for (uint8_t i = 0; i < length; i++)
-    {
-        if (decryptedBuffer[i] < 0x10)
-            hexData += "0";
-        hexData += String(decryptedBuffer[i], HEX) + " ";
-    }
-    logger.debug(hexData);
+    LOGF_HEX(DEBUG, "Decrypted data (HEX): ", decryptedBuffer, length);
 
-    // Check checksum
-    if (!validateChecksum(decryptedBuffer, length))
-    {
-        logger.warning("Invalid checksum in received packet - data corrupted");
-        return false;
-    }
+    // Checksum was already verified during decryption in tryDecryptWithAllKeys
 
     // Check packet validity
     if (!isValidPacket(decryptedBuffer, length))
@@ -106,6 +165,8 @@ bool LoRaProtocol::processReceivedPacket()
     SensorType deviceType = static_cast<SensorType>(decryptedBuffer[1]);
 
     lastProcessedSensorIndex = sensorIndex;
+    lastFrameTimestamp = receivedAt;
+    PacketLatency::record(LatencyStage::DECODE, decodeStart, esp_timer_get_time());
 
     // Process packet according to sensor type
     return processPacketByType(deviceType, decryptedBuffer, length, sensorIndex, rssi);
@@ -149,36 +210,28 @@ bool LoRaProtocol::processBME280Packet(uint8_t *data, uint8_t len, int sensorInd
 
     // Extract common data
     uint32_t serialNumber = ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 8) | data[4];
-    uint16_t batteryRaw = ((uint16_t)data[5] << 8) | data[6];
-    float voltage = batteryRaw / 1000.0;
+    uint16_t batteryMillivolts = ((uint16_t)data[5] << 8) | data[6];
 
     // Extract data specific to BME280
-    int16_t tempRaw = (int16_t)(((uint16_t)data[8] << 8) | data[9]);
-    float temp = tempRaw / 100.0;
+    int16_t temperatureCenti = (int16_t)(((uint16_t)data[8] << 8) | data[9]);
 
-    uint16_t pressRaw = ((uint16_t)data[10] << 8) | data[11];
-    float press = pressRaw / 10.0;
+    uint16_t pressureDeci = ((uint16_t)data[10] << 8) | data[11];
 
-    uint16_t humRaw = ((uint16_t)data[12] << 8) | data[13];
-    float hum = humRaw / 100.0;
+    uint16_t humidityCenti = ((uint16_t)data[12] << 8) | data[13];
 
     // Update sensor data
-    SensorData *sensor = sensorManager.getSensor(sensorIndex);
-    if (!sensor)
-    {
-        logger.error("Error accessing sensor data at index " + String(sensorIndex));
-        return false;
-    }
-
-    // Update data with adjusted pressure
-    bool result = sensorManager.updateSensorData(sensorIndex, temp, hum, press,
-                                                 0.0f, 0.0f, voltage, rssi);
+    bool result = sensorManager.updateSensorData(sensorIndex, temperatureCenti, humidityCenti, pressureDeci,
+                                                 0, 0, batteryMillivolts, rssi);
 
-    if (result)
+    // Read back values with corrections applied
+    SensorView sensor = sensorManager.getSensor(sensorIndex);
+    if (result && sensor)
     {
-        logger.info(sensor->name + " data updated - Temp: " + String(sensor->temperature, 2) + "°C, Hum: " +
-                    String(sensor->humidity, 2) + "%, Press: " + String(sensor->pressure, 2) + " hPa, Batt: " +
-                    String(voltage, 2) + "V");
+        LOGF_INFO("%s data updated - Temp: %s°C, Hum: %s%%, Press: %s hPa, Batt: %sV", sensor.config().name.c_str(),
+                  FixedPoint::Text(sensor->temperatureCenti, 2, 2).c_str(),
+                  FixedPoint::Text(sensor->humidityCenti, 2, 2).c_str(),
+                  FixedPoint::Text(sensor->pressureDeci, 1, 1).c_str(),
+                  FixedPoint::Text(sensor->batteryMillivolts, 3, 2).c_str());
     }
 
     return result;
@@ -195,27 +248,25 @@ bool LoRaProtocol::processDIYTempPacket(uint8_t *data, uint8_t len, int sensorIn
     
     // Extrakce společných údajů
     uint32_t serialNumber = ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 8) | data[4];
-    uint16_t batteryRaw = ((uint16_t)data[5] << 8) | data[6];
-    float voltage = batteryRaw / 1000.0;
+    uint16_t batteryMillivolts = ((uint16_t)data[5] << 8) | data[6];
     
     // Extrakce dat specifických pro DS18B20
-    int16_t tempRaw = (int16_t)(((uint16_t)data[8] << 8) | data[9]);
-    float temp = tempRaw / 100.0;
+    int16_t temperatureCenti = (int16_t)(((uint16_t)data[8] << 8) | data[9]);
     
     // Aktualizace dat senzoru
-    SensorData* sensor = sensorManager.getSensor(sensorIndex);
+    SensorView sensor = sensorManager.getSensor(sensorIndex);
     if (!sensor) {
         logger.error("Error accessing sensor data at index " + String(sensorIndex));
         return false;
     }
     
     // Aktualizace dat
-    bool result = sensorManager.updateSensorData(sensorIndex, temp, 0.0f, 0.0f, 
-                                            0.0f, 0.0f, voltage, rssi);
+    bool result = sensorManager.updateSensorData(sensorIndex, temperatureCenti, 0, 0,
+                                            0, 0, batteryMillivolts, rssi);
     
     if (result) {
-        logger.info(sensor->name + " data updated - Temp: " + String(temp, 2) + "°C, Batt: " + 
-                  String(voltage, 2) + "V");
+        LOGF_INFO("%s data updated - Temp: %s°C, Batt: %sV", sensor.config().name.c_str(),
+                  FixedPoint::Text(temperatureCenti, 2, 2).c_str(), FixedPoint::Text(batteryMillivolts, 3, 2).c_str());
     }
     
     return result;
@@ -234,35 +285,27 @@ bool LoRaProtocol::processSCD40Packet(uint8_t *data, uint8_t len, int sensorInde
 
     // Extract common data
     uint32_t serialNumber = ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 8) | data[4];
-    uint16_t batteryRaw = ((uint16_t)data[5] << 8) | data[6];
-    float voltage = batteryRaw / 1000.0;
+    uint16_t batteryMillivolts = ((uint16_t)data[5] << 8) | data[6];
 
     // Extract data specific to SCD40
-    int16_t tempRaw = (int16_t)(((uint16_t)data[8] << 8) | data[9]);
-    float temp = tempRaw / 100.0;
+    int16_t temperatureCenti = (int16_t)(((uint16_t)data[8] << 8) | data[9]);
 
-    uint16_t ppmRaw = ((uint16_t)data[10] << 8) | data[11];
-    float ppm = ppmRaw;
+    uint16_t co2Ppm = ((uint16_t)data[10] << 8) | data[11];
 
-    uint16_t humRaw = ((uint16_t)data[12] << 8) | data[13];
-    float hum = humRaw / 100.0;
+    uint16_t humidityCenti = ((uint16_t)data[12] << 8) | data[13];
 
     // Update sensor data
-    SensorData *sensor = sensorManager.getSensor(sensorIndex);
-    if (!sensor)
-    {
-        logger.error("Error accessing sensor data at index " + String(sensorIndex));
-        return false;
-    }
-
-    // Update data
-    bool result = sensorManager.updateSensorData(sensorIndex, temp, hum, 0.0f, ppm, 0.0f, voltage, rssi);
+    bool result = sensorManager.updateSensorData(sensorIndex, temperatureCenti, humidityCenti, 0, co2Ppm, 0,
+                                                 batteryMillivolts, rssi);
 
-    if (result)
+    // Read back values with corrections applied
+    SensorView sensor = sensorManager.getSensor(sensorIndex);
+    if (result && sensor)
     {
-        logger.info(sensor->name + " data updated - Temp: " + String(sensor->temperature, 2) + "°C, Hum: " +
-                    String(sensor->humidity, 2) + "%, CO2: " + String(sensor->ppm, 0) + " ppm, Batt: " +
-                    String(voltage, 2) + "V");
+        LOGF_INFO("%s data updated - Temp: %s°C, Hum: %s%%, CO2: %u ppm, Batt: %sV", sensor.config().name.c_str(),
+                  FixedPoint::Text(sensor->temperatureCenti, 2, 2).c_str(),
+                  FixedPoint::Text(sensor->humidityCenti, 2, 2).c_str(), (unsigned)sensor->co2Ppm,
+                  FixedPoint::Text(sensor->batteryMillivolts, 3, 2).c_str());
     }
 
     return result;
@@ -281,16 +324,15 @@ bool LoRaProtocol::processVEML7700Packet(uint8_t *data, uint8_t len, int sensorI
 
     // Extract common data
     uint32_t serialNumber = ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 8) | data[4];
-    uint16_t batteryRaw = ((uint16_t)data[5] << 8) | data[6];
-    float voltage = batteryRaw / 1000.0;
+    uint16_t batteryMillivolts = ((uint16_t)data[5] << 8) | data[6];
 
     // Extract data specific to VEML7700
     uint32_t luxRaw = ((uint32_t)data[8] << 24) | ((uint32_t)data[9] << 16) |
                       ((uint32_t)data[10] << 8) | data[11];
-    float lux = luxRaw / 100.0; // Assume lux value is in hundredths
+    uint32_t luxCenti = luxRaw; // Assume lux value is in hundredths
 
     // Update sensor data
-    SensorData *sensor = sensorManager.getSensor(sensorIndex);
+    SensorView sensor = sensorManager.getSensor(sensorIndex);
     if (!sensor)
     {
         logger.error("Error accessing sensor data at index " + String(sensorIndex));
@@ -298,12 +340,12 @@ bool LoRaProtocol::processVEML7700Packet(uint8_t *data, uint8_t len, int sensorI
     }
 
     // Update data
-    bool result = sensorManager.updateSensorData(sensorIndex, 0.0f, 0.0f, 0.0f, 0.0f, lux, voltage, rssi);
+    bool result = sensorManager.updateSensorData(sensorIndex, 0, 0, 0, 0, luxCenti, batteryMillivolts, rssi);
 
     if (result)
     {
-        logger.info(sensor->name + " data updated - Light: " + String(lux, 1) + " lux, Batt: " +
-                    String(voltage, 2) + "V");
+        LOGF_INFO("%s data updated - Light: %s lux, Batt: %sV", sensor.config().name.c_str(),
+                  FixedPoint::Text(luxCenti, 2, 1).c_str(), FixedPoint::Text(batteryMillivolts, 3, 2).c_str());
     }
 
     return result;
@@ -320,65 +362,61 @@ bool LoRaProtocol::processMeteoPacket(uint8_t *data, uint8_t len, int sensorInde
 
     // Extract common data
     uint32_t serialNumber = ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 8) | data[4];
-    uint16_t batteryRaw = ((uint16_t)data[5] << 8) | data[6];
-    float voltage = batteryRaw / 1000.0; // mV to V
+    uint16_t batteryMillivolts = ((uint16_t)data[5] << 8) | data[6];
 
     // Debug output
-    logger.debug("METEO packet: SN=" + String(serialNumber, HEX) +
-                 ", battery=" + String(voltage) + "V, values=" + String(data[7]));
+    LOGF_DEBUG("METEO packet: SN=%lx, battery=%sV, values=%u", (unsigned long)serialNumber,
+               FixedPoint::Text(batteryMillivolts, 3, 2).c_str(), data[7]);
 
     // Extract data specific to METEO
-    int16_t tempRaw = (int16_t)(((uint16_t)data[8] << 8) | data[9]);
-    float temp = tempRaw / 100.0; // hundredths °C to °C
+    int16_t temperatureCenti = (int16_t)(((uint16_t)data[8] << 8) | data[9]); // hundredths °C
 
-    uint16_t pressRaw = ((uint16_t)data[10] << 8) | data[11];
-    float press = pressRaw / 10.0; // tenths hPa to hPa
+    uint16_t pressureDeci = ((uint16_t)data[10] << 8) | data[11]; // tenths hPa
 
-    uint16_t humRaw = ((uint16_t)data[12] << 8) | data[13];
-    float hum = humRaw / 100.0; // hundredths % to %
+    uint16_t humidityCenti = ((uint16_t)data[12] << 8) | data[13]; // hundredths %
 
     // Extract meteorological data
     uint16_t windSpeedRaw = ((uint16_t)data[14] << 8) | data[15];
-    float windSpeed = windSpeedRaw * 0.111111f; // convert to true m/s with correction
+    uint32_t windSpeedCenti = ((uint32_t)windSpeedRaw * 100 + 4) / 9; // true m/s is raw / 9
 
     uint16_t windDirection = ((uint16_t)data[16] << 8) | data[17];
 
     uint16_t rainAmountRaw = ((uint16_t)data[18] << 8) | data[19];
-    float rainAmount = rainAmountRaw / 5000.0f; // to mm
+    uint32_t rainAmountTenthMilli = (uint32_t)rainAmountRaw * 2; // raw is 1/5000 mm, kept exactly
 
-    float rainRate = 0.0f;
+    uint32_t rainRateMilli = 0;
     // If we have an extended packet, read rain intensity
     if (len >= 23)
     {
         uint16_t rainRateRaw = ((uint16_t)data[20] << 8) | data[21];
-        rainRate = rainRateRaw / 500.0; // to mm/h
+        rainRateMilli = (uint32_t)rainRateRaw * 2; // raw is 1/500 mm/h
     }
 
     // Debug log of all values
-    logger.debug("METEO values: temp=" + String(temp) + "°C, press=" + String(press) +
-                 "hPa, hum=" + String(hum) + "%, wind=" + String(windSpeed) +
-                 "m/s at " + String(windDirection) + "°, rain=" + String(rainAmount) +
-                 "mm, rate=" + String(rainRate) + "mm/h");
+    LOGF_DEBUG("METEO values: temp=%s°C, press=%shPa, hum=%s%%, wind=%sm/s at %u°, rain=%smm, rate=%smm/h",
+               FixedPoint::Text(temperatureCenti, 2, 2).c_str(), FixedPoint::Text(pressureDeci, 1, 1).c_str(),
+               FixedPoint::Text(humidityCenti, 2, 2).c_str(), FixedPoint::Text(windSpeedCenti, 2, 2).c_str(),
+               windDirection, FixedPoint::Text(rainAmountTenthMilli, 4, 4).c_str(),
+               FixedPoint::Text(rainRateMilli, 3, 3).c_str());
 
     // Update sensor data
-    SensorData *sensor = sensorManager.getSensor(sensorIndex);
-    if (!sensor)
-    {
-        logger.error("Error accessing sensor data at index " + String(sensorIndex));
-        return false;
-    }
+    bool result = sensorManager.updateSensorData(sensorIndex, temperatureCenti, humidityCenti, pressureDeci, 0, 0,
+                                                 batteryMillivolts, rssi, windSpeedCenti, windDirection,
+                                                 rainAmountTenthMilli, rainRateMilli);
 
-    // Update basic data
-    bool result = sensorManager.updateSensorData(sensorIndex, temp, hum, press, 0.0f, 0.0f, voltage, rssi,
-                                                 windSpeed, windDirection, rainAmount, rainRate);
-
-    if (result)
+    // Read back values with corrections applied
+    SensorView sensor = sensorManager.getSensor(sensorIndex);
+    if (result && sensor)
     {
-        logger.info(sensor->name + " data updated - Temp: " + String(sensor->temperature, 2) + "°C, Hum: " +
-                    String(sensor->humidity, 2) + "%, Press: " + String(sensor->pressure, 2) + " hPa, Wind: " +
-                    String(sensor->windSpeed, 1) + " m/s at " + String(sensor->windDirection) + "°, Rain: " +
-                    String(sensor->rainAmount, 1) + " mm (rate: " + String(sensor->rainRate, 1) + " mm/h), Batt: " +
-                    String(voltage, 2) + "V");
+        LOGF_INFO("%s data updated - Temp: %s°C, Hum: %s%%, Press: %s hPa, Wind: %s m/s at %u°, "
+                  "Rain: %s mm (rate: %s mm/h), Batt: %sV",
+                  sensor.config().name.c_str(), FixedPoint::Text(sensor->temperatureCenti, 2, 2).c_str(),
+                  FixedPoint::Text(sensor->humidityCenti, 2, 2).c_str(),
+                  FixedPoint::Text(sensor->pressureDeci, 1, 1).c_str(),
+                  FixedPoint::Text(sensor->windSpeedCenti, 2, 1).c_str(), sensor->windDirection,
+                  FixedPoint::Text(sensor->rainAmountTenthMilli, 4, 1).c_str(),
+                  FixedPoint::Text(sensor->rainRateMilli, 3, 1).c_str(),
+                  FixedPoint::Text(sensor->batteryMillivolts, 3, 2).c_str());
     }
 
     return result;
@@ -402,83 +440,137 @@ void LoRaProtocol::decryptData(uint8_t *data, uint8_t data_len, uint32_t key)
     }
 }
 
-// Try decryption with all known keys
-int LoRaProtocol::tryDecryptWithAllKeys(uint8_t *encData, uint8_t len, uint8_t *decData)
+// Encrypt data with key
+void LoRaProtocol::encryptData(uint8_t *data, uint8_t data_len, uint32_t key)
 {
-    // Get list of all active sensors
-    std::vector<SensorData> activeSensors = sensorManager.getActiveSensors();
+    uint8_t *key_bytes = (uint8_t *)&key;
+    uint8_t prev_byte = 0; // Start from zero
 
-    // Go through all sensors and try to decrypt
-    for (size_t i = 0; i < activeSensors.size(); i++)
+    for (uint8_t i = 0; i < data_len; i++)
     {
-        // Copy encrypted data
-        memcpy(decData, encData, len);
-
-        // Try to decrypt with this sensor's key
-        decryptData(decData, len, activeSensors[i].deviceKey);
+        uint8_t key_byte = key_bytes[i & 0x03];
+        // Rolling byte is the previous encrypted byte, as seen by decryptData
+        data[i] = data[i] ^ key_byte ^ (prev_byte >> 1);
+        prev_byte = data[i];
+    }
+}
 
-        // Verify checksum
-        if (validateChecksum(decData, len))
-        {
-            // Verify that serial number in decrypted data matches the sensor
-            uint32_t packetSN = ((uint32_t)decData[2] << 16) | ((uint32_t)decData[3] << 8) | decData[4];
+// Decrypt packet and verify serial number and checksum in a single pass
+// Bytes are decrypted the same way as in decryptData(), but the header is checked
+// first and the rest is processed in 32-bit words. The checksum byte is decrypted too,
+// so XOR of all decrypted bytes is zero for a valid packet.
+bool LoRaProtocol::decryptAndVerify(const uint8_t *encData, uint8_t len, uint32_t key,
+                                    uint32_t serialNumber, uint8_t *decData)
+{
+    // Header with serial number and at least one checksum byte
+    if (len < 6)
+    {
+        return false;
+    }
 
-            if (packetSN == activeSensors[i].serialNumber)
-            {
-                // We found a match, return sensor index
-                logger.debug("Packet successfully decrypted with key from sensor " +
-                             activeSensors[i].name + " (SN: " + String(activeSensors[i].serialNumber, HEX) + ")");
+    uint8_t *key_bytes = (uint8_t *)&key;
+    uint8_t checksum = 0;
+    uint8_t i = 0;
 
-                // Return sensor index in global array
-                return sensorManager.findSensorBySN(activeSensors[i].serialNumber);
-            }
-        }
+    // Decrypt header bytes and reject early on serial number mismatch
+    for (; i < 5; i++)
+    {
+        decData[i] = encData[i] ^ key_bytes[i & 0x03] ^ (i > 0 ? encData[i - 1] >> 1 : 0);
+        checksum ^= decData[i];
     }
 
-    // If we didn't find a match, try to decrypt with any key for unknown sensor detection
-    if (!activeSensors.empty())
+    uint32_t packetSN = ((uint32_t)decData[2] << 16) | ((uint32_t)decData[3] << 8) | decData[4];
+    if (packetSN != serialNumber)
     {
-        // Use key from first sensor
-        memcpy(decData, encData, len);
-        decryptData(decData, len, activeSensors[0].deviceKey);
+        return false;
     }
-    else
+
+    // Decrypt up to the next key-aligned word
+    for (; i < 8 && i < len; i++)
     {
-        // We don't have any keys, just copy data
-        memcpy(decData, encData, len);
+        decData[i] = encData[i] ^ key_bytes[i & 0x03] ^ (encData[i - 1] >> 1);
+        checksum ^= decData[i];
     }
 
-    return -1; // No sensor found
-}
+    // Decrypt 4 bytes at a time - the rolling term of each byte is the previous
+    // ciphertext byte, so load the word shifted by one and halve every byte lane
+    uint32_t wordChecksum = 0;
+    for (; i + 4 <= len; i += 4)
+    {
+        uint32_t current, previous;
+        memcpy(&current, encData + i, 4);
+        memcpy(&previous, encData + i - 1, 4);
 
-// Validate checksum
-bool LoRaProtocol::validateChecksum(uint8_t *buf, uint8_t len)
-{
-    // Check minimum packet length
-    if (len < 2)
+        uint32_t decrypted = current ^ key ^ ((previous >> 1) & 0x7F7F7F7F);
+        memcpy(decData + i, &decrypted, 4);
+        wordChecksum ^= decrypted;
+    }
+
+    // Remaining bytes
+    for (; i < len; i++)
     {
-        return false;
+        decData[i] = encData[i] ^ key_bytes[i & 0x03] ^ (encData[i - 1] >> 1);
+        checksum ^= decData[i];
     }
 
-    // Last byte is checksum of all previous bytes
-    uint8_t receivedChecksum = buf[len - 1];
+    // Fold word lanes into the byte checksum
+    checksum ^= (uint8_t)(wordChecksum ^ (wordChecksum >> 8) ^ (wordChecksum >> 16) ^ (wordChecksum >> 24));
 
-    // Calculate checksum of data (without checksum)
-    uint8_t calculatedChecksum = calculateChecksum(buf, len - 1);
+    return checksum == 0;
+}
 
-    // Return true if checksums match
-    return (receivedChecksum == calculatedChecksum);
+// Compute key tag of encrypted packet
+// Serial number byte i (2..4) decrypts as enc[i] ^ key[i & 3] ^ (enc[i - 1] >> 1),
+// so removing the rolling term leaves SN ^ key bytes - the sensor's key tag.
+uint32_t LoRaProtocol::computePacketKeyTag(const uint8_t *encData)
+{
+    return ((uint32_t)(encData[2] ^ (encData[1] >> 1)) << 16) |
+           ((uint32_t)(encData[3] ^ (encData[2] >> 1)) << 8) |
+           (encData[4] ^ (encData[3] >> 1));
 }
 
-// Calculate checksum (simple XOR of all bytes)
-uint8_t LoRaProtocol::calculateChecksum(const uint8_t *data, uint8_t length)
+// Try decryption with all known keys
+int LoRaProtocol::tryDecryptWithAllKeys(uint8_t *encData, uint8_t len, uint8_t *decData)
 {
-    uint8_t checksum = 0;
-    for (uint8_t i = 0; i < length; i++)
+    // Packet must contain at least header with serial number
+    if (len < 5)
     {
-        checksum ^= data[i];
+        memcpy(decData, encData, len);
+        return -1;
+    }
+
+    // Look up only sensors whose key tag matches this packet. The tag is the serial number
+    // the header decrypts to, so foreign packets end here after one index lookup and only
+    // our own (possibly corrupted) packets reach the checksum.
+    int candidateIndices[MAX_KEY_CANDIDATES];
+    uint32_t candidateKeys[MAX_KEY_CANDIDATES];
+    size_t candidateCount = sensorManager.findSensorsByKeyTag(computePacketKeyTag(encData),
+                                                              candidateIndices, candidateKeys,
+                                                              MAX_KEY_CANDIDATES);
+
+    for (size_t i = 0; i < candidateCount; i++)
+    {
+        SensorView sensor = sensorManager.getSensor(candidateIndices[i]);
+        if (!sensor)
+        {
+            continue;
+        }
+
+        // Decrypt with this sensor's key, verifying serial number and checksum
+        if (decryptAndVerify(encData, len, candidateKeys[i], sensor->serialNumber, decData))
+        {
+            // We found a match, return sensor index
+            LOGF_DEBUG("Packet successfully decrypted with key from sensor %s (SN: %lx)", sensor.config().name.c_str(),
+                       (unsigned long)sensor->serialNumber);
+
+            return candidateIndices[i];
+        }
     }
-    return checksum;
+
+    // No sensor matched, leave raw data in output buffer
+    memcpy(decData, encData, len);
+
+    return -1; // No sensor found
 }
 
 // Check packet validity
@@ -511,7 +603,7 @@ bool LoRaProtocol::isValidPacket(uint8_t *buf, uint8_t len)
         // If length is 23 but numValues is 6, adjust expected value count
         if (len == 23 && numValues == 6)
         {
-            logger.info("Detected extended METEO packet with 7 values (including rain rate)");
+            LOGF_INFO("Detected extended METEO packet with 7 values (including rain rate)");
             // Note: We don't change numValues in the packet because it would change the checksum
         }
     }
@@ -22,9 +22,19 @@
 #pragma once
 
 #include <Arduino.h>
-#include "../Hardware/LoRa_Module.h"
+#include <atomic>
+#include "../Hardware/RadioInterface.h"
 #include "../Data/SensorManager.h"
 #include "../Data/Logging.h"
+#include "../Data/PacketLatency.h"
+
+// Sensor updated by decode task, waiting for MQTT publishing
+struct ProcessedSensor
+{
+    int sensorIndex;    // Index of updated sensor
+    int64_t receivedAt; // DIO0 interrupt time of the frame (us)
+    int64_t queuedAt;   // Time of hand-over to main loop (us)
+};
 
 /**
  * Class for LoRa protocol processing
@@ -35,13 +45,16 @@
 class LoRaProtocol
 {
 private:
-    LoRaModule &loraModule;       // Reference to LoRa module
+    RadioInterface &radio;        // Reference to radio (LoRa module or simulator)
     SensorManager &sensorManager; // Reference to sensor manager
     Logger &logger;               // Reference to logger
 
     // Maximum packet length
     static const size_t MAX_PACKET_LENGTH = 256;
 
+    // Maximum number of sensors sharing one key tag that are tried per packet
+    static const size_t MAX_KEY_CANDIDATES = 4;
+
     // Buffer for received packet
     uint8_t packetBuffer[MAX_PACKET_LENGTH];
     uint8_t decryptedBuffer[MAX_PACKET_LENGTH];
@@ -54,12 +67,14 @@ private:
     bool processDIYTempPacket(uint8_t *data, uint8_t len, int sensorIndex, int rssi);
 
     int lastProcessedSensorIndex; // Index of last processed sensor
+    int64_t lastFrameTimestamp;   // Receive time of last processed frame
 
-    // Validate checksum
-    bool validateChecksum(uint8_t *buf, uint8_t len);
+    TaskHandle_t decodeTaskHandle; // Task decoding frames from receive queue
+    QueueHandle_t processedQueue;  // Updated sensors for main loop (ProcessedSensor)
+    std::atomic<uint32_t> droppedUpdates; // Updated sensors not handed to main loop (queue full)
 
-    // Calculate checksum
-    uint8_t calculateChecksum(const uint8_t *data, uint8_t length);
+    // Decode task function
+    static void decodeTask(void *parameter);
 
     // Check packet validity
     bool isValidPacket(uint8_t *buf, uint8_t len);
@@ -69,20 +84,43 @@ private:
 
 public:
     // Constructor
-    LoRaProtocol(LoRaModule &module, SensorManager &manager, Logger &log);
+    LoRaProtocol(RadioInterface &radioModule, SensorManager &manager, Logger &log);
 
     // Destructor
     ~LoRaProtocol();
 
-    // Process received packet
+    // Process oldest packet from receive queue
     bool processReceivedPacket();
 
+    // Start task decoding packets queued by LoRa receive task
+    bool startDecodeTask();
+
+    // Get next sensor updated by decode task (non-blocking)
+    bool getProcessedSensor(ProcessedSensor &processed);
+
     // Decrypt data with key
     void decryptData(uint8_t *data, uint8_t data_len, uint32_t key);
 
+    // Encrypt data with key (inverse of decryptData, used to emulate sensors)
+    static void encryptData(uint8_t *data, uint8_t data_len, uint32_t key);
+
+    // Decrypt packet and verify serial number and checksum in a single pass,
+    // rejects after the 5 header bytes if serial number does not match
+    static bool decryptAndVerify(const uint8_t *encData, uint8_t len, uint32_t key,
+                                 uint32_t serialNumber, uint8_t *decData);
+
     // Try decryption with all known keys
     int tryDecryptWithAllKeys(uint8_t *encData, uint8_t len, uint8_t *decData);
 
+    // Compute key tag of encrypted packet, see SensorManager::computeKeyTag()
+    static uint32_t computePacketKeyTag(const uint8_t *encData);
+
     // Getter for lastProcessedSensorIndex
     int getLastProcessedSensorIndex() const { return lastProcessedSensorIndex; }
+
+    // Statistics - frames waiting in / dropped from the radio receive ring, and decoded
+    // sensors not published because the main loop did not take them in time
+    size_t getQueuedFrames() const { return radio.getQueuedFrames(); }
+    uint32_t getDroppedFrames() const { return radio.getDroppedFrames(); }
+    uint32_t getDroppedUpdates() const { return droppedUpdates.load(); }
 };
@@ -168,113 +168,115 @@ void MQTTManager::publishDiscovery()
 
     logger.info("Publishing Home Assistant discovery information...");
 
-    // Get all active sensors
-    std::vector<SensorData> sensors = sensorManager.getActiveSensors();
+    // Shared copy of sensors, the sensor lock is not held while publishing
+    SensorSnapshotPtr snapshot = sensorManager.getSnapshot();
 
     // Publish discovery information for each sensor
-    for (const auto &sensor : sensors)
+    for (size_t i = 0; i < snapshot->size(); i++)
     {
+        SensorView sensor = (*snapshot)[i];
+
         // Base state topic for this sensor
-        String baseTopic = String(configManager.mqttPrefix) + "/" + String(sensor.serialNumber, HEX);
+        String baseTopic = String(configManager.mqttPrefix) + "/" + String(sensor->serialNumber, HEX);
 
         // Publish discovery for each supported value type based on sensor type
-        if (sensor.hasTemperature())
+        if (sensor->hasTemperature())
         {
             String topic = buildDiscoveryTopic(sensor, "temperature");
             String payload = buildDiscoveryJson(sensor, "temperature", baseTopic + "/temperature");
             mqttClient.publish(topic.c_str(), payload.c_str(), true); // Retained message
-            logger.debug("Published temperature discovery for " + sensor.name);
+            logger.debug("Published temperature discovery for " + sensor.config().name);
         }
 
-        if (sensor.hasHumidity())
+        if (sensor->hasHumidity())
         {
             String topic = buildDiscoveryTopic(sensor, "humidity");
             String payload = buildDiscoveryJson(sensor, "humidity", baseTopic + "/humidity");
             mqttClient.publish(topic.c_str(), payload.c_str(), true);
-            logger.debug("Published humidity discovery for " + sensor.name);
+            logger.debug("Published humidity discovery for " + sensor.config().name);
         }
 
-        if (sensor.hasPressure())
+        if (sensor->hasPressure())
         {
             String topic = buildDiscoveryTopic(sensor, "pressure");
             String payload = buildDiscoveryJson(sensor, "pressure", baseTopic + "/pressure");
             mqttClient.publish(topic.c_str(), payload.c_str(), true);
-            logger.debug("Published pressure discovery for " + sensor.name);
+            logger.debug("Published pressure discovery for " + sensor.config().name);
         }
 
-        if (sensor.hasPPM())
+        if (sensor->hasPPM())
         {
             String topic = buildDiscoveryTopic(sensor, "co2");
             String payload = buildDiscoveryJson(sensor, "co2", baseTopic + "/co2");
             mqttClient.publish(topic.c_str(), payload.c_str(), true);
-            logger.debug("Published CO2 discovery for " + sensor.name);
+            logger.debug("Published CO2 discovery for " + sensor.config().name);
         }
 
-        if (sensor.hasLux())
+        if (sensor->hasLux())
         {
             String topic = buildDiscoveryTopic(sensor, "illuminance");
             String payload = buildDiscoveryJson(sensor, "illuminance", baseTopic + "/illuminance");
             mqttClient.publish(topic.c_str(), payload.c_str(), true);
-            logger.debug("Published illuminance discovery for " + sensor.name);
+            logger.debug("Published illuminance discovery for " + sensor.config().name);
         }
 
-        if (sensor.hasWindSpeed())
+        if (sensor->hasWindSpeed())
         {
             String topic = buildDiscoveryTopic(sensor, "wind_speed");
             String payload = buildDiscoveryJson(sensor, "wind_speed", baseTopic + "/wind_speed");
             mqttClient.publish(topic.c_str(), payload.c_str(), true);
-            logger.debug("Published wind speed discovery for " + sensor.name);
+            logger.debug("Published wind speed discovery for " + sensor.config().name);
         }
 
-        if (sensor.hasWindDirection())
+        if (sensor->hasWindDirection())
         {
             String topic = buildDiscoveryTopic(sensor, "wind_direction");
             String payload = buildDiscoveryJson(sensor, "wind_direction", baseTopic + "/wind_direction");
             mqttClient.publish(topic.c_str(), payload.c_str(), true);
-            logger.debug("Published wind direction discovery for " + sensor.name);
+            logger.debug("Published wind direction discovery for " + sensor.config().name);
         }
 
-        if (sensor.hasRainAmount())
+        if (sensor->hasRainAmount())
         {
             String topic = buildDiscoveryTopic(sensor, "rain_amount");
             String payload = buildDiscoveryJson(sensor, "rain_amount", baseTopic + "/rain_amount");
             mqttClient.publish(topic.c_str(), payload.c_str(), true);
-            logger.debug("Published rain amount discovery for " + sensor.name);
+            logger.debug("Published rain amount discovery for " + sensor.config().name);
 
             // Also for daily rain total
             topic = buildDiscoveryTopic(sensor, "daily_rain");
             payload = buildDiscoveryJson(sensor, "daily_rain", baseTopic + "/daily_rain");
             mqttClient.publish(topic.c_str(), payload.c_str(), true);
-            logger.debug("Published daily rain discovery for " + sensor.name);
+            logger.debug("Published daily rain discovery for " + sensor.config().name);
         }
 
-        if (sensor.hasRainRate())
+        if (sensor->hasRainRate())
         {
             String topic = buildDiscoveryTopic(sensor, "rain_rate");
             String payload = buildDiscoveryJson(sensor, "rain_rate", baseTopic + "/rain_rate");
             mqttClient.publish(topic.c_str(), payload.c_str(), true);
-            logger.debug("Published rain rate discovery for " + sensor.name);
+            logger.debug("Published rain rate discovery for " + sensor.config().name);
         }
 
         // Battery voltage - available for all sensors
         String topic = buildDiscoveryTopic(sensor, "battery");
         String payload = buildDiscoveryJson(sensor, "battery", baseTopic + "/battery");
         mqttClient.publish(topic.c_str(), payload.c_str(), true);
-        logger.debug("Published battery discovery for " + sensor.name);
+        logger.debug("Published battery discovery for " + sensor.config().name);
 
         // RSSI (signal strength) - available for all sensors
         topic = buildDiscoveryTopic(sensor, "rssi");
         payload = buildDiscoveryJson(sensor, "rssi", baseTopic + "/rssi");
         mqttClient.publish(topic.c_str(), payload.c_str(), true);
-        logger.debug("Published RSSI discovery for " + sensor.name);
+        logger.debug("Published RSSI discovery for " + sensor.config().name);
     }
 
-    logger.info("Home Assistant discovery completed for " + String(sensors.size()) + " sensors");
+    logger.info("Home Assistant discovery completed for " + String(snapshot->size()) + " sensors");
     lastDiscoveryUpdate = millis();
 }
 
 // Create discovery topic for sensor
-String MQTTManager::buildDiscoveryTopic(const SensorData &sensor, const String &valueType)
+String MQTTManager::buildDiscoveryTopic(const SensorView &sensor, const String &valueType)
 {
     String deviceClass = valueType;
 
@@ -295,7 +297,7 @@ String MQTTManager::buildDiscoveryTopic(const SensorData &sensor, const String &
 
     // Create discovery topic
     return String(configManager.mqttHAPrefix) + "/sensor/" +
-           String(configManager.mqttPrefix) + "_" + String(sensor.serialNumber, HEX) + "_" + valueType + "/config";
+           String(configManager.mqttPrefix) + "_" + String(sensor->serialNumber, HEX) + "_" + valueType + "/config";
 }
 
 // Helper function to capitalize first letter
@@ -309,18 +311,18 @@ String MQTTManager::capitalizeFirst(const String &input)
 }
 
 // Create configuration JSON for Home Assistant discovery
-String MQTTManager::buildDiscoveryJson(const SensorData &sensor, const String &valueType, const String &stateTopic)
+String MQTTManager::buildDiscoveryJson(const SensorView &sensor, const String &valueType, const String &stateTopic)
 {
     // Create JSON document for discovery payload
     DynamicJsonDocument doc(1024);
 
     // Entity name
-    // doc["name"] = sensor.name + " " + capitalizeFirst(valueType);
+    // doc["name"] = sensor.config().name + " " + capitalizeFirst(valueType);
 
     // Use the name from the sensor if it ends with the value type
-    if (sensor.name.endsWith(capitalizeFirst(valueType)))
+    if (sensor.config().name.endsWith(capitalizeFirst(valueType)))
     {
-        doc["name"] = sensor.name;
+        doc["name"] = sensor.config().name;
     }
     else
     {
@@ -334,7 +336,7 @@ String MQTTManager::buildDiscoveryJson(const SensorData &sensor, const String &v
     doc["value_template"] = "{{ value }}";
 
     // Unique ID
-    doc["unique_id"] = String(configManager.mqttPrefix) + "_" + String(sensor.serialNumber, HEX) + "_" + valueType;
+    doc["unique_id"] = String(configManager.mqttPrefix) + "_" + String(sensor->serialNumber, HEX) + "_" + valueType;
 
     // Availability topic - use LWT (Last Will and Testament)
     doc["availability_topic"] = String(configManager.mqttPrefix) + "/status";
@@ -393,7 +395,7 @@ String MQTTManager::buildDiscoveryJson(const SensorData &sensor, const String &v
         doc["device_class"] = "precipitation";
         doc["unit_of_measurement"] = "mm";
         doc["suggested_display_precision"] = 1;
-        doc["name"] = sensor.name + " Daily Rain Total";
+        doc["name"] = sensor.config().name + " Daily Rain Total";
     }
     else if (valueType == "rain_rate")
     {
@@ -415,9 +417,9 @@ String MQTTManager::buildDiscoveryJson(const SensorData &sensor, const String &v
 
     // Device information
     JsonObject device = doc.createNestedObject("device");
-    device["identifiers"] = String(sensor.serialNumber, HEX);
-    device["name"] = sensor.name;
-    device["model"] = sensor.getTypeInfo().name;
+    device["identifiers"] = String(sensor->serialNumber, HEX);
+    device["name"] = sensor.config().name;
+    device["model"] = sensor->getTypeInfo().name;
     device["manufacturer"] = "expLORA";
 
     // Serialize JSON to string
@@ -446,7 +448,7 @@ void MQTTManager::publishSensorData(int sensorIndex)
     }
 
     // Get sensor data
-    const SensorData *sensor = sensorManager.getSensor(sensorIndex);
+    SensorView sensor = sensorManager.getSensor(sensorIndex);
     if (!sensor || !sensor->configured)
     {
         return;
@@ -459,37 +461,37 @@ void MQTTManager::publishSensorData(int sensorIndex)
     if (sensor->hasTemperature())
     {
         mqttClient.publish((baseTopic + "/temperature").c_str(),
-                           String(sensor->temperature, 2).c_str());
+                           sensor->getTemperatureString().c_str());
     }
 
     if (sensor->hasHumidity())
     {
         mqttClient.publish((baseTopic + "/humidity").c_str(),
-                           String(sensor->humidity, 2).c_str());
+                           sensor->getHumidityString().c_str());
     }
 
     if (sensor->hasPressure())
     {
         mqttClient.publish((baseTopic + "/pressure").c_str(),
-                           String(sensor->pressure, 2).c_str());
+                           sensor->getPressureString().c_str());
     }
 
     if (sensor->hasPPM())
     {
         mqttClient.publish((baseTopic + "/co2").c_str(),
-                           String(int(sensor->ppm)).c_str());
+                           sensor->getPPMString().c_str());
     }
 
     if (sensor->hasLux())
     {
         mqttClient.publish((baseTopic + "/illuminance").c_str(),
-                           String(sensor->lux, 1).c_str());
+                           sensor->getLuxString().c_str());
     }
 
     if (sensor->hasWindSpeed())
     {
         mqttClient.publish((baseTopic + "/wind_speed").c_str(),
-                           String(sensor->windSpeed, 1).c_str());
+                           sensor->getWindSpeedString().c_str());
     }
 
     if (sensor->hasWindDirection())
@@ -501,26 +503,26 @@ void MQTTManager::publishSensorData(int sensorIndex)
     if (sensor->hasRainAmount())
     {
         mqttClient.publish((baseTopic + "/rain_amount").c_str(),
-                           String(sensor->rainAmount, 1).c_str());
+                           sensor->getRainAmountString().c_str());
         mqttClient.publish((baseTopic + "/daily_rain").c_str(),
-                           String(sensor->dailyRainTotal, 1).c_str());
+                           sensor->getDailyRainTotalString().c_str());
     }
 
     if (sensor->hasRainRate())
     {
         mqttClient.publish((baseTopic + "/rain_rate").c_str(),
-                           String(sensor->rainRate, 1).c_str());
+                           sensor->getRainRateString().c_str());
     }
 
     // Battery voltage - available for all sensors
     mqttClient.publish((baseTopic + "/battery").c_str(),
-                       String(sensor->batteryVoltage, 2).c_str());
+                       sensor->getBatteryVoltageString().c_str());
 
     // RSSI - available for all sensors
     mqttClient.publish((baseTopic + "/rssi").c_str(),
                        String(sensor->rssi).c_str());
 
-    logger.debug("Published MQTT data for sensor: " + sensor->name);
+    logger.debug("Published MQTT data for sensor: " + sensor.config().name);
 }
 
 void MQTTManager::publishDiscoveryForSensor(int sensorIndex)
@@ -534,13 +536,13 @@ void MQTTManager::publishDiscoveryForSensor(int sensorIndex)
         return;
     }
 
-    const SensorData *sensor = sensorManager.getSensor(sensorIndex);
+    SensorView sensor = sensorManager.getSensor(sensorIndex);
     if (!sensor || !sensor->configured)
     {
         return;
     }
 
-    logger.info("Publishing MQTT discovery for sensor: " + sensor->name);
+    logger.info("Publishing MQTT discovery for sensor: " + sensor.config().name);
 
     // Base state topic for this sensor
     String baseTopic = String(configManager.mqttPrefix) + "/" + String(sensor->serialNumber, HEX);
@@ -549,37 +551,37 @@ void MQTTManager::publishDiscoveryForSensor(int sensorIndex)
     if (sensor->hasTemperature())
     {
         mqttClient.publish((baseTopic + "/temperature").c_str(),
-                           String(sensor->temperature, 2).c_str());
+                           sensor->getTemperatureString().c_str());
     }
 
     if (sensor->hasHumidity())
     {
         mqttClient.publish((baseTopic + "/humidity").c_str(),
-                           String(sensor->humidity, 2).c_str());
+                           sensor->getHumidityString().c_str());
     }
 
     if (sensor->hasPressure())
     {
         mqttClient.publish((baseTopic + "/pressure").c_str(),
-                           String(sensor->pressure, 2).c_str());
+                           sensor->getPressureString().c_str());
     }
 
     if (sensor->hasPPM())
     {
         mqttClient.publish((baseTopic + "/co2").c_str(),
-                           String(int(sensor->ppm)).c_str());
+                           sensor->getPPMString().c_str());
     }
 
     if (sensor->hasLux())
     {
         mqttClient.publish((baseTopic + "/illuminance").c_str(),
-                           String(sensor->lux, 1).c_str());
+                           sensor->getLuxString().c_str());
     }
 
     if (sensor->hasWindSpeed())
     {
         mqttClient.publish((baseTopic + "/wind_speed").c_str(),
-                           String(sensor->windSpeed, 1).c_str());
+                           sensor->getWindSpeedString().c_str());
     }
 
     if (sensor->hasWindDirection())
@@ -591,26 +593,26 @@ void MQTTManager::publishDiscoveryForSensor(int sensorIndex)
     if (sensor->hasRainAmount())
     {
         mqttClient.publish((baseTopic + "/rain_amount").c_str(),
-                           String(sensor->rainAmount, 1).c_str());
+                           sensor->getRainAmountString().c_str());
         mqttClient.publish((baseTopic + "/daily_rain").c_str(),
-                           String(sensor->dailyRainTotal, 1).c_str());
+                           sensor->getDailyRainTotalString().c_str());
     }
 
     if (sensor->hasRainRate())
     {
         mqttClient.publish((baseTopic + "/rain_rate").c_str(),
-                           String(sensor->rainRate, 1).c_str());
+                           sensor->getRainRateString().c_str());
     }
 
     // Battery voltage - available for all sensors
     mqttClient.publish((baseTopic + "/battery").c_str(),
-                       String(sensor->batteryVoltage, 2).c_str());
+                       sensor->getBatteryVoltageString().c_str());
 
     // RSSI - available for all sensors
     mqttClient.publish((baseTopic + "/rssi").c_str(),
                        String(sensor->rssi).c_str());
 
-    logger.debug("Published MQTT data for sensor: " + sensor->name);
+    logger.debug("Published MQTT data for sensor: " + sensor.config().name);
 }
 
 // Check connection
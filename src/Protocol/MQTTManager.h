@@ -54,10 +54,10 @@ private:
     bool connect();
 
     // Create discovery topic for sensor
-    String buildDiscoveryTopic(const SensorData &sensor, const String &valueType);
+    String buildDiscoveryTopic(const SensorView &sensor, const String &valueType);
 
     // Create configuration JSON for Home Assistant discovery
-    String buildDiscoveryJson(const SensorData &sensor, const String &valueType, const String &stateTopic);
+    String buildDiscoveryJson(const SensorView &sensor, const String &valueType, const String &stateTopic);
 
     // Helper function to capitalize first letter
     String capitalizeFirst(const String &input);
@@ -136,7 +136,7 @@ bool ConfigManager::loadFromFS()
     file = LittleFS.open(configFile, "r");
 
     // Create JSON document
-    DynamicJsonDocument doc(512);
+    DynamicJsonDocument doc(768);
     DeserializationError error = deserializeJson(doc, file);
     file.close();
 
@@ -173,6 +173,7 @@ bool ConfigManager::loadFromFS()
         String logLevelStr = doc["logLevel"].as<String>();
         logLevel = logger.levelFromString(logLevelStr);
     }
+    logFileEnabled = doc["logFile"] | LOG_FILE_DEFAULT_ENABLED;
 
     return true;
 }
@@ -189,11 +190,12 @@ bool ConfigManager::saveToFS()
     }
 
     // Create JSON document
-    DynamicJsonDocument doc(512);
+    DynamicJsonDocument doc(768);
     doc["ssid"] = wifiSSID;
     doc["password"] = wifiPassword;
     doc["configMode"] = configMode;
     doc["logLevel"] = logger.levelToString(logLevel);
+    doc["logFile"] = logFileEnabled;
     doc["timezone"] = timezone;
     doc["mqttHost"] = mqttHost;
     doc["mqttPort"] = mqttPort;
@@ -234,6 +236,7 @@ bool ConfigManager::loadFromPreferences()
         String logLevelStr = preferences.getString("logLevel", "INFO");
         logLevel = logger.levelFromString(logLevelStr);
     }
+    logFileEnabled = preferences.getBool("logFile", LOG_FILE_DEFAULT_ENABLED);
 
     if (preferences.isKey("timezone"))
     {
@@ -286,6 +289,7 @@ bool ConfigManager::saveToPreferences()
     // Save logging level
     String logLevelStr = logger.levelToString(logLevel);
     preferences.putString("logLevel", logLevelStr);
+    preferences.putBool("logFile", logFileEnabled);
     preferences.putString("timezone", timezone);
 
     // Save MQTT configuration
@@ -377,6 +381,7 @@ void ConfigManager::resetToDefaults()
     configMode = true;
     lastWifiAttempt = 0;
     logLevel = LogLevel::INFO;
+    logFileEnabled = LOG_FILE_DEFAULT_ENABLED;
     timezone = DEFAULT_TIMEZONE;
     mqttHost = MQTT_DEFAULT_HOST;
     mqttPort = MQTT_DEFAULT_PORT;
@@ -465,3 +470,14 @@ void ConfigManager::setLogLevel(LogLevel level, bool saveConfig)
         save();
     }
 }
+
+// Enable or disable storing logs in files (the caller registers the file sink)
+void ConfigManager::setLogFileEnabled(bool enabled, bool saveConfig)
+{
+    logFileEnabled = enabled;
+
+    if (saveConfig)
+    {
+        save();
+    }
+}
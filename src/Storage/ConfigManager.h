@@ -61,6 +61,7 @@ public:
     bool configMode;               // Configuration mode (AP mode)
     unsigned long lastWifiAttempt; // Time of last WiFi connection attempt
     LogLevel logLevel;             // Logging level
+    bool logFileEnabled;           // Store logs in files on LittleFS
     String timezone;               // Timezone in Posix format
 
     // MQTT Configuration
@@ -116,6 +117,9 @@ public:
     // Set logging level
     void setLogLevel(LogLevel level, bool saveConfig = true);
 
+    // Enable or disable storing logs in files
+    void setLogFileEnabled(bool enabled, bool saveConfig = true);
+
     // Set timezone
     bool setTimezone(const String &newTimezone, bool saveConfig = true);
 
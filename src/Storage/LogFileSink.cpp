@@ -0,0 +1,332 @@
+/**
+ * expLORA Gateway Lite
+ *
+ * Log file sink implementation file
+ *
+ * Copyright Pajenicko s.r.o., Igor Sverma (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "LogFileSink.h"
+#include "../Hardware/PSRAM_Manager.h"
+
+// Constructor
+LogFileSink::LogFileSink(const char *dir)
+    : directory(dir), block(nullptr), blockUsed(0), blockTime(0), urgent(false), ready(false),
+      firstIndex(1), lastIndex(1), lastSize(0), totalSize(0), fileCount(0),
+      recordsWritten(0), blocksWritten(0), bytesWritten(0), writeErrors(0)
+{
+}
+
+// Destructor
+LogFileSink::~LogFileSink()
+{
+    if (block != nullptr)
+    {
+        PSRAMManager::freeMemory(block);
+    }
+}
+
+// Path of file with given number
+void LogFileSink::makePath(uint32_t index, char *path, size_t size) const
+{
+    snprintf(path, size, "%s/%08lu.log", directory, (unsigned long)index);
+}
+
+// Find existing log files and allocate block
+bool LogFileSink::init()
+{
+    ready = false;
+    if (block == nullptr)
+    {
+        block = (char *)PSRAMManager::allocateMemory(LOG_FILE_BLOCK_SIZE);
+        if (block == nullptr)
+        {
+            LOGF_ERROR("Failed to allocate log file block");
+            return false;
+        }
+    }
+
+    if (!LittleFS.exists(directory) && !LittleFS.mkdir(directory))
+    {
+        LOGF_ERROR("Failed to create log directory %s", directory);
+        return false;
+    }
+
+    File dir = LittleFS.open(directory);
+    if (!dir || !dir.isDirectory())
+    {
+        LOGF_ERROR("Failed to open log directory %s", directory);
+        return false;
+    }
+
+    // Files are named by number, anything else in the directory is ignored
+    {
+        std::lock_guard<std::mutex> lock(fileMutex);
+        bool found = false;
+        fileCount = 0;
+        totalSize = 0;
+        for (File file = dir.openNextFile(); file; file = dir.openNextFile())
+        {
+            const char *name = strrchr(file.name(), '/');
+            name = name != nullptr ? name + 1 : file.name();
+
+            char *end;
+            unsigned long index = strtoul(name, &end, 10);
+            if (index == 0 || strcmp(end, ".log") != 0)
+            {
+                continue;
+            }
+
+            if (!found || index < firstIndex)
+            {
+                firstIndex = index;
+            }
+            if (!found || index >= lastIndex)
+            {
+                lastIndex = index;
+                lastSize = file.size();
+            }
+            found = true;
+            fileCount++;
+            totalSize += file.size();
+        }
+    }
+    dir.close();
+
+    LOGF_INFO("Log files: %u files with %u bytes in %s", (unsigned)fileCount, (unsigned)totalSize, directory);
+
+    // Mark the boot, so logs of different runs are easy to tell apart
+    char marker[64];
+    int length = snprintf(marker, sizeof(marker), "--- expLORA Gateway Lite v%s started ---\n", FIRMWARE_VERSION);
+    blockUsed = 0;
+    urgent = false;
+    ready = addToBlock(marker, length);
+    return ready;
+}
+
+// Append block to current file
+bool LogFileSink::writeBlock()
+{
+    if (blockUsed == 0)
+    {
+        return true;
+    }
+
+    size_t written = 0;
+    {
+        std::lock_guard<std::mutex> lock(fileMutex);
+        char path[48];
+
+        // Start a new file rather than growing the current one past its limit
+        if (lastSize > 0 && lastSize + blockUsed > LOG_FILE_MAX_SIZE)
+        {
+            lastIndex++;
+            lastSize = 0;
+        }
+
+        // Delete oldest files to make room within the budget
+        while (totalSize + blockUsed > LOG_FILE_TOTAL_SIZE && firstIndex < lastIndex)
+        {
+            makePath(firstIndex, path, sizeof(path));
+            File file = LittleFS.open(path, "r");
+            if (file)
+            {
+                size_t size = file.size();
+                file.close();
+                LittleFS.remove(path);
+                totalSize -= size < totalSize ? size : totalSize;
+                fileCount--;
+            }
+            firstIndex++;
+        }
+
+        makePath(lastIndex, path, sizeof(path));
+        bool created = !LittleFS.exists(path);
+        File file = LittleFS.open(path, "a");
+        if (file)
+        {
+            if (created)
+            {
+                fileCount++;
+            }
+            written = file.write((const uint8_t *)block, blockUsed);
+            file.close();
+        }
+
+        lastSize += written;
+        totalSize += written;
+    }
+
+    bytesWritten += written;
+
+    // Block is dropped either way, so a full or failing file system cannot stop logging
+    bool success = written == blockUsed;
+    blockUsed = 0;
+    urgent = false;
+
+    if (!success)
+    {
+        writeErrors++;
+        LOGF_WARNING("Failed to write log file block (%u bytes written)", (unsigned)written);
+        return false;
+    }
+
+    blocksWritten++;
+    return true;
+}
+
+// Add text to block
+bool LogFileSink::addToBlock(const char *text, size_t length)
+{
+    if (block == nullptr)
+    {
+        return false;
+    }
+
+    if (blockUsed + length > LOG_FILE_BLOCK_SIZE)
+    {
+        writeBlock();
+    }
+
+    if (blockUsed == 0)
+    {
+        blockTime = millis();
+    }
+
+    memcpy(block + blockUsed, text, length);
+    blockUsed += length;
+    return true;
+}
+
+// Format record as text line into block
+bool LogFileSink::write(const LogEntry &entry)
+{
+    // Records from before the time was set keep their uptime instead
+    char timeStamp[32];
+    if (entry.time != 0)
+    {
+        entry.formatTime(timeStamp, sizeof(timeStamp));
+    }
+    else
+    {
+        snprintf(timeStamp, sizeof(timeStamp), "+%lu.%03lu", entry.timestamp / 1000, entry.timestamp % 1000);
+    }
+
+    char line[LOG_MESSAGE_SIZE + 48];
+    int length = snprintf(line, sizeof(line), "%s [%s] %s\n", timeStamp, Logger::levelName(entry.level), entry.message);
+    if (length < 0)
+    {
+        return true;
+    }
+    if ((size_t)length >= sizeof(line))
+    {
+        length = sizeof(line) - 1;
+        line[length - 1] = '\n';
+    }
+
+    // Sink without block was not initialized - records are skipped
+    if (!addToBlock(line, length))
+    {
+        return true;
+    }
+
+    recordsWritten++;
+    if (entry.level == LogLevel::ERROR)
+    {
+        urgent = true;
+    }
+    return true;
+}
+
+// Write block once it holds an error or waited long enough
+void LogFileSink::flush()
+{
+    if (blockUsed > 0 && (urgent || millis() - blockTime >= LOG_FILE_FLUSH_INTERVAL))
+    {
+        writeBlock();
+    }
+}
+
+// Write block now
+void LogFileSink::sync()
+{
+    writeBlock();
+}
+
+// Read stored logs for download
+size_t LogFileSink::read(uint32_t &index, size_t &offset, uint8_t *buffer, size_t size) const
+{
+    std::lock_guard<std::mutex> lock(fileMutex);
+
+    // Files deleted meanwhile are skipped, the download continues with the oldest one left
+    if ((int32_t)(index - firstIndex) < 0)
+    {
+        index = firstIndex;
+        offset = 0;
+    }
+
+    char path[48];
+    for (; (int32_t)(lastIndex - index) >= 0; index++, offset = 0)
+    {
+        makePath(index, path, sizeof(path));
+        if (!LittleFS.exists(path))
+        {
+            continue;
+        }
+
+        File file = LittleFS.open(path, "r");
+        if (!file)
+        {
+            continue;
+        }
+
+        size_t bytes = 0;
+        if (offset < file.size() && file.seek(offset))
+        {
+            bytes = file.read(buffer, size);
+        }
+        file.close();
+
+        if (bytes > 0)
+        {
+            offset += bytes;
+            return bytes;
+        }
+    }
+
+    return 0;
+}
+
+// Number of oldest log file
+uint32_t LogFileSink::getFirstIndex() const
+{
+    std::lock_guard<std::mutex> lock(fileMutex);
+    return firstIndex;
+}
+
+// Number of log files
+size_t LogFileSink::getFileCount() const
+{
+    std::lock_guard<std::mutex> lock(fileMutex);
+    return fileCount;
+}
+
+// Size of all log files
+size_t LogFileSink::getTotalSize() const
+{
+    std::lock_guard<std::mutex> lock(fileMutex);
+    return totalSize;
+}
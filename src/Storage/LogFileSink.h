@@ -0,0 +1,112 @@
+/**
+ * expLORA Gateway Lite
+ *
+ * Log file sink header file
+ *
+ * Copyright Pajenicko s.r.o., Igor Sverma (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <LittleFS.h>
+#include <atomic>
+#include <mutex>
+#include "../Data/Logging.h"
+#include "../config.h"
+
+/**
+ * Log sink keeping logs in rotating files on LittleFS, so they survive a reboot
+ *
+ * Records are formatted as text lines into a RAM block of LOG_FILE_BLOCK_SIZE
+ * bytes. The block is appended to the current file with one write once it is
+ * full, once its oldest record is LOG_FILE_FLUSH_INTERVAL old, as soon as it
+ * holds an ERROR record, and before reboot - flash sees few large writes
+ * instead of one per line. Files are numbered in order (/logs/00000001.log);
+ * a new one is started when the current one would grow past LOG_FILE_MAX_SIZE
+ * and the oldest ones are deleted to stay within LOG_FILE_TOTAL_SIZE.
+ *
+ * The drain task writes the sink, the web server reads the files for download
+ * meanwhile - file access is serialized by fileMutex.
+ */
+class LogFileSink : public LogSink
+{
+private:
+    const char *directory;
+    char *block;             // Records not written to flash yet
+    size_t blockUsed;        // Bytes used in block
+    unsigned long blockTime; // millis() of first record in block
+    bool urgent;             // Block holds an ERROR record
+    bool ready;              // init() succeeded
+
+    // Log files (guarded by fileMutex)
+    uint32_t firstIndex; // Number of oldest file
+    uint32_t lastIndex;  // Number of file being appended
+    size_t lastSize;     // Size of file being appended
+    size_t totalSize;    // Size of all files
+    size_t fileCount;    // Number of files
+    mutable std::mutex fileMutex;
+
+    // Statistics
+    std::atomic<uint32_t> recordsWritten;
+    std::atomic<uint32_t> blocksWritten;
+    std::atomic<uint64_t> bytesWritten;
+    std::atomic<uint32_t> writeErrors;
+
+    // Path of file with given number
+    void makePath(uint32_t index, char *path, size_t size) const;
+
+    // Append block to current file, rotating files as needed
+    bool writeBlock();
+
+    // Add text to block, writing the block out first if it does not fit
+    bool addToBlock(const char *text, size_t length);
+
+public:
+    // Constructor
+    LogFileSink(const char *dir = LOG_FILE_DIR);
+
+    // Destructor
+    ~LogFileSink();
+
+    // Find existing log files and allocate block (before registering the sink)
+    bool init();
+
+    // Whether init() succeeded, the sink must not be registered otherwise
+    bool isReady() const { return ready; }
+
+    // LogSink interface (called by the drain task)
+    const char *getName() const override { return "File"; }
+    bool write(const LogEntry &entry) override;
+    void flush() override;
+    void sync() override;
+
+    // Read stored logs for download, oldest file first - position is the file
+    // number and offset to continue at (start with getFirstIndex() and 0),
+    // returns number of bytes read, 0 at the end
+    size_t read(uint32_t &index, size_t &offset, uint8_t *buffer, size_t size) const;
+
+    // Number of oldest log file
+    uint32_t getFirstIndex() const;
+
+    // Statistics
+    size_t getFileCount() const;
+    size_t getTotalSize() const;
+    uint32_t getRecordsWritten() const { return recordsWritten.load(); }
+    uint32_t getBlocksWritten() const { return blocksWritten.load(); }
+    uint64_t getBytesWritten() const { return bytesWritten.load(); }
+    uint32_t getWriteErrors() const { return writeErrors.load(); }
+};
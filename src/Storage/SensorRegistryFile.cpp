@@ -0,0 +1,183 @@
+/**
+ * expLORA Gateway Lite
+ *
+ * Binary sensor registry implementation file
+ *
+ * Copyright Pajenicko s.r.o., Igor Sverma (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "SensorRegistryFile.h"
+#include "StateJournal.h"
+
+static_assert(sizeof(SensorRegistryFile::Header) == 20, "Registry header layout must not change");
+static_assert(sizeof(SensorRegistryFile::Record) == 64, "Registry record layout must not change");
+
+// Encode configured sensors
+size_t SensorRegistryFile::encode(const SensorStore &sensors, size_t count, std::vector<uint8_t> &buffer)
+{
+    size_t recordCount = 0;
+    size_t stringTableSize = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        if (sensors.readings(i).configured)
+        {
+            recordCount++;
+            stringTableSize += sensors.config(i).name.length() + sensors.config(i).customUrl.length();
+        }
+    }
+
+    size_t recordsStart = sizeof(Header);
+    size_t stringsStart = recordsStart + recordCount * sizeof(Record);
+    buffer.assign(stringsStart + stringTableSize, 0);
+
+    Record *records = reinterpret_cast<Record *>(&buffer[recordsStart]);
+    uint32_t stringOffset = 0;
+    size_t recordIndex = 0;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const SensorReadings &sensor = sensors.readings(i);
+        const SensorConfig &config = sensors.config(i);
+        if (!sensor.configured)
+        {
+            continue;
+        }
+
+        Record &record = records[recordIndex++];
+        record.serialNumber = sensor.serialNumber;
+        record.deviceKey = sensor.deviceKey;
+        record.deviceType = static_cast<uint8_t>(sensor.deviceType);
+        record.windDirectionCorrection = config.windDirectionCorrection;
+        record.altitude = config.altitude;
+        record.temperatureCorrection = config.temperatureCorrection;
+        record.humidityCorrection = config.humidityCorrection;
+        record.pressureCorrection = config.pressureCorrection;
+        record.ppmCorrection = config.ppmCorrection;
+        record.luxCorrection = config.luxCorrection;
+        record.windSpeedCorrection = config.windSpeedCorrection;
+        record.rainAmountCorrection = config.rainAmountCorrection;
+        record.rainRateCorrection = config.rainRateCorrection;
+
+        record.nameOffset = stringOffset;
+        record.nameLength = config.name.length();
+        memcpy(&buffer[stringsStart + stringOffset], config.name.c_str(), record.nameLength);
+        stringOffset += record.nameLength;
+
+        record.customUrlOffset = stringOffset;
+        record.customUrlLength = config.customUrl.length();
+        memcpy(&buffer[stringsStart + stringOffset], config.customUrl.c_str(), record.customUrlLength);
+        stringOffset += record.customUrlLength;
+    }
+
+    Header header;
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.recordSize = sizeof(Record);
+    header.recordCount = recordCount;
+    header.stringTableSize = stringTableSize;
+    header.crc = StateJournal::crc32(&buffer[recordsStart], buffer.size() - recordsStart);
+    memcpy(&buffer[0], &header, sizeof(header));
+
+    return recordCount;
+}
+
+// Decode registry into sensors
+bool SensorRegistryFile::decode(const uint8_t *data, size_t length, SensorStore &sensors, size_t &count, String &error)
+{
+    count = 0;
+
+    Header header;
+    if (length < sizeof(header))
+    {
+        error = "file too short";
+        return false;
+    }
+    memcpy(&header, data, sizeof(header));
+
+    if (header.magic != MAGIC)
+    {
+        error = "bad magic";
+        return false;
+    }
+    if (header.version > VERSION || header.recordSize < sizeof(Record))
+    {
+        error = "unsupported version " + String(header.version);
+        return false;
+    }
+
+    size_t stringsStart = sizeof(Header) + (size_t)header.recordCount * header.recordSize;
+    if (stringsStart + header.stringTableSize != length)
+    {
+        error = "size mismatch";
+        return false;
+    }
+    if (StateJournal::crc32(data + sizeof(Header), length - sizeof(Header)) != header.crc)
+    {
+        error = "CRC mismatch";
+        return false;
+    }
+
+    const char *strings = reinterpret_cast<const char *>(data + stringsStart);
+
+    size_t recordCount = header.recordCount;
+    if (recordCount > MAX_SENSORS)
+    {
+        error = "too many sensors";
+        recordCount = MAX_SENSORS;
+    }
+    if (!sensors.reserve(recordCount))
+    {
+        error = "out of memory for " + String(recordCount) + " sensors";
+        return false;
+    }
+
+    for (size_t i = 0; i < recordCount; i++)
+    {
+
+        Record record;
+        memcpy(&record, data + sizeof(Header) + (size_t)i * header.recordSize, sizeof(record));
+
+        if ((size_t)record.nameOffset + record.nameLength > header.stringTableSize ||
+            (size_t)record.customUrlOffset + record.customUrlLength > header.stringTableSize)
+        {
+            error = "bad string reference";
+            return false;
+        }
+
+        SensorReadings &sensor = sensors.beginWrite(count);
+        SensorConfig &config = sensors.config(count);
+        sensor.deviceType = static_cast<SensorType>(record.deviceType);
+        sensor.serialNumber = record.serialNumber;
+        sensor.deviceKey = record.deviceKey;
+        config.name = String(strings + record.nameOffset, record.nameLength);
+        config.customUrl = String(strings + record.customUrlOffset, record.customUrlLength);
+        config.altitude = record.altitude;
+        config.temperatureCorrection = record.temperatureCorrection;
+        config.humidityCorrection = record.humidityCorrection;
+        config.pressureCorrection = record.pressureCorrection;
+        config.ppmCorrection = record.ppmCorrection;
+        config.luxCorrection = record.luxCorrection;
+        config.windSpeedCorrection = record.windSpeedCorrection;
+        config.windDirectionCorrection = record.windDirectionCorrection;
+        config.rainAmountCorrection = record.rainAmountCorrection;
+        config.rainRateCorrection = record.rainRateCorrection;
+        config.prepareCorrections();
+        sensors.endWrite(count);
+        count++;
+    }
+
+    return true;
+}
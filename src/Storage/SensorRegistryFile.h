@@ -0,0 +1,82 @@
+/**
+ * expLORA Gateway Lite
+ *
+ * Binary sensor registry header file
+ *
+ * Copyright Pajenicko s.r.o., Igor Sverma (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <vector>
+#include "../Data/SensorStore.h"
+
+/**
+ * Binary format of the sensor registry (sensors.bin)
+ *
+ * Layout: Header, recordCount fixed-size Records, string table. Names and
+ * custom URLs are stored in the string table and referenced by offset and
+ * length, so records can be read straight into memory without parsing. The
+ * CRC covers everything after the header. Readers accept records larger than
+ * their own Record (fields appended by newer versions are ignored).
+ */
+class SensorRegistryFile
+{
+public:
+    static const uint32_t MAGIC = 0x52534C45; // "ELSR" little endian
+    static const uint16_t VERSION = 1;
+
+    struct Header
+    {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t recordSize;
+        uint32_t recordCount;
+        uint32_t stringTableSize;
+        uint32_t crc; // CRC-32 of records and string table
+    };
+
+    struct Record
+    {
+        uint32_t serialNumber;
+        uint32_t deviceKey;
+        uint8_t deviceType;
+        uint8_t reserved;
+        int16_t windDirectionCorrection;
+        int32_t altitude;
+        uint32_t nameOffset;
+        uint32_t customUrlOffset;
+        uint16_t nameLength;
+        uint16_t customUrlLength;
+        float temperatureCorrection;
+        float humidityCorrection;
+        float pressureCorrection;
+        float ppmCorrection;
+        float luxCorrection;
+        float windSpeedCorrection;
+        float rainAmountCorrection;
+        float rainRateCorrection;
+        uint32_t padding; // Zero, rounds record to 64 bytes
+    };
+
+    // Encode configured sensors of slots 0..count-1, returns number of encoded sensors
+    static size_t encode(const SensorStore &sensors, size_t count, std::vector<uint8_t> &buffer);
+
+    // Decode registry into slots 0..count-1 (configuration fields only), returns
+    // false if data is invalid or slots cannot be allocated; error describes the reason
+    static bool decode(const uint8_t *data, size_t length, SensorStore &sensors, size_t &count, String &error);
+};
@@ -0,0 +1,263 @@
+/**
+ * expLORA Gateway Lite
+ *
+ * State journal implementation file
+ *
+ * Copyright Pajenicko s.r.o., Igor Sverma (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "StateJournal.h"
+#include <esp_timer.h>
+
+static_assert(sizeof(StateJournal::Record) == 20, "Journal record layout must not change");
+
+// Constructor
+StateJournal::StateJournal(Logger &log, const char *journal, const char *snapshot)
+    : logger(log), journalFile(journal), snapshotFile(snapshot), nextSequence(1), journalRecords(0), damaged(false),
+      appendedRecords(0), compactions(0), corruptedRecords(0), bytesWritten(0),
+      replayedRecords(0), replayTime(0)
+{
+}
+
+// CRC-32 (IEEE 802.3), bitwise - records are small
+uint32_t StateJournal::crc32(const uint8_t *data, size_t length)
+{
+    uint32_t crc = 0xFFFFFFFF;
+    for (size_t i = 0; i < length; i++)
+    {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++)
+        {
+            crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+// Fill sequence and CRC of record
+void StateJournal::seal(Record &record)
+{
+    record.sequence = nextSequence++;
+    record.crc = crc32((const uint8_t *)&record, offsetof(Record, crc));
+}
+
+// Check CRC of record
+bool StateJournal::isValid(const Record &record)
+{
+    return record.crc == crc32((const uint8_t *)&record, offsetof(Record, crc));
+}
+
+// Build record for value
+StateJournal::Record StateJournal::makeRecord(uint32_t serialNumber, Field field, uint32_t value)
+{
+    Record record;
+    memset(&record, 0, sizeof(record));
+    record.serialNumber = serialNumber;
+    record.field = static_cast<uint8_t>(field);
+    record.value = value;
+    return record;
+}
+
+StateJournal::Record StateJournal::makeRecord(uint32_t serialNumber, Field field, float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return makeRecord(serialNumber, field, bits);
+}
+
+// Decode float value of record
+float StateJournal::toFloat(uint32_t value)
+{
+    float result;
+    memcpy(&result, &value, sizeof(result));
+    return result;
+}
+
+// Read records of file
+size_t StateJournal::readFile(const char *path, uint32_t minSequence, const ApplyFunction &apply, uint32_t *snapshotSequence)
+{
+    if (!LittleFS.exists(path))
+    {
+        return 0;
+    }
+
+    File file = LittleFS.open(path, "r");
+    if (!file)
+    {
+        logger.warning("Failed to open state file: " + String(path));
+        return 0;
+    }
+
+    size_t count = 0;
+    Record records[16];
+
+    for (;;)
+    {
+        size_t bytes = file.read((uint8_t *)records, sizeof(records));
+        size_t n = bytes / sizeof(Record);
+
+        for (size_t i = 0; i < n; i++)
+        {
+            const Record &record = records[i];
+            if (!isValid(record))
+            {
+                // Torn write at the end of the journal - everything after it is unusable
+                corruptedRecords++;
+                damaged = true;
+                logger.warning("Corrupted record in " + String(path) + " after " + String(count) + " records");
+                file.close();
+                return count;
+            }
+
+            if ((int32_t)(record.sequence - nextSequence) >= 0)
+            {
+                nextSequence = record.sequence + 1;
+            }
+
+            Field field = static_cast<Field>(record.field);
+            if (field == Field::SNAPSHOT)
+            {
+                if (snapshotSequence != nullptr)
+                {
+                    *snapshotSequence = record.value;
+                }
+            }
+            else if ((int32_t)(record.sequence - minSequence) > 0)
+            {
+                apply(record.serialNumber, field, record.value);
+            }
+            count++;
+        }
+
+        if (bytes < sizeof(records))
+        {
+            if (bytes % sizeof(Record) != 0)
+            {
+                corruptedRecords++;
+                damaged = true;
+                logger.warning("Truncated record at end of " + String(path));
+            }
+            break;
+        }
+    }
+
+    file.close();
+    return count;
+}
+
+// Apply snapshot and journal records
+bool StateJournal::replay(const ApplyFunction &apply)
+{
+    int64_t start = esp_timer_get_time();
+
+    uint32_t snapshotSequence = 0;
+    size_t snapshotRecords = readFile(snapshotFile, 0, apply, &snapshotSequence);
+
+    // Records already folded into snapshot by an interrupted compaction are skipped
+    journalRecords = readFile(journalFile, snapshotSequence, apply, nullptr);
+
+    replayedRecords = snapshotRecords + journalRecords;
+    replayTime = (uint32_t)(esp_timer_get_time() - start);
+
+    logger.info("State journal replayed " + String(snapshotRecords) + " snapshot and " +
+                String(journalRecords) + " journal records in " + String(replayTime) + " us");
+    return true;
+}
+
+// Append records to journal
+bool StateJournal::append(Record *records, size_t count)
+{
+    if (count == 0)
+    {
+        return true;
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        seal(records[i]);
+    }
+
+    File file = LittleFS.open(journalFile, "a");
+    if (!file)
+    {
+        logger.warning("Failed to open state journal: " + String(journalFile));
+        return false;
+    }
+
+    size_t bytes = count * sizeof(Record);
+    size_t written = file.write((const uint8_t *)records, bytes);
+    file.close();
+
+    bytesWritten += written;
+    if (written != bytes)
+    {
+        logger.warning("Failed to append to state journal");
+        return false;
+    }
+
+    journalRecords += count;
+    appendedRecords += count;
+    return true;
+}
+
+// Replace snapshot with given records and empty the journal
+bool StateJournal::compact(Record *records, size_t count)
+{
+    String tempFile = String(snapshotFile) + ".tmp";
+
+    File file = LittleFS.open(tempFile, "w");
+    if (!file)
+    {
+        logger.warning("Failed to create state snapshot: " + tempFile);
+        return false;
+    }
+
+    // Snapshot covers every record written so far
+    Record header = makeRecord(0, Field::SNAPSHOT, nextSequence - 1);
+    seal(header);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        seal(records[i]);
+    }
+
+    size_t written = file.write((const uint8_t *)&header, sizeof(header));
+    written += file.write((const uint8_t *)records, count * sizeof(Record));
+    file.close();
+
+    bytesWritten += written;
+    if (written != (count + 1) * sizeof(Record))
+    {
+        logger.warning("Failed to write state snapshot");
+        LittleFS.remove(tempFile);
+        return false;
+    }
+
+    // Journal is only removed after the new snapshot is in place
+    if (!LittleFS.rename(tempFile, snapshotFile))
+    {
+        logger.warning("Failed to replace state snapshot");
+        return false;
+    }
+    LittleFS.remove(journalFile);
+
+    logger.info("State journal compacted: " + String(journalRecords) + " journal records into " +
+                String(count) + " snapshot records");
+    journalRecords = 0;
+    damaged = false;
+    compactions++;
+    return true;
+}
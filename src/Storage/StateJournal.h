@@ -0,0 +1,127 @@
+/**
+ * expLORA Gateway Lite
+ *
+ * State journal header file
+ *
+ * Copyright Pajenicko s.r.o., Igor Sverma (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <LittleFS.h>
+#include <atomic>
+#include <functional>
+#include "../Data/Logging.h"
+#include "../config.h"
+
+/**
+ * Append-only journal for fast-changing sensor state
+ *
+ * Values such as the daily rain total change with every packet but are not
+ * configuration, so they are appended as small CRC-protected records instead
+ * of rewriting the sensor configuration. Once the journal grows past
+ * STATE_JOURNAL_COMPACT_RECORDS it is compacted into a snapshot holding the
+ * latest value of every field. Every record carries a sequence number; the
+ * snapshot remembers the last one it covers, so journal records left over from
+ * an interrupted compaction are skipped on replay.
+ */
+class StateJournal
+{
+public:
+    // Journaled values (stored in the file - never renumber)
+    enum class Field : uint8_t
+    {
+        SNAPSHOT = 0,         // Snapshot header, value = last sequence covered
+        DAILY_RAIN_TOTAL = 1, // float bits (mm)
+        LAST_RAIN_RESET = 2,  // time_t of last daily rain reset
+    };
+
+    // On-flash record
+    struct Record
+    {
+        uint32_t sequence;
+        uint32_t serialNumber;
+        uint8_t field;
+        uint8_t reserved[3];
+        uint32_t value;
+        uint32_t crc; // CRC-32 of preceding bytes
+    };
+
+    // Called for every valid record during replay, oldest first
+    typedef std::function<void(uint32_t serialNumber, Field field, uint32_t value)> ApplyFunction;
+
+private:
+    Logger &logger;
+    const char *journalFile;
+    const char *snapshotFile;
+
+    uint32_t nextSequence;
+    size_t journalRecords; // Records in journal file since last compaction
+    bool damaged;          // Replay stopped at a corrupted record - appends would be lost
+
+    // Statistics
+    std::atomic<uint32_t> appendedRecords;
+    std::atomic<uint32_t> compactions;
+    std::atomic<uint32_t> corruptedRecords;
+    std::atomic<uint64_t> bytesWritten;
+    uint32_t replayedRecords;
+    uint32_t replayTime; // us
+
+    // Fill sequence and CRC of record
+    void seal(Record &record);
+
+    // Check CRC of record
+    static bool isValid(const Record &record);
+
+    // Read records of file, returns number of valid records (stops at first invalid one)
+    size_t readFile(const char *path, uint32_t minSequence, const ApplyFunction &apply, uint32_t *snapshotSequence);
+
+public:
+    // Constructor
+    StateJournal(Logger &log, const char *journal = STATE_JOURNAL_FILE, const char *snapshot = STATE_SNAPSHOT_FILE);
+
+    // Apply snapshot and journal records, oldest first
+    bool replay(const ApplyFunction &apply);
+
+    // Build record for value (sequence and CRC are filled by append)
+    static Record makeRecord(uint32_t serialNumber, Field field, uint32_t value);
+    static Record makeRecord(uint32_t serialNumber, Field field, float value);
+
+    // Append records to journal with one file write
+    bool append(Record *records, size_t count);
+
+    // Whether journal should be compacted
+    bool needsCompaction() const { return damaged || journalRecords >= STATE_JOURNAL_COMPACT_RECORDS; }
+
+    // Replace snapshot with given records (latest state) and empty the journal
+    bool compact(Record *records, size_t count);
+
+    // Decode float value of record
+    static float toFloat(uint32_t value);
+
+    // CRC-32 (IEEE 802.3)
+    static uint32_t crc32(const uint8_t *data, size_t length);
+
+    // Statistics
+    size_t getJournalRecords() const { return journalRecords; }
+    uint32_t getAppendedRecords() const { return appendedRecords.load(); }
+    uint32_t getCompactions() const { return compactions.load(); }
+    uint32_t getCorruptedRecords() const { return corruptedRecords.load(); }
+    uint64_t getBytesWritten() const { return bytesWritten.load(); }
+    uint32_t getReplayedRecords() const { return replayedRecords; }
+    uint32_t getReplayTime() const { return replayTime; }
+};
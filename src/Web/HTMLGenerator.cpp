@@ -25,6 +25,12 @@
 #include <Arduino.h>
 #include <WiFi.h>
 #include "../config.h"
+#include "../Data/PacketLatency.h"
+#include "../Data/LoopProfiler.h"
+#include "../Protocol/HttpForwarder.h"
+#include "../Protocol/LoRaProtocol.h"
+#include "../Data/SensorManager.h"
+#include "../Storage/LogFileSink.h"
 
 // Initialization of static variables
 char *HTMLGenerator::htmlBuffer = nullptr;
@@ -229,6 +235,7 @@ void HTMLGenerator::addNavigation(String &html, const String &activePage)
     html += "<a href='/mqtt' class='" + String(activePage == "MQTT" ? "active" : "") + "'>MQTT</a>";
     html += "<a href='/logs' class='" + String(activePage == "Logs" ? "active" : "") + "'>Logs</a>";
     html += "<a href='/api' class='" + String(activePage == "API" ? "active" : "") + "'>API</a>";
+    html += "<a href='/diagnostics' class='" + String(activePage == "Diagnostics" ? "active" : "") + "'>Diagnostics</a>";
     html += "<a href='/update'>Update</a>";
     html += "<a href='/reboot' onclick=\"return confirm('Are you sure you want to reboot the device?');\">Reboot</a>";
     html += "<a href='javascript:void(0);' class='icon' onclick='toggleMenu()'>&#9776;</a>";
@@ -238,7 +245,7 @@ void HTMLGenerator::addNavigation(String &html, const String &activePage)
 }
 
 // In HTMLGenerator.cpp, modify the generateHomePage method
-String HTMLGenerator::generateHomePage(const std::vector<SensorData> &sensors)
+String HTMLGenerator::generateHomePage(const SensorSnapshot &snapshot)
 {
     String html;
 
@@ -296,7 +303,7 @@ String HTMLGenerator::generateHomePage(const std::vector<SensorData> &sensors)
     html += "</div>";
 
     // Active sensors - optimize by checking vector size first
-    if (!sensors.empty())
+    if (!snapshot.empty())
     {
         html += "<div class='card'>";
         html += "<h2>Active Sensors</h2>";
@@ -305,22 +312,23 @@ String HTMLGenerator::generateHomePage(const std::vector<SensorData> &sensors)
         html += "<table>";
         html += "<tr><th>Name</th><th>Type</th><th>Last Seen</th><th>Data</th></tr>";
 
-        for (const auto &sensor : sensors)
+        for (size_t i = 0; i < snapshot.size(); i++)
         {
-            if (sensor.configured)
+            SensorView sensor = snapshot[i];
+            if (sensor->configured)
             {
                 html += "<tr>";
-                html += "<td>" + sensor.name + "</td>";
-                html += "<td>" + sensorTypeToString(sensor.deviceType) + "</td>";
-                html += "<td>" + sensor.getLastSeenString() + "</td>";
+                html += "<td>" + sensor.config().name + "</td>";
+                html += "<td>" + sensorTypeToString(sensor->deviceType) + "</td>";
+                html += "<td>" + sensor->getLastSeenString() + "</td>";
 
                 // Add sensor data - use the getDataString() method
-                html += "<td>" + sensor.getDataString() + "</td>";
+                html += "<td>" + sensor->getDataString() + "</td>";
 
                 html += "</tr>";
 
                 // Yield to other tasks periodically during table generation
-                if (&sensor != &sensors.back())
+                if (i + 1 < snapshot.size())
                 {
                     yield();
                 }
@@ -341,7 +349,7 @@ String HTMLGenerator::generateHomePage(const std::vector<SensorData> &sensors)
 }
 
 // Generating sensor table (optimized version for buffer)
-void HTMLGenerator::generateSensorTable(char *buffer, size_t &maxLen, const std::vector<SensorData> &sensors)
+void HTMLGenerator::generateSensorTable(char *buffer, size_t &maxLen, const SensorSnapshot &snapshot)
 {
     size_t contentLen = 0;
 
@@ -351,29 +359,30 @@ void HTMLGenerator::generateSensorTable(char *buffer, size_t &maxLen, const std:
                            "<tr><th>Name</th><th>Type</th><th>Serial Number</th><th>Last Seen</th><th>Sensor Data</th></tr>");
 
     // Process all sensors
-    for (const auto &sensor : sensors)
+    for (size_t i = 0; i < snapshot.size(); i++)
     {
-        if (sensor.configured)
+        SensorView sensor = snapshot[i];
+        if (sensor->configured)
         {
             contentLen += snprintf(buffer + contentLen, maxLen - contentLen,
                                    "<tr>"
                                    "<td>%s</td>"
                                    "<td>%s</td>"
                                    "<td>%X</td>",
-                                   sensor.name.c_str(),
-                                   sensor.getTypeInfo().name,
-                                   sensor.serialNumber);
+                                   sensor.config().name.c_str(),
+                                   sensor->getTypeInfo().name,
+                                   sensor->serialNumber);
 
             // Last Seen
             contentLen += snprintf(buffer + contentLen, maxLen - contentLen,
                                    "<td>%s</td>",
-                                   sensor.getLastSeenString().c_str());
+                                   sensor->getLastSeenString().c_str());
 
             // Sensor Data
             contentLen += snprintf(buffer + contentLen, maxLen - contentLen,
                                    "<td>%s</td>"
                                    "</tr>",
-                                   sensor.getDataString().c_str());
+                                   sensor->getDataString().c_str());
         }
     }
 
@@ -533,7 +542,7 @@ String HTMLGenerator::generateMqttPage(const String &host, int port, const Strin
 }
 
 // Generating page with sensor list
-String HTMLGenerator::generateSensorsPage(const std::vector<SensorData> &sensors)
+String HTMLGenerator::generateSensorsPage(const SensorSnapshot &snapshot)
 {
     String html;
     // Adding header
@@ -543,7 +552,7 @@ String HTMLGenerator::generateSensorsPage(const std::vector<SensorData> &sensors
     html += "<div class='card'>";
     html += "<h2>Configured Sensors</h2>";
 
-    if (sensors.empty())
+    if (snapshot.empty())
     {
         html += "<p>No sensors configured yet.</p>";
     }
@@ -552,19 +561,19 @@ String HTMLGenerator::generateSensorsPage(const std::vector<SensorData> &sensors
         html += "<table>";
         html += "<tr><th>Name</th><th>Type</th><th>Serial Number</th><th>Last Seen</th><th>Actions</th></tr>";
 
-        for (size_t i = 0; i < sensors.size(); i++)
+        for (size_t i = 0; i < snapshot.size(); i++)
         {
-            const auto &sensor = sensors[i];
-            if (sensor.configured)
+            SensorView sensor = snapshot[i];
+            if (sensor->configured)
             {
                 html += "<tr>";
-                html += "<td>" + sensor.name + "</td>";
-                html += "<td>" + sensorTypeToString(sensor.deviceType) + "</td>";
-                html += "<td>" + String(sensor.serialNumber, HEX) + "</td>";
-                html += "<td>" + sensor.getLastSeenString() + "</td>";
+                html += "<td>" + sensor.config().name + "</td>";
+                html += "<td>" + sensorTypeToString(sensor->deviceType) + "</td>";
+                html += "<td>" + String(sensor->serialNumber, HEX) + "</td>";
+                html += "<td>" + sensor->getLastSeenString() + "</td>";
                 html += "<td>";
-                html += "<a href='/sensors/edit?index=" + String(i) + "' class='btn'>Edit</a> ";
-                html += "<a href='/sensors/delete?index=" + String(i) + "' class='btn btn-delete' onclick='return confirm(\"Are you sure you want to delete this sensor?\")'>Delete</a>";
+                html += "<a href='/sensors/edit?index=" + String(snapshot.indexAt(i)) + "' class='btn'>Edit</a> ";
+                html += "<a href='/sensors/delete?index=" + String(snapshot.indexAt(i)) + "' class='btn btn-delete' onclick='return confirm(\"Are you sure you want to delete this sensor?\")'>Delete</a>";
                 html += "</td>";
                 html += "</tr>";
             }
@@ -576,6 +585,17 @@ String HTMLGenerator::generateSensorsPage(const std::vector<SensorData> &sensors
     html += "<p><a href='/sensors/add' class='btn'>Add New Sensor</a></p>";
     html += "</div>";
 
+    // Backup of sensor configuration
+    html += "<div class='card'>";
+    html += "<h2>Backup</h2>";
+    html += "<p><a href='/sensors/export' class='btn'>Export Sensors (JSON)</a></p>";
+    html += "<form method='post' action='/sensors/import'>";
+    html += "<label for='json'>Import sensors (replaces all configured sensors):</label>";
+    html += "<textarea id='json' name='json' rows='6' required></textarea>";
+    html += "<input type='submit' value='Import Sensors' onclick='return confirm(\"Replace all configured sensors?\")'>";
+    html += "</form>";
+    html += "</div>";
+
     // Adding footer
     addHtmlFooter(html);
 
@@ -1163,7 +1183,7 @@ String HTMLGenerator::generateSensorEditPage(const SensorData &sensor, int index
 }
 
 // Generating logs page
-String HTMLGenerator::generateLogsPage(const LogEntry *logs, size_t logCount, LogLevel currentLevel)
+String HTMLGenerator::generateLogsPage(LogLevel currentLevel, const LogFileSink *fileSink, bool fileEnabled)
 {
     String html;
 
@@ -1194,65 +1214,120 @@ String HTMLGenerator::generateLogsPage(const LogEntry *logs, size_t logCount, Lo
     html += "</div>";
     html += "</div>";
 
+    // Log files kept across reboots
+    if (fileSink != nullptr)
+    {
+        html += "<div class='card'>";
+        html += "<h2>Log Files</h2>";
+        html += "<form method='post' action='/logs/file'>";
+        html += "<label for='enabled'>Store logs in flash:</label>";
+        html += "<input type='checkbox' id='enabled' name='enabled' value='1'" + String(fileEnabled ? " checked" : "") + ">";
+        html += "<input type='submit' value='Save'>";
+        html += "</form>";
+        html += "<table>";
+        html += "<tr><td>Stored</td><td>" + String(fileSink->getFileCount()) + " files, " +
+                String(fileSink->getTotalSize() / 1024) + " of " + String(LOG_FILE_TOTAL_SIZE / 1024) + " KB</td></tr>";
+        html += "<tr><td>Written since boot</td><td>" + String(fileSink->getBlocksWritten()) + " blocks, " +
+                String((uint32_t)(fileSink->getBytesWritten() / 1024)) + " KB</td></tr>";
+        html += "<tr><td>Write errors</td><td>" + String(fileSink->getWriteErrors()) + "</td></tr>";
+        html += "</table>";
+        html += "<div style='margin-top: 20px;'>";
+        html += "<a href='/logs/download' class='btn'>Download</a>";
+        html += "</div>";
+        html += "</div>";
+    }
+
     // Log content
     html += "<div class='card'>";
     html += "<h2>System Logs</h2>";
-    html += "<div class='log-container'>";
+    html += "<div class='log-container' id='logs'>";
+
+    // Sequence number following the newest shown log, the page then asks only for newer ones
+    uint32_t nextSequence = Logger::getNextSequence();
 
     // Using optimized method for log generation
     if (htmlBuffer != nullptr)
     {
         memset(htmlBuffer, 0, htmlBufferSize);
         size_t maxLen = htmlBufferSize;
-        generateLogTable(htmlBuffer, maxLen, logs, logCount);
+        generateLogTable(htmlBuffer, maxLen, nextSequence);
         html += htmlBuffer;
     }
     else
     {
         // Fallback if buffer is not available
-        if (logCount > 0)
+        bool newest = true;
+        size_t logCount = Logger::forEachLog([&](const LogEntry &entry)
         {
-            for (size_t i = 0; i < logCount; i++)
+            if (newest)
             {
-                size_t index = (logCount - 1 - i); // Display from newest
-                String logClass = "log-";
+                nextSequence = entry.sequence + 1;
+                newest = false;
+            }
 
-                switch (logs[index].level)
-                {
-                case LogLevel::ERROR:
-                    logClass += "error";
-                    break;
-                case LogLevel::WARNING:
-                    logClass += "warning";
-                    break;
-                case LogLevel::INFO:
-                    logClass += "info";
-                    break;
-                case LogLevel::DEBUG:
-                    logClass += "debug";
-                    break;
-                case LogLevel::VERBOSE:
-                    logClass += "verbose";
-                    break;
-                default:
-                    logClass += "info";
-                    break;
-                }
+            String logClass = "log-";
 
-                html += "<div class='log-entry " + logClass + "'>" + logs[index].getFormattedLog() + "</div>";
+            switch (entry.level)
+            {
+            case LogLevel::ERROR:
+                logClass += "error";
+                break;
+            case LogLevel::WARNING:
+                logClass += "warning";
+                break;
+            case LogLevel::INFO:
+                logClass += "info";
+                break;
+            case LogLevel::DEBUG:
+                logClass += "debug";
+                break;
+            case LogLevel::VERBOSE:
+                logClass += "verbose";
+                break;
+            default:
+                logClass += "info";
+                break;
             }
-        }
-        else
+
+            html += "<div class='log-entry " + logClass + "'>" + entry.getFormattedLog() + "</div>";
+            return true;
+        });
+
+        if (logCount == 0)
         {
-            html += "<div class='log-entry'>No logs to display</div>";
+            html += "<div class='log-entry' id='no-logs'>No logs to display</div>";
         }
     }
 
     html += "</div>"; // log-container
     html += "</div>"; // card
 
-    // Auto-refresh for logs
-    html += "<script>startAutoRefresh(30000);</script>";
+    // New logs are fetched from /api/logs and added on top instead of reloading the page
+    html += "<script>";
+    html += "var logNext = " + String(nextSequence) + ";";
+    html += "var logBoot = " + String(Logger::getBootId()) + ";";
+    html += "function addLog(box, cls, text) {";
+    html += "  var e = document.createElement('div');";
+    html += "  e.className = 'log-entry ' + cls;";
+    html += "  e.textContent = text;";
+    html += "  box.insertBefore(e, box.firstChild);";
+    html += "  while (box.childNodes.length > " + String(LOG_PAGE_MAX_ENTRIES) + ") box.removeChild(box.lastChild);";
+    html += "}";
+    html += "function pollLogs() {";
+    html += "  fetch('/api/logs' + (logNext === null ? '' : '?since=' + logNext)).then(function(r) { return r.json(); }).then(function(d) {";
+    html += "    var box = document.getElementById('logs');";
+    html += "    var empty = document.getElementById('no-logs');";
+    html += "    if (d.boot != logBoot) { box.innerHTML = ''; logBoot = d.boot; logNext = null; pollLogs(); return; }";
+    html += "    if (d.reset) box.innerHTML = '';";
+    html += "    else if (empty && d.logs.length > 0) box.removeChild(empty);";
+    html += "    if (d.lost > 0) addLog(box, 'log-warning', d.lost + ' logs were overwritten before they could be shown');";
+    html += "    d.logs.forEach(function(l) { addLog(box, 'log-' + l.level.toLowerCase(), l.time + ' [' + l.level + '] ' + l.message); });";
+    html += "    logNext = d.next;";
+    html += "    setTimeout(pollLogs, d.more ? 0 : " + String(LOG_PAGE_POLL_INTERVAL) + ");";
+    html += "  }).catch(function() { setTimeout(pollLogs, " + String(LOG_PAGE_POLL_INTERVAL) + "); });";
+    html += "}";
+    html += "setTimeout(pollLogs, " + String(LOG_PAGE_POLL_INTERVAL) + ");";
+    html += "</script>";
 
     // Adding footer
     addHtmlFooter(html);
@@ -1261,69 +1336,149 @@ String HTMLGenerator::generateLogsPage(const LogEntry *logs, size_t logCount, Lo
 }
 // Generating log table
 // In HTMLGenerator.cpp
-void HTMLGenerator::generateLogTable(char *buffer, size_t &maxLen, const LogEntry *logs, size_t logCount)
+void HTMLGenerator::generateLogTable(char *buffer, size_t &maxLen, uint32_t &nextSequence)
 {
     size_t contentLen = 0;
 
-    if (logCount > 0)
+    // Loop through from newest to oldest
+    size_t logCount = Logger::forEachLog([&](const LogEntry &entry)
     {
-        // Loop through from newest to oldest
-        for (size_t i = 0; i < logCount; i++)
+        if (contentLen == 0)
         {
-            // Calculate correct index in the circular buffer
-            // This is critical to display logs correctly
-            size_t logIdx = (Logger::getLogIndex() - 1 - i + Logger::getLogBufferSize()) % Logger::getLogBufferSize();
+            nextSequence = entry.sequence + 1;
+        }
 
-            const char *logClass = "";
-            switch (logs[logIdx].level)
-            {
-            case LogLevel::ERROR:
-                logClass = "log-error";
-                break;
-            case LogLevel::WARNING:
-                logClass = "log-warning";
-                break;
-            case LogLevel::INFO:
-                logClass = "log-info";
-                break;
-            case LogLevel::DEBUG:
-                logClass = "log-debug";
-                break;
-            case LogLevel::VERBOSE:
-                logClass = "log-verbose";
-                break;
-            default:
-                logClass = "log-info";
-                break;
-            }
+        const char *logClass = "";
+        switch (entry.level)
+        {
+        case LogLevel::ERROR:
+            logClass = "log-error";
+            break;
+        case LogLevel::WARNING:
+            logClass = "log-warning";
+            break;
+        case LogLevel::INFO:
+            logClass = "log-info";
+            break;
+        case LogLevel::DEBUG:
+            logClass = "log-debug";
+            break;
+        case LogLevel::VERBOSE:
+            logClass = "log-verbose";
+            break;
+        default:
+            logClass = "log-info";
+            break;
+        }
+
+        // Time is formatted here, logs only store it as a number
+        char timeStamp[32];
+        entry.formatTime(timeStamp, sizeof(timeStamp));
 
+        contentLen += snprintf(buffer + contentLen, maxLen - contentLen,
+                               "<div class='log-entry %s'>%s [%s] %s</div>",
+                               logClass,
+                               timeStamp,
+                               Logger::levelName(entry.level),
+                               entry.message);
+
+        // Safety check to avoid buffer overflow
+        if (contentLen >= maxLen - 100)
+        {
             contentLen += snprintf(buffer + contentLen, maxLen - contentLen,
-                                   "<div class='log-entry %s'>%s</div>",
-                                   logClass,
-                                   logs[logIdx].getFormattedLog().c_str());
+                                   "<div class='log-entry log-warning'>Log output truncated due to buffer size limitations</div>");
+            return false;
+        }
+        return true;
+    });
 
-            // Safety check to avoid buffer overflow
-            if (contentLen >= maxLen - 100)
-            {
-                contentLen += snprintf(buffer + contentLen, maxLen - contentLen,
-                                       "<div class='log-entry log-warning'>Log output truncated due to buffer size limitations</div>");
-                break;
-            }
+    if (logCount == 0)
+    {
+        contentLen += snprintf(buffer + contentLen, maxLen - contentLen,
+                               "<div class='log-entry' id='no-logs'>No logs to display</div>");
+    }
+}
+
+// Write JSON string with quotes and escapes
+void HTMLGenerator::printJsonString(Print &out, const char *text)
+{
+    out.print('"');
+    const char *plain = text;
+    for (const char *c = text; *c != '\0'; c++)
+    {
+        if (*c != '"' && *c != '\\' && (uint8_t)*c >= 0x20)
+        {
+            continue;
         }
+
+        out.write((const uint8_t *)plain, c - plain);
+        if (*c == '"' || *c == '\\')
+        {
+            out.print('\\');
+            out.print(*c);
+        }
+        else
+        {
+            out.printf("\\u%04x", (unsigned)(uint8_t)*c);
+        }
+        plain = c + 1;
     }
-    else
+    out.print(plain);
+    out.print('"');
+}
+
+// Generating JSON with logs for incremental log page updates
+void HTMLGenerator::generateLogsJson(Print &out, bool hasSince, uint32_t since)
+{
+    // Sequence 0 is older than any stored log (until the counter wraps), so it starts at the oldest one
+    if (!hasSince)
     {
-        contentLen += snprintf(buffer + contentLen, maxLen - contentLen,
-                               "<div class='log-entry'>No logs to display</div>");
+        since = 0;
     }
+
+    // Records are written straight to the response, polling allocates no document
+    out.printf("{\"boot\":%lu,\"logs\":[", (unsigned long)Logger::getBootId());
+
+    uint32_t next = since;
+    uint32_t first = since;
+    size_t written = 0;
+    size_t count = Logger::forEachLogSince(next, [&](const LogEntry &entry)
+    {
+        if (written == 0)
+        {
+            first = entry.sequence;
+        }
+
+        char timeStamp[32];
+        entry.formatTime(timeStamp, sizeof(timeStamp));
+
+        out.printf("%s{\"seq\":%lu,\"time\":\"%s\",\"level\":\"%s\",\"message\":", written > 0 ? "," : "",
+                   (unsigned long)entry.sequence, timeStamp, Logger::levelName(entry.level));
+        printJsonString(out, entry.message);
+        out.print('}');
+
+        return ++written < LOG_API_MAX_RECORDS;
+    });
+
+    if (count == 0)
+    {
+        first = next;
+    }
+
+    // Cursor older than the oldest log lost records, cursor ahead of the log is from before a reboot
+    int32_t skipped = (int32_t)(first - since);
+
+    out.printf("],\"next\":%lu,\"lost\":%ld,\"reset\":%s,\"more\":%s}", (unsigned long)next,
+               skipped > 0 && hasSince ? (long)skipped : 0L, skipped < 0 ? "true" : "false",
+               count == LOG_API_MAX_RECORDS ? "true" : "false");
 }
 
 // Generating JSON for API
-String HTMLGenerator::generateAPIJson(const std::vector<SensorData> &sensors)
+String HTMLGenerator::generateAPIJson(const SensorSnapshot &snapshot)
 {
     // Estimating JSON document size
-    const size_t capacity = JSON_OBJECT_SIZE(5) + JSON_ARRAY_SIZE(sensors.size()) +
-                            sensors.size() * JSON_OBJECT_SIZE(15) + 1024; // Extra space for safety
+    const size_t capacity = JSON_OBJECT_SIZE(5) + JSON_ARRAY_SIZE(snapshot.size()) +
+                            snapshot.size() * JSON_OBJECT_SIZE(15) + 1024; // Extra space for safety
 
     DynamicJsonDocument doc(capacity);
 
@@ -1348,9 +1503,10 @@ String HTMLGenerator::generateAPIJson(const std::vector<SensorData> &sensors)
     // Sensors array
     JsonArray sensorsArray = doc.createNestedArray("sensors");
 
-    for (const auto &sensor : sensors)
+    for (size_t i = 0; i < snapshot.size(); i++)
     {
-        if (sensor.configured)
+        SensorView sensor = snapshot[i];
+        if (sensor->configured)
         {
             JsonObject sensorObj = sensorsArray.createNestedObject();
             sensor.toJson(sensorObj);
@@ -1363,8 +1519,331 @@ String HTMLGenerator::generateAPIJson(const std::vector<SensorData> &sensors)
     return result;
 }
 
+// Generating JSON with packet latency histograms
+String HTMLGenerator::generateLatencyJson()
+{
+    const size_t stageCount = static_cast<size_t>(LatencyStage::COUNT);
+    const size_t capacity = JSON_OBJECT_SIZE(3) + JSON_ARRAY_SIZE(stageCount) +
+                            stageCount * (JSON_OBJECT_SIZE(9) + JSON_ARRAY_SIZE(LatencyHistogram::BUCKET_COUNT)) + 512;
+
+    DynamicJsonDocument doc(capacity);
+
+    doc["unit"] = "us";
+    doc["buckets"] = "bucket 0 counts 0 us, bucket n counts [2^(n-1), 2^n) us";
+
+    JsonArray stagesArray = doc.createNestedArray("stages");
+
+    for (size_t i = 0; i < stageCount; i++)
+    {
+        LatencyStage stage = static_cast<LatencyStage>(i);
+        const LatencyHistogram &histogram = PacketLatency::get(stage);
+
+        JsonObject stageObj = stagesArray.createNestedObject();
+        stageObj["stage"] = PacketLatency::getStageName(stage);
+        stageObj["count"] = histogram.getCount();
+        stageObj["min"] = histogram.getMin();
+        stageObj["avg"] = histogram.getAverage();
+        stageObj["max"] = histogram.getMax();
+        stageObj["p50"] = histogram.getPercentile(50);
+        stageObj["p90"] = histogram.getPercentile(90);
+        stageObj["p99"] = histogram.getPercentile(99);
+
+        // Buckets up to the last non-empty one
+        size_t used = LatencyHistogram::BUCKET_COUNT;
+        while (used > 0 && histogram.getBucket(used - 1) == 0)
+        {
+            used--;
+        }
+
+        JsonArray buckets = stageObj.createNestedArray("buckets");
+        for (size_t b = 0; b < used; b++)
+        {
+            buckets.add(histogram.getBucket(b));
+        }
+    }
+
+    String result;
+    serializeJson(doc, result);
+    return result;
+}
+
+// Adding table row with histogram statistics
+void HTMLGenerator::addHistogramRow(String &html, const char *name, const LatencyHistogram &histogram)
+{
+    html += "<tr><td>" + String(name) + "</td>";
+    html += "<td>" + String(histogram.getCount()) + "</td>";
+    html += "<td>" + String(histogram.getMin()) + "</td>";
+    html += "<td>" + String(histogram.getAverage()) + "</td>";
+    html += "<td>" + String(histogram.getPercentile(99)) + "</td>";
+    html += "<td>" + String(histogram.getMax()) + "</td></tr>";
+}
+
+// Generating diagnostics page
+String HTMLGenerator::generateDiagnosticsPage(const SensorManager &sensorManager, const HttpForwarder *forwarder,
+                                              const LoRaProtocol *protocol)
+{
+    String html;
+
+    // Adding header
+    addHtmlHeader(html, "Diagnostics");
+
+    // Main loop overview
+    const LatencyHistogram &iterations = LoopProfiler::getIterations();
+
+    html += "<div class='card'>";
+    html += "<h2>Main Loop</h2>";
+    html += "<p><strong>Iterations:</strong> " + String(iterations.getCount()) + "</p>";
+    html += "<p><strong>Stalled iterations:</strong> " + String(LoopProfiler::getStalledIterations()) +
+            " (longer than " + String(LOOP_STALL_BUDGET) + " ms)</p>";
+    html += "<p><strong>Watchdog warnings:</strong> " + String(LoopProfiler::getWatchdogWarnings()) +
+            " (stage ending after " + String(WDT_TIMEOUT * 1000UL * LOOP_WDT_WARNING_PERCENT / 100) + " ms of " +
+            String(WDT_TIMEOUT * 1000) + " ms timeout)</p>";
+
+    if (LoopProfiler::getWatchdogWarnings() > 0)
+    {
+        html += "<p><strong>Last warning:</strong> stage " +
+                String(LoopProfiler::getStageName(LoopProfiler::getWatchdogWarningStage())) + ", " +
+                String(LoopProfiler::getWatchdogWarningElapsed()) + " ms since watchdog reset</p>";
+    }
+
+    if (LoopProfiler::getWatchdogResetStage() != LoopStage::COUNT)
+    {
+        html += "<p><strong>Last reset by watchdog in stage:</strong> " +
+                String(LoopProfiler::getStageName(LoopProfiler::getWatchdogResetStage())) + "</p>";
+    }
+
+    html += "<a href='/diagnostics' class='btn'>Refresh</a> ";
+    html += "<a href='/diagnostics/reset' class='btn btn-delete'>Reset Statistics</a>";
+    html += "</div>";
+
+    // Loop stage durations
+    html += "<div class='card'>";
+    html += "<h2>Loop Stages</h2>";
+    html += "<table>";
+    html += "<tr><th>Stage</th><th>Count</th><th>Min (us)</th><th>Avg (us)</th><th>P99 (us)</th><th>Max (us)</th></tr>";
+
+    for (size_t i = 0; i < static_cast<size_t>(LoopStage::COUNT); i++)
+    {
+        LoopStage stage = static_cast<LoopStage>(i);
+        addHistogramRow(html, LoopProfiler::getStageName(stage), LoopProfiler::getStage(stage));
+    }
+    addHistogramRow(html, "iteration", iterations);
+
+    html += "</table>";
+    html += "<p>P99 is the upper bound of a power-of-two bucket.</p>";
+    html += "</div>";
+
+    // Packet latency
+    html += "<div class='card'>";
+    html += "<h2>Packet Latency</h2>";
+    html += "<table>";
+    html += "<tr><th>Stage</th><th>Count</th><th>Min (us)</th><th>Avg (us)</th><th>P99 (us)</th><th>Max (us)</th></tr>";
+
+    for (size_t i = 0; i < static_cast<size_t>(LatencyStage::COUNT); i++)
+    {
+        LatencyStage stage = static_cast<LatencyStage>(i);
+        addHistogramRow(html, PacketLatency::getStageName(stage), PacketLatency::get(stage));
+    }
+
+    html += "</table>";
+    html += "<a href='/api/latency/reset' class='btn btn-delete'>Reset Packet Latency</a>";
+    html += "</div>";
+
+    // Radio receive queues
+    if (protocol != nullptr)
+    {
+        html += "<div class='card'>";
+        html += "<h2>Radio</h2>";
+        html += "<table>";
+        html += "<tr><td>Queued frames</td><td>" + String(protocol->getQueuedFrames()) + " of " +
+                String(LORA_RX_RING_SIZE) + "</td></tr>";
+        html += "<tr><td>Dropped frames (receive queue full)</td><td>" + String(protocol->getDroppedFrames()) + "</td></tr>";
+        html += "<tr><td>Dropped updates (main loop busy)</td><td>" + String(protocol->getDroppedUpdates()) + "</td></tr>";
+        html += "</table>";
+        html += "</div>";
+    }
+
+    // HTTP forwarding queue
+    if (forwarder != nullptr)
+    {
+        const LatencyHistogram &latency = PacketLatency::get(LatencyStage::HTTP_FORWARD);
+
+        html += "<div class='card'>";
+        html += "<h2>HTTP Forwarding</h2>";
+        html += "<table>";
+        html += "<tr><td>Queue depth</td><td>" + String(forwarder->getQueueDepth()) + " (max " +
+                String(forwarder->getMaxQueueDepth()) + " of " + String(HTTP_FORWARD_QUEUE_SIZE) + ")</td></tr>";
+        html += "<tr><td>Queued</td><td>" + String(forwarder->getQueuedJobs()) + "</td></tr>";
+        html += "<tr><td>Coalesced</td><td>" + String(forwarder->getCoalescedJobs()) + "</td></tr>";
+        html += "<tr><td>Dropped (queue full)</td><td>" + String(forwarder->getDroppedJobs()) + "</td></tr>";
+        html += "<tr><td>Dropped (stale)</td><td>" + String(forwarder->getStaleJobs()) + "</td></tr>";
+        html += "<tr><td>Skipped (backoff)</td><td>" + String(forwarder->getBackoffSkips()) + "</td></tr>";
+        html += "<tr><td>Sent</td><td>" + String(forwarder->getSentRequests()) + "</td></tr>";
+        html += "<tr><td>Failed</td><td>" + String(forwarder->getFailedRequests()) + "</td></tr>";
+        html += "<tr><td>Latency avg / p99 / max</td><td>" + String(latency.getAverage() / 1000) + " / " +
+                String(latency.getPercentile(99) / 1000) + " / " + String(latency.getMax() / 1000) + " ms</td></tr>";
+        html += "</table>";
+        html += "</div>";
+    }
+
+    // Log sinks
+    html += "<div class='card'>";
+    html += "<h2>Logging</h2>";
+    html += "<table>";
+    html += "<tr><td>Stored logs</td><td>" + String(Logger::getLogCount()) + " in " +
+            String(Logger::getArenaSize() / 1024) + " KB" + (Logger::isUsingPSRAM() ? " (PSRAM)" : "") + "</td></tr>";
+    for (size_t i = 0; i < Logger::getSinkCount(); i++)
+    {
+        html += "<tr><td>" + String(Logger::getSinkName(i)) + "</td><td>" + String(Logger::getSinkWritten(i)) +
+                " written, " + String(Logger::getSinkDropped(i)) + " dropped (sink too slow)</td></tr>";
+    }
+    html += "</table>";
+    html += "</div>";
+
+    // Sensor state persistence
+    html += "<div class='card'>";
+    html += "<h2>Storage</h2>";
+    html += "<table>";
+    html += "<tr><td>Sensor file saves</td><td>" + String(sensorManager.getSaveCount()) + "</td></tr>";
+    html += "<tr><td>Sensor file load</td><td>" + String(sensorManager.getLoadTime()) + " us</td></tr>";
+    html += "<tr><td>Sensor slots</td><td>" + String(sensorManager.getSensorCount()) + " used, " +
+            String(sensorManager.getCapacity()) + " allocated (" + String(sensorManager.getMemoryUsage() / 1024) + " KB)</td></tr>";
+    html += "<tr><td>Bytes written</td><td>" + String((uint32_t)sensorManager.getBytesWritten()) + "</td></tr>";
+    html += "<tr><td>Bytes written per hour</td><td>" + String(sensorManager.getBytesWrittenPerHour()) + "</td></tr>";
+    html += "<tr><td>Unsaved changes</td><td>" + String(sensorManager.hasUnsavedChanges() ? "Yes" : "No") + "</td></tr>";
+    const StateJournal &journal = sensorManager.getStateJournal();
+    html += "<tr><td>Journal records</td><td>" + String(journal.getJournalRecords()) + " (" +
+            String(journal.getAppendedRecords()) + " appended)</td></tr>";
+    html += "<tr><td>Journal compactions</td><td>" + String(journal.getCompactions()) + "</td></tr>";
+    html += "<tr><td>Boot replay</td><td>" + String(journal.getReplayedRecords()) + " records in " +
+            String(journal.getReplayTime()) + " us</td></tr>";
+    html += "<tr><td>Corrupted records</td><td>" + String(journal.getCorruptedRecords()) + "</td></tr>";
+    html += "</table>";
+    html += "</div>";
+
+    // Adding footer
+    addHtmlFooter(html);
+
+    return html;
+}
+
+// Generating JSON with main loop profile
+String HTMLGenerator::generateDiagnosticsJson(const SensorManager &sensorManager, const HttpForwarder *forwarder,
+                                              const LoRaProtocol *protocol)
+{
+    const size_t stageCount = static_cast<size_t>(LoopStage::COUNT);
+    const size_t capacity = JSON_OBJECT_SIZE(12) + JSON_ARRAY_SIZE(stageCount) +
+                            (stageCount + 1) * JSON_OBJECT_SIZE(7) + JSON_OBJECT_SIZE(12) + JSON_OBJECT_SIZE(4) +
+                            JSON_OBJECT_SIZE(3) + JSON_OBJECT_SIZE(3) + JSON_ARRAY_SIZE(LOG_MAX_SINKS) + LOG_MAX_SINKS * JSON_OBJECT_SIZE(3) + 256;
+
+    DynamicJsonDocument doc(capacity);
+
+    doc["unit"] = "us";
+    doc["stallBudget"] = LOOP_STALL_BUDGET * 1000UL;
+    doc["stalledIterations"] = LoopProfiler::getStalledIterations();
+    doc["watchdogWarnings"] = LoopProfiler::getWatchdogWarnings();
+
+    if (LoopProfiler::getWatchdogWarnings() > 0)
+    {
+        JsonObject warning = doc.createNestedObject("lastWatchdogWarning");
+        warning["stage"] = LoopProfiler::getStageName(LoopProfiler::getWatchdogWarningStage());
+        warning["elapsedMs"] = LoopProfiler::getWatchdogWarningElapsed();
+    }
+
+    if (LoopProfiler::getWatchdogResetStage() != LoopStage::COUNT)
+    {
+        doc["watchdogResetStage"] = LoopProfiler::getStageName(LoopProfiler::getWatchdogResetStage());
+    }
+
+    const LatencyHistogram &iterations = LoopProfiler::getIterations();
+    JsonObject iterationObj = doc.createNestedObject("iteration");
+    iterationObj["count"] = iterations.getCount();
+    iterationObj["min"] = iterations.getMin();
+    iterationObj["avg"] = iterations.getAverage();
+    iterationObj["p99"] = iterations.getPercentile(99);
+    iterationObj["max"] = iterations.getMax();
+
+    JsonArray stagesArray = doc.createNestedArray("stages");
+
+    for (size_t i = 0; i < stageCount; i++)
+    {
+        LoopStage stage = static_cast<LoopStage>(i);
+        const LatencyHistogram &histogram = LoopProfiler::getStage(stage);
+
+        JsonObject stageObj = stagesArray.createNestedObject();
+        stageObj["stage"] = LoopProfiler::getStageName(stage);
+        stageObj["count"] = histogram.getCount();
+        stageObj["min"] = histogram.getMin();
+        stageObj["avg"] = histogram.getAverage();
+        stageObj["p99"] = histogram.getPercentile(99);
+        stageObj["max"] = histogram.getMax();
+    }
+
+    if (protocol != nullptr)
+    {
+        JsonObject radioObj = doc.createNestedObject("radio");
+        radioObj["queuedFrames"] = protocol->getQueuedFrames();
+        radioObj["droppedFrames"] = protocol->getDroppedFrames();
+        radioObj["droppedUpdates"] = protocol->getDroppedUpdates();
+    }
+
+    if (forwarder != nullptr)
+    {
+        const LatencyHistogram &latency = PacketLatency::get(LatencyStage::HTTP_FORWARD);
+
+        JsonObject forwardObj = doc.createNestedObject("httpForward");
+        forwardObj["queueDepth"] = forwarder->getQueueDepth();
+        forwardObj["maxQueueDepth"] = forwarder->getMaxQueueDepth();
+        forwardObj["queued"] = forwarder->getQueuedJobs();
+        forwardObj["coalesced"] = forwarder->getCoalescedJobs();
+        forwardObj["dropped"] = forwarder->getDroppedJobs();
+        forwardObj["stale"] = forwarder->getStaleJobs();
+        forwardObj["backoffSkipped"] = forwarder->getBackoffSkips();
+        forwardObj["sent"] = forwarder->getSentRequests();
+        forwardObj["failed"] = forwarder->getFailedRequests();
+        forwardObj["latencyAvg"] = latency.getAverage();
+        forwardObj["latencyP99"] = latency.getPercentile(99);
+        forwardObj["latencyMax"] = latency.getMax();
+    }
+
+    JsonObject logObj = doc.createNestedObject("logging");
+    logObj["stored"] = Logger::getLogCount();
+    logObj["arenaSize"] = Logger::getArenaSize();
+    JsonArray sinksArray = logObj.createNestedArray("sinks");
+    for (size_t i = 0; i < Logger::getSinkCount(); i++)
+    {
+        JsonObject sinkObj = sinksArray.createNestedObject();
+        sinkObj["name"] = Logger::getSinkName(i);
+        sinkObj["written"] = Logger::getSinkWritten(i);
+        sinkObj["dropped"] = Logger::getSinkDropped(i);
+    }
+
+    JsonObject storageObj = doc.createNestedObject("storage");
+    storageObj["saves"] = sensorManager.getSaveCount();
+    storageObj["loadTime"] = sensorManager.getLoadTime();
+    storageObj["sensorSlots"] = sensorManager.getSensorCount();
+    storageObj["allocatedSlots"] = sensorManager.getCapacity();
+    storageObj["slotMemory"] = sensorManager.getMemoryUsage();
+    storageObj["bytesWritten"] = sensorManager.getBytesWritten();
+    storageObj["bytesPerHour"] = sensorManager.getBytesWrittenPerHour();
+    storageObj["unsavedChanges"] = sensorManager.hasUnsavedChanges();
+
+    const StateJournal &journal = sensorManager.getStateJournal();
+    JsonObject journalObj = storageObj.createNestedObject("journal");
+    journalObj["records"] = journal.getJournalRecords();
+    journalObj["appended"] = journal.getAppendedRecords();
+    journalObj["compactions"] = journal.getCompactions();
+    journalObj["corrupted"] = journal.getCorruptedRecords();
+    journalObj["replayedRecords"] = journal.getReplayedRecords();
+    journalObj["replayTime"] = journal.getReplayTime();
+
+    String result;
+    serializeJson(doc, result);
+    return result;
+}
+
 // Generating API page
-String HTMLGenerator::generateAPIPage(const std::vector<SensorData> &sensors)
+String HTMLGenerator::generateAPIPage(const SensorSnapshot &snapshot)
 {
     String html;
 
@@ -1382,6 +1861,9 @@ String HTMLGenerator::generateAPIPage(const std::vector<SensorData> &sensors)
     html += "<tr><td><code>/api?format=json</code></td><td>Returns all sensor data in JSON format</td></tr>";
     html += "<tr><td><code>/api?format=csv</code></td><td>Returns sensor data in CSV format</td></tr>";
     html += "<tr><td><code>/api?sensor=XXXX</code></td><td>Returns data for a specific sensor by serial number</td></tr>";
+    html += "<tr><td><code>/api/latency</code></td><td>Returns packet latency histograms (interrupt, decode, sensor update, HTTP forward, MQTT) in JSON format</td></tr>";
+    html += "<tr><td><code>/api/latency/reset</code></td><td>Clears packet latency histograms</td></tr>";
+    html += "<tr><td><code>/api/diagnostics</code></td><td>Returns main loop stage durations, stalls, watchdog warnings, HTTP forwarding and storage statistics in JSON format</td></tr>";
     html += "</table>";
 
     html += "<h3>Example JSON Response</h3>";
@@ -1393,43 +1875,43 @@ String HTMLGenerator::generateAPIPage(const std::vector<SensorData> &sensors)
     html += "  \"sensors\": [\n";
 
     // Generating sensor data example
-    if (!sensors.empty())
+    if (!snapshot.empty())
     {
-        const auto &sensor = sensors[0];
+        SensorView sensor = snapshot[0];
         html += "    {\n";
-        html += "      \"name\": \"" + sensor.name + "\",\n";
-        html += "      \"type\": " + String(static_cast<uint8_t>(sensor.deviceType)) + ",\n";
-        html += "      \"typeName\": \"" + String(sensor.getTypeInfo().name) + "\",\n";
-        html += "      \"serialNumber\": \"" + String(sensor.serialNumber, HEX) + "\",\n";
-        html += "      \"lastSeen\": " + (sensor.lastSeen > 0 ? String((millis() - sensor.lastSeen) / 1000) : "-1") + ",\n";
+        html += "      \"name\": \"" + sensor.config().name + "\",\n";
+        html += "      \"type\": " + String(static_cast<uint8_t>(sensor->deviceType)) + ",\n";
+        html += "      \"typeName\": \"" + String(sensor->getTypeInfo().name) + "\",\n";
+        html += "      \"serialNumber\": \"" + String(sensor->serialNumber, HEX) + "\",\n";
+        html += "      \"lastSeen\": " + (sensor->lastSeen > 0 ? String((millis() - sensor->lastSeen) / 1000) : "-1") + ",\n";
 
-        if (sensor.hasTemperature())
+        if (sensor->hasTemperature())
         {
-            html += "      \"temperature\": " + String(sensor.temperature, 2) + ",\n";
+            html += "      \"temperature\": " + sensor->getTemperatureString() + ",\n";
         }
 
-        if (sensor.hasHumidity())
+        if (sensor->hasHumidity())
         {
-            html += "      \"humidity\": " + String(sensor.humidity, 2) + ",\n";
+            html += "      \"humidity\": " + sensor->getHumidityString() + ",\n";
         }
 
-        if (sensor.hasPressure())
+        if (sensor->hasPressure())
         {
-            html += "      \"pressure\": " + String(sensor.pressure, 2) + ",\n";
+            html += "      \"pressure\": " + sensor->getPressureString() + ",\n";
         }
 
-        if (sensor.hasPPM())
+        if (sensor->hasPPM())
         {
-            html += "      \"ppm\": " + String(sensor.ppm, 0) + ",\n";
+            html += "      \"ppm\": " + sensor->getPPMString() + ",\n";
         }
 
-        if (sensor.hasLux())
+        if (sensor->hasLux())
         {
-            html += "      \"lux\": " + String(sensor.lux, 1) + ",\n";
+            html += "      \"lux\": " + sensor->getLuxString() + ",\n";
         }
 
-        html += "      \"batteryVoltage\": " + String(sensor.batteryVoltage, 2) + ",\n";
-        html += "      \"rssi\": " + String(sensor.rssi) + "\n";
+        html += "      \"batteryVoltage\": " + sensor->getBatteryVoltageString() + ",\n";
+        html += "      \"rssi\": " + String(sensor->rssi) + "\n";
         html += "    }\n";
     }
     else
@@ -1442,7 +1924,7 @@ String HTMLGenerator::generateAPIPage(const std::vector<SensorData> &sensors)
         html += "      \"lastSeen\": 300,\n";
         html += "      \"temperature\": 21.50,\n";
         html += "      \"humidity\": 45.20,\n";
-        html += "      \"pressure\": 1013.20,\n";
+        html += "      \"pressure\": 1013.2,\n";
         html += "      \"batteryVoltage\": 3.82,\n";
         html += "      \"rssi\": -72\n";
         html += "    }\n";
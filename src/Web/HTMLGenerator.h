@@ -26,6 +26,12 @@
 #include "../Data/SensorData.h"
 #include "../Data/Logging.h"
 
+class LatencyHistogram;
+class HttpForwarder;
+class LoRaProtocol;
+class SensorManager;
+class LogFileSink;
+
 /**
  * Class for generating HTML content
  *
@@ -61,6 +67,12 @@ private:
     // Add navigation
     static void addNavigation(String &html, const String &activePage);
 
+    // Add table row with histogram statistics
+    static void addHistogramRow(String &html, const char *name, const LatencyHistogram &histogram);
+
+    // Write JSON string with quotes and escapes
+    static void printJsonString(Print &out, const char *text);
+
 public:
     // Initialize generator
     static bool init(bool usePsram = true, size_t bufferSize = 32768);
@@ -69,7 +81,7 @@ public:
     static void deinit();
 
     // Generate home page
-    static String generateHomePage(const std::vector<SensorData> &sensors);
+    static String generateHomePage(const SensorSnapshot &snapshot);
 
     // Generate configuration page
     static String generateConfigPage(const String &ssid, const String &password, bool configMode, const String &ip, const String &timezone);
@@ -78,8 +90,8 @@ public:
     static String generateMqttPage(const String &host, int port, const String &user, const String &password, bool enabled, bool tls,
                                     const String &prefix, bool haEnabled, String &haPrefix);
 
-    // Generate sensor list page
-    static String generateSensorsPage(const std::vector<SensorData> &sensors);
+    // Generate sensor list page (edit and delete links use slot indices of the snapshot)
+    static String generateSensorsPage(const SensorSnapshot &snapshot);
 
     // Generate sensor add page
     static String generateSensorAddPage();
@@ -87,18 +99,33 @@ public:
     // Generate sensor edit page
     static String generateSensorEditPage(const SensorData &sensor, int index);
 
-    // Generate logs page
-    static String generateLogsPage(const LogEntry *logs, size_t logCount, LogLevel currentLevel);
+    // Generate logs page from logs stored by Logger (fileSink may be nullptr)
+    static String generateLogsPage(LogLevel currentLevel, const LogFileSink *fileSink, bool fileEnabled);
+
+    // Write JSON with stored logs from sequence number since on, or from the oldest one
+    // when since is not given (oldest first, at most LOG_API_MAX_RECORDS), and the boot id
+    static void generateLogsJson(Print &out, bool hasSince, uint32_t since);
 
     // Generate API page
-    static String generateAPIPage(const std::vector<SensorData> &sensors);
+    static String generateAPIPage(const SensorSnapshot &snapshot);
 
     // Generate JSON for API
-    static String generateAPIJson(const std::vector<SensorData> &sensors);
+    static String generateAPIJson(const SensorSnapshot &snapshot);
+
+    // Generate JSON with packet latency histograms
+    static String generateLatencyJson();
+
+    // Generate diagnostics page (main loop profile, watchdog, packet latency, radio queues, HTTP forwarding, storage)
+    static String generateDiagnosticsPage(const SensorManager &sensorManager, const HttpForwarder *forwarder,
+                                          const LoRaProtocol *protocol);
+
+    // Generate JSON with main loop profile, radio queues, HTTP forwarding and storage statistics
+    static String generateDiagnosticsJson(const SensorManager &sensorManager, const HttpForwarder *forwarder,
+                                          const LoRaProtocol *protocol);
 
     // Optimized versions using buffer
-    static void generateSensorTable(char *buffer, size_t &maxLen, const std::vector<SensorData> &sensors);
-    static void generateLogTable(char *buffer, size_t &maxLen, const LogEntry *logs, size_t logCount);
+    static void generateSensorTable(char *buffer, size_t &maxLen, const SensorSnapshot &snapshot);
+    static void generateLogTable(char *buffer, size_t &maxLen, uint32_t &nextSequence);
 
     // Additional helper methods
     static String getWifiNetworkOptions(const String &currentSSID);
@@ -20,6 +20,9 @@ void OTAServer::process() {
 
 void OTAServer::onOTAStart() {
     logger.info("OTA update started!");
+    if (beforeReboot) {
+        beforeReboot();
+    }
 }
 
 void OTAServer::onOTAProgress(size_t current, size_t final) {
@@ -32,6 +35,9 @@ void OTAServer::onOTAProgress(size_t current, size_t final) {
 void OTAServer::onOTAEnd(bool success) {
     if (success) {
         logger.info("OTA update finished successfully!");
+        if (beforeReboot) {
+            beforeReboot();
+        }
     } else {
         logger.error("There was an error during OTA update!");
     }
@@ -23,6 +23,7 @@
 
 #include <ESPAsyncWebServer.h>
 #include <Arduino.h>
+#include <functional>
 #include "../Data/Logging.h"
 
 
@@ -31,6 +32,7 @@ class OTAServer {
         Logger &logger;             // Reference to logger
         AsyncWebServer &server;     // Reference to web server
         unsigned long ota_progress_millis = 0;
+        std::function<void()> beforeReboot; // Called before flashing and before automatic reboot
 
         void onOTAStart();
         void onOTAProgress(size_t current, size_t final);
@@ -45,4 +47,7 @@ class OTAServer {
 
         void init();
         void process();
+
+        // Set function saving pending state before the device reboots
+        void onBeforeReboot(std::function<void()> callback) { beforeReboot = callback; }
 };
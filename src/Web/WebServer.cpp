@@ -26,13 +26,16 @@
 #include <ArduinoJson.h>
 #include <LittleFS.h>
 #include "../config.h"
+#include "../Data/PacketLatency.h"
+#include "../Data/LoopProfiler.h"
 
 // Constructor
 WebPortal::WebPortal(SensorManager &sensors, Logger &log, String &ssid, String &password,
                      bool &config_mode, ConfigManager &config, String &tz)
     : server(HTTP_PORT), sensorManager(sensors), logger(log), isAPMode(false),
       wifiSSID(ssid), wifiPassword(password), configMode(config_mode),
-      timezone(tz), configManager(config), mqttManager(nullptr)
+      timezone(tz), configManager(config), mqttManager(nullptr), httpForwarder(nullptr),
+      loraProtocol(nullptr), logFileSink(nullptr)
 {
 }
 
@@ -81,6 +84,7 @@ bool WebPortal::init()
 
     otaServer = new OTAServer(logger, server);
     otaServer->init();
+    otaServer->onBeforeReboot([this]() { sensorManager.flush(); });
 
     // Create task on core 0 for DNS and other processing
     // xTaskCreatePinnedToCore(
@@ -173,18 +177,30 @@ void WebPortal::setupRoutes()
         server.on("/sensors/edit", HTTP_GET, std::bind(&WebPortal::handleSensorEdit, this, std::placeholders::_1));
         server.on("/sensors/update", HTTP_POST, std::bind(&WebPortal::handleSensorEditPost, this, std::placeholders::_1));
         server.on("/sensors/delete", HTTP_GET, std::bind(&WebPortal::handleSensorDelete, this, std::placeholders::_1));
+        server.on("/sensors/export", HTTP_GET, std::bind(&WebPortal::handleSensorExport, this, std::placeholders::_1));
+        server.on("/sensors/import", HTTP_POST, std::bind(&WebPortal::handleSensorImport, this, std::placeholders::_1));
         server.on("/sensors", HTTP_GET, std::bind(&WebPortal::handleSensors, this, std::placeholders::_1));
 
         // Logs
         server.on("/logs/clear", HTTP_GET, std::bind(&WebPortal::handleLogsClear, this, std::placeholders::_1));
         server.on("/logs/level", HTTP_POST, std::bind(&WebPortal::handleLogLevel, this, std::placeholders::_1));
+        server.on("/logs/file", HTTP_POST, std::bind(&WebPortal::handleLogFile, this, std::placeholders::_1));
+        server.on("/logs/download", HTTP_GET, std::bind(&WebPortal::handleLogsDownload, this, std::placeholders::_1));
         server.on("/logs", HTTP_GET, std::bind(&WebPortal::handleLogs, this, std::placeholders::_1));
 
         // MQTT
         server.on("/mqtt", HTTP_GET, std::bind(&WebPortal::handleMqtt, this, std::placeholders::_1));
         server.on("/mqtt", HTTP_POST, std::bind(&WebPortal::handleMqttPost, this, std::placeholders::_1));
 
+        // Diagnostics
+        server.on("/diagnostics/reset", HTTP_GET, std::bind(&WebPortal::handleDiagnosticsReset, this, std::placeholders::_1));
+        server.on("/diagnostics", HTTP_GET, std::bind(&WebPortal::handleDiagnostics, this, std::placeholders::_1));
+
         // API
+        server.on("/api/logs", HTTP_GET, std::bind(&WebPortal::handleLogsJson, this, std::placeholders::_1));
+        server.on("/api/diagnostics", HTTP_GET, std::bind(&WebPortal::handleDiagnosticsJson, this, std::placeholders::_1));
+        server.on("/api/latency/reset", HTTP_GET, std::bind(&WebPortal::handleLatencyReset, this, std::placeholders::_1));
+        server.on("/api/latency", HTTP_GET, std::bind(&WebPortal::handleLatency, this, std::placeholders::_1));
         server.on("/api", HTTP_GET, std::bind(&WebPortal::handleAPI, this, std::placeholders::_1));
 
         // Reboot
@@ -283,11 +299,11 @@ void WebPortal::handleRoot(AsyncWebServerRequest *request)
         return;
     }
 
-    // Get list of sensors
-    std::vector<SensorData> sensorsList = sensorManager.getActiveSensors();
+    // Shared copy of sensors, the sensor lock is not held while the page is built
+    SensorSnapshotPtr snapshot = sensorManager.getSnapshot();
 
     // Generate HTML
-    String html = HTMLGenerator::generateHomePage(sensorsList);
+    String html = HTMLGenerator::generateHomePage(*snapshot);
 
     // Send response
     request->send(200, "text/html", html);
@@ -359,6 +375,10 @@ void WebPortal::handleConfigPost(AsyncWebServerRequest *request)
             logger.info("Configuration saved to file system");
         }
 
+        // Save pending sensor state and write pending logs
+        sensorManager.flush();
+        logger.drain();
+
         // Restart ESP32 after 1 second
         delay(1000);
         ESP.restart();
@@ -375,11 +395,11 @@ void WebPortal::handleSensors(AsyncWebServerRequest *request)
 {
     logger.debug("HTTP request: GET /sensors");
 
-    // Get list of sensors
-    std::vector<SensorData> sensorsList = sensorManager.getActiveSensors();
+    // Shared copy of sensors, the sensor lock is not held while the page is built
+    SensorSnapshotPtr snapshot = sensorManager.getSnapshot();
 
     // Generate HTML
-    String html = HTMLGenerator::generateSensorsPage(sensorsList);
+    String html = HTMLGenerator::generateSensorsPage(*snapshot);
 
     // Send response
     request->send(200, "text/html", html);
@@ -479,26 +499,13 @@ void WebPortal::handleSensorAddPost(AsyncWebServerRequest *request)
 
         if (sensorIndex >= 0)
         {
-            // Get added sensor and update additional data
-            SensorData *sensor = sensorManager.getSensor(sensorIndex);
-            if (sensor)
+            // Update additional data of added sensor
+            if (sensorManager.updateSensorConfig(sensorIndex, name, deviceType, serialNumber, deviceKey,
+                                                 customUrl, altitude, tempCorr, humCorr, pressCorr, ppmCorr, luxCorr,
+                                                 windSpeedCorr, windDirCorr, rainAmountCorr, rainRateCorr))
             {
-                sensor->customUrl = customUrl;
-                sensor->altitude = altitude;
-
-                // Set correction values
-                sensor->temperatureCorrection = tempCorr;
-                sensor->humidityCorrection = humCorr;
-                sensor->pressureCorrection = pressCorr;
-                sensor->ppmCorrection = ppmCorr;
-                sensor->luxCorrection = luxCorr;
-                sensor->windSpeedCorrection = windSpeedCorr;
-                sensor->windDirectionCorrection = windDirCorr;
-                sensor->rainAmountCorrection = rainAmountCorr;
-                sensor->rainRateCorrection = rainRateCorr;
-
+                // Saved by the user - written right away instead of after the save delay
                 sensorManager.saveSensors(true);
-
                 logger.info("Added new sensor: " + name + " (SN: " + serialNumberHex + ")");
 
                 // If MQTT is enabled, publish discovery message
@@ -534,12 +541,12 @@ void WebPortal::handleSensorEdit(AsyncWebServerRequest *request)
         int index = request->getParam("index")->value().toInt();
 
         // Get sensor
-        const SensorData *sensor = sensorManager.getSensor(index);
+        SensorView sensor = sensorManager.getSensor(index);
 
         if (sensor && sensor->configured)
         {
             // Generate HTML
-            String html = HTMLGenerator::generateSensorEditPage(*sensor, index);
+            String html = HTMLGenerator::generateSensorEditPage(sensor.toSensorData(), index);
 
             // Send response
             request->send(200, "text/html", html);
@@ -637,6 +644,7 @@ void WebPortal::handleSensorEditPost(AsyncWebServerRequest *request)
 
         if (success)
         {
+            sensorManager.saveSensors(true);
             logger.info("Updated sensor: " + name + " (SN: " + serialNumberHex + ")");
 
             // If MQTT is enabled, publish discovery message
@@ -673,11 +681,11 @@ void WebPortal::handleSensorDelete(AsyncWebServerRequest *request)
         int index = request->getParam("index")->value().toInt();
 
         // Get sensor
-        const SensorData *sensor = sensorManager.getSensor(index);
+        SensorView sensor = sensorManager.getSensor(index);
 
         if (sensor && sensor->configured)
         {
-            String name = sensor->name;
+            String name = sensor.config().name;
             uint32_t serialNumber = sensor->serialNumber;
 
             // Delete sensor
@@ -685,6 +693,7 @@ void WebPortal::handleSensorDelete(AsyncWebServerRequest *request)
 
             if (success)
             {
+                sensorManager.saveSensors(true);
                 logger.info("Deleted sensor: " + name + " (SN: " + String(serialNumber, HEX) + ")");
 
                 // If MQTT is enabled, remove discovery message
@@ -709,17 +718,44 @@ void WebPortal::handleSensorDelete(AsyncWebServerRequest *request)
     request->redirect("/sensors");
 }
 
+// Download sensor configuration as JSON
+void WebPortal::handleSensorExport(AsyncWebServerRequest *request)
+{
+    logger.debug("HTTP request: GET /sensors/export");
+
+    AsyncWebServerResponse *response = request->beginResponse(200, "application/json", sensorManager.exportSensorsJson());
+    response->addHeader("Content-Disposition", "attachment; filename=sensors.json");
+    request->send(response);
+}
+
+// Replace sensor configuration with uploaded JSON
+void WebPortal::handleSensorImport(AsyncWebServerRequest *request)
+{
+    logger.debug("HTTP request: POST /sensors/import");
+
+    if (request->hasParam("json", true))
+    {
+        if (!sensorManager.importSensorsJson(request->getParam("json", true)->value()))
+        {
+            logger.warning("Sensor import failed, configuration unchanged");
+        }
+        else if (mqttManager && mqttManager->isConnected())
+        {
+            mqttManager->publishDiscovery();
+        }
+    }
+
+    // Redirect to sensors list
+    request->redirect("/sensors");
+}
+
 // Logs page
 void WebPortal::handleLogs(AsyncWebServerRequest *request)
 {
     logger.debug("HTTP request: GET /logs");
 
-    // Get logs
-    size_t logCount = 0;
-    const LogEntry *logs = logger.getLogs(logCount);
-
-    // Generate HTML
-    String html = HTMLGenerator::generateLogsPage(logs, logCount, logger.getLogLevel());
+    // Generate HTML (reads logs stored by logger)
+    String html = HTMLGenerator::generateLogsPage(logger.getLogLevel(), logFileSink, configManager.logFileEnabled);
 
     // Send response
     request->send(200, "text/html", html);
@@ -759,6 +795,77 @@ void WebPortal::handleLogLevel(AsyncWebServerRequest *request)
     request->redirect("/logs");
 }
 
+// Enable or disable log files
+void WebPortal::handleLogFile(AsyncWebServerRequest *request)
+{
+    logger.debug("HTTP request: POST /logs/file");
+
+    bool enabled = request->hasParam("enabled", true);
+    if (logFileSink != nullptr)
+    {
+        if (enabled)
+        {
+            // Log files failed at boot (file system full or broken) - retry before enabling them
+            if (!logFileSink->isReady() && !logFileSink->init())
+            {
+                request->send(500, "text/plain", "Failed to initialize log files");
+                return;
+            }
+
+            // Stored logs went to the files already if they were enabled before
+            if (!logger.addSink(logFileSink, logFileSink->getRecordsWritten() == 0))
+            {
+                request->send(500, "text/plain", "Too many log sinks");
+                return;
+            }
+        }
+        else
+        {
+            logger.removeSink(logFileSink);
+        }
+        configManager.setLogFileEnabled(enabled);
+        logger.info(String("Log files ") + (enabled ? "enabled" : "disabled"));
+    }
+
+    // Redirect back to logs page
+    request->redirect("/logs");
+}
+
+// Download log files, streamed in chunks without loading them into memory
+void WebPortal::handleLogsDownload(AsyncWebServerRequest *request)
+{
+    logger.debug("HTTP request: GET /logs/download");
+
+    if (logFileSink == nullptr)
+    {
+        request->send(404, "text/plain", "Log files are not available");
+        return;
+    }
+
+    // Files are read as they are now - the drain task writes the buffered
+    // records meanwhile, so file I/O does not run on the web server task
+    logger.requestSync();
+
+    // Position in log files, shared by the chunk callbacks of this response
+    struct Position
+    {
+        uint32_t index;
+        size_t offset;
+    };
+    std::shared_ptr<Position> position = std::make_shared<Position>();
+    position->index = logFileSink->getFirstIndex();
+    position->offset = 0;
+
+    LogFileSink *sink = logFileSink;
+    AsyncWebServerResponse *response = request->beginChunkedResponse("text/plain",
+        [sink, position](uint8_t *buffer, size_t maxLen, size_t) -> size_t
+        {
+            return sink->read(position->index, position->offset, buffer, maxLen);
+        });
+    response->addHeader("Content-Disposition", "attachment; filename=logs.txt");
+    request->send(response);
+}
+
 // MQTT Configuration Page
 void WebPortal::handleMqtt(AsyncWebServerRequest *request)
 {
@@ -848,33 +955,39 @@ void WebPortal::handleAPI(AsyncWebServerRequest *request)
     String sensorParam = request->hasParam("sensor") ? request->getParam("sensor")->value() : "";
 
     // Get list of sensors
-    std::vector<SensorData> sensorsList;
+    SensorSnapshotPtr snapshot;
 
     if (sensorParam.length() > 0)
     {
-        // Filter by specific sensor
+        // Filter by specific sensor - only that sensor is copied
+        std::shared_ptr<SensorSnapshotConfig> configuration = std::make_shared<SensorSnapshotConfig>();
+        std::shared_ptr<SensorSnapshot> filtered = std::make_shared<SensorSnapshot>(configuration);
         uint32_t serialNumber = strtoul(sensorParam.c_str(), NULL, 16);
         int sensorIndex = sensorManager.findSensorBySN(serialNumber);
 
         if (sensorIndex >= 0)
         {
-            const SensorData *sensor = sensorManager.getSensor(sensorIndex);
+            SensorView sensor = sensorManager.getSensor(sensorIndex);
             if (sensor && sensor->configured)
             {
-                sensorsList.push_back(*sensor);
+                filtered->readings.push_back(sensor.readings());
+                configuration->configs.push_back(sensor.config());
+                configuration->indices.push_back(sensorIndex);
             }
         }
+        snapshot = filtered;
     }
     else
     {
         // All sensors
-        sensorsList = sensorManager.getActiveSensors();
+        snapshot = sensorManager.getSnapshot();
     }
 
+
     if (format.equalsIgnoreCase("json"))
     {
         // JSON format
-        String jsonOutput = HTMLGenerator::generateAPIJson(sensorsList);
+        String jsonOutput = HTMLGenerator::generateAPIJson(*snapshot);
 
         // Send JSON response
         AsyncResponseStream *response = request->beginResponseStream("application/json");
@@ -888,30 +1001,31 @@ void WebPortal::handleAPI(AsyncWebServerRequest *request)
         AsyncResponseStream *response = request->beginResponseStream("text/csv");
         response->print("name,type,serialNumber,lastSeen,temperature,humidity,pressure,ppm,lux,batteryVoltage,rssi\r\n");
 
-        for (const auto &sensor : sensorsList)
+        for (size_t i = 0; i < snapshot->size(); i++)
         {
-            response->print(sensor.name);
+            SensorView sensor = (*snapshot)[i];
+            response->print(sensor.config().name);
             response->print(",");
-            response->print(static_cast<uint8_t>(sensor.deviceType));
+            response->print(static_cast<uint8_t>(sensor->deviceType));
             response->print(",");
-            response->print(String(sensor.serialNumber, HEX));
+            response->print(String(sensor->serialNumber, HEX));
             response->print(",");
-            response->print(sensor.lastSeen > 0 ? String((millis() - sensor.lastSeen) / 1000) : "-1");
+            response->print(sensor->lastSeen > 0 ? String((millis() - sensor->lastSeen) / 1000) : "-1");
             response->print(",");
 
-            response->print(sensor.hasTemperature() ? String(sensor.temperature, 2) : "");
+            response->print(sensor->hasTemperature() ? sensor->getTemperatureString() : "");
             response->print(",");
-            response->print(sensor.hasHumidity() ? String(sensor.humidity, 2) : "");
+            response->print(sensor->hasHumidity() ? sensor->getHumidityString() : "");
             response->print(",");
-            response->print(sensor.hasPressure() ? String(sensor.pressure, 2) : "");
+            response->print(sensor->hasPressure() ? sensor->getPressureString() : "");
             response->print(",");
-            response->print(sensor.hasPPM() ? String(sensor.ppm, 0) : "");
+            response->print(sensor->hasPPM() ? sensor->getPPMString() : "");
             response->print(",");
-            response->print(sensor.hasLux() ? String(sensor.lux, 1) : "");
+            response->print(sensor->hasLux() ? sensor->getLuxString() : "");
             response->print(",");
-            response->print(String(sensor.batteryVoltage, 2));
+            response->print(sensor->getBatteryVoltageString());
             response->print(",");
-            response->print(String(sensor.rssi));
+            response->print(String(sensor->rssi));
             response->print("\r\n");
         }
 
@@ -921,7 +1035,7 @@ void WebPortal::handleAPI(AsyncWebServerRequest *request)
     else if (format.equalsIgnoreCase("html"))
     {
         // HTML format (API documentation)
-        String html = HTMLGenerator::generateAPIPage(sensorsList);
+        String html = HTMLGenerator::generateAPIPage(*snapshot);
         request->send(200, "text/html", html);
     }
     else
@@ -931,6 +1045,72 @@ void WebPortal::handleAPI(AsyncWebServerRequest *request)
     }
 }
 
+// API for retrieving packet latency histograms
+void WebPortal::handleLatency(AsyncWebServerRequest *request)
+{
+    logger.debug("HTTP request: GET /api/latency");
+
+    AsyncResponseStream *response = request->beginResponseStream("application/json");
+    response->print(HTMLGenerator::generateLatencyJson());
+    response->addHeader(CORS_HEADER_NAME, CORS_HEADER_VALUE);
+    request->send(response);
+}
+
+// Clear packet latency histograms
+void WebPortal::handleLatencyReset(AsyncWebServerRequest *request)
+{
+    logger.debug("HTTP request: GET /api/latency/reset");
+
+    PacketLatency::reset();
+    logger.info("Packet latency histograms cleared");
+
+    request->send(200, "application/json", "{\"status\":\"ok\"}");
+}
+
+// Diagnostics page
+void WebPortal::handleDiagnostics(AsyncWebServerRequest *request)
+{
+    logger.debug("HTTP request: GET /diagnostics");
+
+    request->send(200, "text/html", HTMLGenerator::generateDiagnosticsPage(sensorManager, httpForwarder, loraProtocol));
+}
+
+// Clear main loop statistics
+void WebPortal::handleDiagnosticsReset(AsyncWebServerRequest *request)
+{
+    logger.debug("HTTP request: GET /diagnostics/reset");
+
+    LoopProfiler::reset();
+    logger.info("Main loop statistics cleared");
+
+    request->redirect("/diagnostics");
+}
+
+// API for retrieving main loop profile
+void WebPortal::handleDiagnosticsJson(AsyncWebServerRequest *request)
+{
+    logger.debug("HTTP request: GET /api/diagnostics");
+
+    AsyncResponseStream *response = request->beginResponseStream("application/json");
+    response->print(HTMLGenerator::generateDiagnosticsJson(sensorManager, httpForwarder, loraProtocol));
+    response->addHeader(CORS_HEADER_NAME, CORS_HEADER_VALUE);
+    request->send(response);
+}
+
+// Logs as JSON, only those from sequence number given by since on
+void WebPortal::handleLogsJson(AsyncWebServerRequest *request)
+{
+    // Not logged - the logs page polls this every few seconds
+
+    bool hasSince = request->hasParam("since");
+    uint32_t since = hasSince ? strtoul(request->getParam("since")->value().c_str(), NULL, 10) : 0;
+
+    AsyncResponseStream *response = request->beginResponseStream("application/json");
+    HTMLGenerator::generateLogsJson(*response, hasSince, since);
+    response->addHeader(CORS_HEADER_NAME, CORS_HEADER_VALUE);
+    request->send(response);
+}
+
 // Restart device
 void WebPortal::handleReboot(AsyncWebServerRequest *request)
 {
@@ -942,6 +1122,10 @@ void WebPortal::handleReboot(AsyncWebServerRequest *request)
                   "<body><h1>Rebooting</h1>"
                   "<p>The device is rebooting. You will be redirected in 10 seconds...</p></body></html>");
 
+    // Save pending sensor state and write pending logs
+    sensorManager.flush();
+    logger.drain();
+
     // Restart ESP32 after 500ms (to allow response to be sent)
     delay(500);
     ESP.restart();
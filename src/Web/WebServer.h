@@ -29,6 +29,9 @@
 #include "../Data/Logging.h"
 #include "../Storage/ConfigManager.h"
 #include "../Protocol/MQTTManager.h"
+#include "../Protocol/HttpForwarder.h"
+#include "../Protocol/LoRaProtocol.h"
+#include "../Storage/LogFileSink.h"
 #include "OTAServer.h"
 
 /**
@@ -43,7 +46,10 @@ private:
     // Task handle for web server
     // TaskHandle_t webServerTaskHandle = NULL;
 
-    MQTTManager *mqttManager; // Reference to MQTT manager
+    MQTTManager *mqttManager;     // Reference to MQTT manager
+    HttpForwarder *httpForwarder; // Reference to HTTP forwarding queue
+    LoRaProtocol *loraProtocol;   // Reference to LoRa protocol (receive statistics)
+    LogFileSink *logFileSink;     // Reference to log files
 
     // Static task function for the second core
     static void webServerTask(void *parameter);
@@ -93,10 +99,20 @@ private:
     void handleSensorEdit(AsyncWebServerRequest *request);
     void handleSensorEditPost(AsyncWebServerRequest *request);
     void handleSensorDelete(AsyncWebServerRequest *request);
+    void handleSensorExport(AsyncWebServerRequest *request);
+    void handleSensorImport(AsyncWebServerRequest *request);
     void handleLogs(AsyncWebServerRequest *request);
     void handleLogsClear(AsyncWebServerRequest *request);
     void handleLogLevel(AsyncWebServerRequest *request);
+    void handleLogsJson(AsyncWebServerRequest *request);
+    void handleLogFile(AsyncWebServerRequest *request);
+    void handleLogsDownload(AsyncWebServerRequest *request);
     void handleAPI(AsyncWebServerRequest *request);
+    void handleLatency(AsyncWebServerRequest *request);
+    void handleLatencyReset(AsyncWebServerRequest *request);
+    void handleDiagnostics(AsyncWebServerRequest *request);
+    void handleDiagnosticsReset(AsyncWebServerRequest *request);
+    void handleDiagnosticsJson(AsyncWebServerRequest *request);
     void handleMqtt(AsyncWebServerRequest *request);
     void handleMqttPost(AsyncWebServerRequest *request);
     void handleReboot(AsyncWebServerRequest *request);
@@ -137,4 +153,13 @@ public:
 
     // Set MQTTManager reference
     void setMqttManager(MQTTManager *manager) { mqttManager = manager; }
+
+    // Set HTTP forwarding queue for diagnostics
+    void setHttpForwarder(HttpForwarder *forwarder) { httpForwarder = forwarder; }
+
+    // Set LoRa protocol for receive statistics in diagnostics
+    void setLoRaProtocol(LoRaProtocol *protocol) { loraProtocol = protocol; }
+
+    // Set log files for logs page and download
+    void setLogFileSink(LogFileSink *sink) { logFileSink = sink; }
 };
@@ -71,15 +71,86 @@
 #define MODE_CAD 0x07
 
 // Application configuration
-#define MAX_SENSORS 20                // Maximum number of sensors
-#define LOG_BUFFER_SIZE 200           // Size of log buffer
+#define MAX_SENSORS 1024              // Maximum number of sensors
+#define SENSOR_STORE_CHUNK_SIZE 32    // Sensor slots allocated at once (PSRAM when available)
+#define SENSOR_STORE_READ_SPINS 16    // Lock-free reads retried before yielding to the writer
 #define AP_TIMEOUT 300000             // AP mode timeout (5 minutes in milliseconds)
 #define WIFI_RECONNECT_INTERVAL 60000 // WiFi reconnect attempt interval (1 minute in milliseconds)
 #define WDT_TIMEOUT 10                // Watchdog timeout in seconds
 
+// Logging configuration
+#define LOG_ARENA_SIZE 32768          // Size of log record arena in bytes (PSRAM when available)
+#define LOG_MESSAGE_SIZE 256          // Stack buffer for formatted log messages (longer messages are truncated)
+#define LOG_MAX_SINKS 4               // Log sinks (Serial, files) written by the drain task
+#define LOG_DRAIN_TASK_PRIORITY 1     // Drain task priority (same as loop(), below the radio tasks)
+#define LOG_DRAIN_TASK_STACK 4096     // Drain task stack size (bytes)
+#define LOG_DRAIN_TASK_CORE 0         // Core for drain task (radio tasks run on the other one)
+#define LOG_DRAIN_INTERVAL 1000       // Drain task retries sinks that refused records this often (ms)
+#define LOG_DRAIN_BATCH 16            // Records written to one sink before the next sink gets its turn
+#define LOG_API_MAX_RECORDS 64        // Records returned by one /api/logs request
+#define LOG_PAGE_POLL_INTERVAL 5000   // Logs page asks for new records this often (ms)
+#define LOG_PAGE_MAX_ENTRIES 1000     // Oldest entries are removed from the logs page above this count
+
+// Least important log level compiled in (0 = ERROR, 1 = WARNING, 2 = INFO, 3 = DEBUG, 4 = VERBOSE),
+// LOGF_* calls below it are removed entirely; can be overridden by build flag
+#ifndef LOG_MIN_LEVEL
+#define LOG_MIN_LEVEL 4
+#endif
+
+// Main loop profiler configuration
+#define LOOP_STALL_BUDGET 100          // Loop iterations longer than this are counted as stalls (ms)
+#define LOOP_WDT_WARNING_PERCENT 50    // Stage ending later than this share of WDT_TIMEOUT is reported
+
+// SPI clock for LoRa module (SX127x supports up to 10 MHz), can be overridden by build flag
+#ifndef LORA_SPI_FREQUENCY
+#define LORA_SPI_FREQUENCY 8000000
+#endif
+
+// LoRa receive pipeline configuration
+#define LORA_RX_RING_SIZE 8            // Number of raw frames buffered between receive and decode tasks (power of two)
+#define LORA_RX_TASK_PRIORITY 5        // Receive task priority (above loop() and WiFi/MQTT work)
+#define LORA_RX_TASK_STACK 4096        // Receive task stack size (bytes)
+#define LORA_RX_POLL_INTERVAL 1000     // Receive task checks IRQ flags at least this often (ms) in case an edge was missed
+#define LORA_DECODE_TASK_PRIORITY 2    // Decode task priority
+#define LORA_DECODE_TASK_STACK 8192    // Decode task stack size (bytes)
+#define LORA_TASK_CORE 1               // Core for receive and decode tasks
+
+// HTTP forwarding configuration (per-sensor custom URL)
+#define HTTP_FORWARD_QUEUE_SIZE 8        // Pending requests, at most one per sensor (oldest is dropped when full)
+#define HTTP_FORWARD_URL_SIZE 384        // Longest expanded custom URL including terminator
+#define URL_TEMPLATE_MAX_TOKENS 32       // Literal segments and placeholders of one custom URL
+#define HTTP_FORWARD_HOST_COUNT 4        // Number of hosts tracked for backoff
+#define HTTP_FORWARD_TIMEOUT 5000        // Connect and response timeout (ms)
+#define HTTP_FORWARD_MAX_AGE 60000       // Requests waiting longer are dropped as stale (ms)
+#define HTTP_FORWARD_BACKOFF_MIN 5000    // First backoff after a failed request (ms), doubles per failure
+#define HTTP_FORWARD_BACKOFF_MAX 300000  // Longest backoff (ms)
+#define HTTP_FORWARD_TASK_PRIORITY 1     // Worker task priority (same as loop())
+#define HTTP_FORWARD_TASK_STACK 8192     // Worker task stack size (bytes), TLS handshake needs most of it
+#define HTTP_FORWARD_TASK_CORE 0         // Core for worker task (same as WiFi stack)
+
+// Simulated radio configuration
+#define SIMULATED_RADIO_CAPTURE_DB 6   // Power advantage (dB) that lets a frame survive a collision
+
 // File system configuration
-#define CONFIG_FILE "/config.json"   // Configuration file
-#define SENSORS_FILE "/sensors.json" // Sensors file
+#define CONFIG_FILE "/config.json"        // Configuration file
+#define SENSORS_FILE "/sensors.bin"       // Sensors file (binary registry)
+#define SENSORS_JSON_FILE "/sensors.json" // Sensors file before binary registry, imported once
+
+// Sensor runtime state (daily rain totals) is journaled behind the radio path
+#define SENSOR_SAVE_DEBOUNCE 30000          // Journal state after no further change for this long (ms)
+#define SENSOR_SAVE_MAX_DELAY 120000        // Journal state at latest this long after first unsaved change (ms)
+#define SENSOR_CONFIG_SAVE_DELAY 2000       // Write sensors file after no further configuration change for this long (ms)
+#define STATE_JOURNAL_FILE "/state.jnl"     // Journal of fast-changing sensor state
+#define STATE_SNAPSHOT_FILE "/state.snp"    // Compacted sensor state
+#define STATE_JOURNAL_COMPACT_RECORDS 256   // Compact journal into snapshot after this many records
+
+// Log files - records are appended in blocks to numbered files that rotate within a byte budget
+#define LOG_FILE_DEFAULT_ENABLED false      // Store logs in files (can be changed on the logs page)
+#define LOG_FILE_DIR "/logs"                // Directory of log files
+#define LOG_FILE_BLOCK_SIZE 4096            // Records are buffered in RAM and written in blocks of this size
+#define LOG_FILE_FLUSH_INTERVAL 60000       // Write a partial block once its oldest record is this old (ms)
+#define LOG_FILE_MAX_SIZE 32768             // Start a new file when the current one would grow past this
+#define LOG_FILE_TOTAL_SIZE 131072          // Delete oldest files to keep all log files within this
 
 // NTP configuration
 #define NTP_SERVER "pool.ntp.org"
@@ -25,6 +25,7 @@
 #include <LittleFS.h>
 #include <time.h>
 #include <esp_task_wdt.h>
+#include <esp_timer.h>
 #include <ArduinoJson.h>
 
 // Configuration headers
@@ -35,6 +36,8 @@
 #include "Data/SensorData.h"
 #include "Data/Logging.h"
 #include "Data/SensorManager.h"
+#include "Data/PacketLatency.h"
+#include "Data/LoopProfiler.h"
 
 // Hardware
 #include "Hardware/LoRa_Module.h"
@@ -43,9 +46,11 @@
 
 // Storage
 #include "Storage/ConfigManager.h"
+#include "Storage/LogFileSink.h"
 
 // Protocol
 #include "Protocol/LoRaProtocol.h"
+#include "Protocol/HttpForwarder.h"
 // MQTT
 #include "Protocol/MQTTManager.h"
 
@@ -61,6 +66,8 @@ LoRaModule *loraModule;       // LoRa module
 SensorManager *sensorManager; // Sensor manager
 LoRaProtocol *loraProtocol;   // LoRa protocol
 MQTTManager *mqttManager;     // MQTT Manager
+HttpForwarder *httpForwarder; // Custom URL forwarding
+LogFileSink *logFileSink;     // Log files on LittleFS
 WebPortal *webPortal;         // Web interface
 
 // Timer for disabling AP mode
@@ -136,7 +143,7 @@ void setup()
     }
 
     // Logging system initialization
-    if (!logger.init(LOG_BUFFER_SIZE))
+    if (!logger.init(LOG_ARENA_SIZE))
     {
         Serial.println("ERROR: Logger initialization failed");
         return;
@@ -145,6 +152,9 @@ void setup()
     // Basic log after initialization
     logger.info("expLORA Gateway Lite starting up - Firmware v" + String(FIRMWARE_VERSION));
 
+    // Serial output from now on is written by the drain task, not by the logging task
+    logger.startDrainTask();
+
     // HTML generator initialization
     if (!HTMLGenerator::init(true, WEB_BUFFER_SIZE))
     {
@@ -163,6 +173,17 @@ void setup()
     // Setting logging level according to configuration
     logger.setLogLevel(configManager->logLevel);
 
+    // Log files are scanned even when disabled, so the stored ones can be downloaded
+    logFileSink = new LogFileSink();
+    if (!logFileSink->init())
+    {
+        logger.error("Failed to initialize log files");
+    }
+    else if (configManager->logFileEnabled)
+    {
+        logger.addSink(logFileSink);
+    }
+
     // SPI manager initialization
     spiManager = new SPIManager(logger);
     if (!spiManager->init())
@@ -183,6 +204,13 @@ void setup()
                     String(sensorManager->getSensorCount()) + " sensors");
     }
 
+    // Custom URL requests are sent by a worker task instead of the LoRa decode path
+    httpForwarder = new HttpForwarder(logger);
+    if (httpForwarder->start())
+    {
+        sensorManager->setHttpForwarder(httpForwarder);
+    }
+
     // WiFi Initialization - MODIFIED CODE SECTION
     logger.info("Configuring WiFi. ConfigMode: " + String(configManager->configMode ? "true" : "false") +
                 ", SSID length: " + String(configManager->wifiSSID.length()));
@@ -267,7 +295,8 @@ void setup()
 
     // LoRa module initialization
     loraModule = new LoRaModule(logger, spiManager);
-    if (!loraModule->init())
+    bool loraReady = loraModule->init();
+    if (!loraReady)
     {
         logger.error("Failed to initialize LoRa module");
     }
@@ -279,6 +308,13 @@ void setup()
     // LoRa protocol initialization
     loraProtocol = new LoRaProtocol(*loraModule, *sensorManager, logger);
 
+    // Packet reception runs in its own tasks so it never waits for WiFi, MQTT or HTTP
+    loraProtocol->startDecodeTask();
+    if (loraReady)
+    {
+        loraModule->startReceiveTask();
+    }
+
     // Web portal initialization if not already initialized
     if (!webPortal)
     {
@@ -303,12 +339,23 @@ void setup()
     }
 
     webPortal->setMqttManager(mqttManager);
+    webPortal->setHttpForwarder(httpForwarder);
+    webPortal->setLoRaProtocol(loraProtocol);
+    webPortal->setLogFileSink(logFileSink);
 
     // Initialize task watchdog
     esp_task_wdt_init(WDT_TIMEOUT, true); // Enable panic on timeout
     esp_task_wdt_add(NULL);               // Add current task to watchdog
     logger.info("Task watchdog initialized with timeout of " + String(WDT_TIMEOUT) + " seconds");
 
+    // Report stage of main loop that caused last watchdog reset
+    LoopProfiler::init();
+    if (LoopProfiler::getWatchdogResetStage() != LoopStage::COUNT)
+    {
+        logger.warning("Last reset caused by task watchdog in loop stage: " +
+                       String(LoopProfiler::getStageName(LoopProfiler::getWatchdogResetStage())));
+    }
+
     logger.info("System initialization complete");
 }
 
@@ -316,8 +363,10 @@ void setup()
 void loop()
 {
     esp_task_wdt_reset();
+    LoopProfiler::beginIteration();
 
     // Check timer for temporary AP mode
+    LoopProfiler::beginStage(LoopStage::AP_TIMER);
     if (temporaryAPMode && !configManager->configMode && configManager->wifiSSID.length() > 0)
     {
         if (millis() - apStartTime > AP_TIMEOUT)
@@ -338,47 +387,54 @@ void loop()
         }
     }
 
-    // Process LoRa packets
-    // if (loraModule && loraProtocol) {
-    //    if (LoRaModule::hasInterrupt()) {
-    //        logger.debug("LoRa interrupt detected");
-    //        loraProtocol->processReceivedPacket();
-    //    }
-    //}
-
     // If in AP mode, process DNS captive portal:
+    LoopProfiler::beginStage(LoopStage::DNS);
     if (webPortal && webPortal->isInAPMode())
     {
         webPortal->processDNS(); // This method internally calls dnsServer.processNextRequest();
     }
 
     // Handle web interface
+    LoopProfiler::beginStage(LoopStage::WEB);
     if (webPortal)
     {
         webPortal->handleClient();
     }
 
     // Process MQTT communication
+    LoopProfiler::beginStage(LoopStage::MQTT);
     if (mqttManager && WiFi.status() == WL_CONNECTED)
     {
         mqttManager->process();
     }
 
-    // Add a check for LoRa packet processing to publish to MQTT
-    static unsigned int lastProcessedIndex = -1;
-    if (loraModule && loraProtocol && LoRaModule::hasInterrupt())
+    // Publish sensors updated by the LoRa decode task to MQTT
+    LoopProfiler::beginStage(LoopStage::PUBLISH);
+    ProcessedSensor processed;
+    while (loraProtocol && loraProtocol->getProcessedSensor(processed))
     {
-        if (loraProtocol->processReceivedPacket())
+        // If we have a mqttManager and it's connected, publish the latest sensor data
+        if (mqttManager && WiFi.status() == WL_CONNECTED)
         {
-            // If we have a mqttManager and it's connected, publish the latest sensor data
-            if (mqttManager && WiFi.status() == WL_CONNECTED)
-            {
-                mqttManager->publishSensorData(loraProtocol->getLastProcessedSensorIndex());
-            }
+            int64_t publishStart = esp_timer_get_time();
+            mqttManager->publishSensorData(processed.sensorIndex);
+            int64_t publishEnd = esp_timer_get_time();
+
+            PacketLatency::record(LatencyStage::MQTT_QUEUE, processed.queuedAt, publishStart);
+            PacketLatency::record(LatencyStage::MQTT_PUBLISH, publishStart, publishEnd);
+            PacketLatency::record(LatencyStage::TOTAL, processed.receivedAt, publishEnd);
         }
     }
 
+    // Save sensor state changed by received packets
+    LoopProfiler::beginStage(LoopStage::PERSIST);
+    if (sensorManager)
+    {
+        sensorManager->process();
+    }
+
     // Check WiFi connection and reconnect if needed
+    LoopProfiler::beginStage(LoopStage::WIFI);
     if (!configManager->configMode && WiFi.status() != WL_CONNECTED)
     {
         unsigned long now = millis();
@@ -413,9 +469,11 @@ void loop()
     }
 
     // Short delay for stability
+    LoopProfiler::beginStage(LoopStage::IDLE);
     delay(5);
 
     // Memory diagnostics every 10 minutes
+    LoopProfiler::beginStage(LoopStage::DIAGNOSTICS);
     static unsigned long lastMemCheck = 0;
     if (millis() - lastMemCheck > 600000)
     { // 10 minutes
@@ -431,5 +489,15 @@ void loop()
                          " bytes, Largest block: " + String(ESP.getMaxAllocPsram()) + " bytes");
         }
 #endif
+
+        logger.debug("Main loop - stalled iterations: " + String(LoopProfiler::getStalledIterations()) +
+                     ", watchdog warnings: " + String(LoopProfiler::getWatchdogWarnings()));
+    }
+
+    if (LoopProfiler::endIteration())
+    {
+        logger.warning("Main loop close to watchdog timeout in stage " +
+                       String(LoopProfiler::getStageName(LoopProfiler::getWatchdogWarningStage())) + " (" +
+                       String(LoopProfiler::getWatchdogWarningElapsed()) + " ms since reset)");
     }
 }
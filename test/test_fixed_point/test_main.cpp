@@ -0,0 +1,113 @@
+/**
+ * expLORA Gateway Lite
+ *
+ * Unit tests of fixed point formatting
+ *
+ * Copyright Pajenicko s.r.o., Igor Sverma (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <unity.h>
+#include "../../src/Data/FixedPoint.h"
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+// Value formatted into buffer of given size
+static String formatted(int32_t value, uint8_t scale, uint8_t decimals, size_t size = 20)
+{
+    char buffer[20];
+    size_t length = FixedPoint::format(buffer, size, value, scale, decimals);
+    return length > 0 ? String(buffer) : String("<none>");
+}
+
+static void test_format_all_decimals()
+{
+    TEST_ASSERT_EQUAL_STRING("21.37", formatted(2137, 2, 2).c_str());
+    TEST_ASSERT_EQUAL_STRING("0.05", formatted(5, 2, 2).c_str());
+    TEST_ASSERT_EQUAL_STRING("1013.2", formatted(10132, 1, 1).c_str());
+    TEST_ASSERT_EQUAL_STRING("415", formatted(415, 0, 0).c_str());
+    TEST_ASSERT_EQUAL_STRING("3.300", formatted(3300, 3, 3).c_str());
+}
+
+static void test_format_negative()
+{
+    TEST_ASSERT_EQUAL_STRING("-5.25", formatted(-525, 2, 2).c_str());
+    TEST_ASSERT_EQUAL_STRING("-0.01", formatted(-1, 2, 2).c_str());
+    TEST_ASSERT_EQUAL_STRING("-2147483.648", formatted(INT32_MIN, 3, 3).c_str());
+}
+
+static void test_format_rounds_half_away_from_zero()
+{
+    TEST_ASSERT_EQUAL_STRING("21.4", formatted(2135, 2, 1).c_str());
+    TEST_ASSERT_EQUAL_STRING("21.3", formatted(2134, 2, 1).c_str());
+    TEST_ASSERT_EQUAL_STRING("-21.4", formatted(-2135, 2, 1).c_str());
+    TEST_ASSERT_EQUAL_STRING("10.0", formatted(999, 2, 1).c_str());
+    TEST_ASSERT_EQUAL_STRING("3", formatted(2500, 3, 0).c_str());
+}
+
+static void test_format_has_no_negative_zero()
+{
+    TEST_ASSERT_EQUAL_STRING("0.0", formatted(-4, 2, 1).c_str());
+    TEST_ASSERT_EQUAL_STRING("0", formatted(-499, 3, 0).c_str());
+}
+
+static void test_format_clamps_decimals_to_scale()
+{
+    TEST_ASSERT_EQUAL_STRING("12.5", formatted(125, 1, 3).c_str());
+}
+
+static void test_format_reports_small_buffer()
+{
+    // "21.37" needs 6 bytes with the terminator
+    TEST_ASSERT_EQUAL_STRING("<none>", formatted(2137, 2, 2, 5).c_str());
+    TEST_ASSERT_EQUAL_STRING("21.37", formatted(2137, 2, 2, 6).c_str());
+    TEST_ASSERT_EQUAL_STRING("<none>", formatted(0, 0, 0, 1).c_str());
+}
+
+static void test_text_and_to_string()
+{
+    TEST_ASSERT_EQUAL_STRING("4.12", FixedPoint::Text(4123, 3, 2).c_str());
+    TEST_ASSERT_EQUAL_STRING("-12.3", FixedPoint::toString(-1234, 2, 1).c_str());
+}
+
+static void test_conversions()
+{
+    TEST_ASSERT_EQUAL_INT32(2137, FixedPoint::fromFloat(21.37f, 2));
+    TEST_ASSERT_EQUAL_INT32(-525, FixedPoint::fromFloat(-5.25f, 2));
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 21.37f, FixedPoint::toFloat(2137, 2));
+    TEST_ASSERT_EQUAL_INT32(1500, FixedPoint::scale(1000, 1500));
+    TEST_ASSERT_EQUAL_INT32(2, FixedPoint::scale(3, 500));
+    TEST_ASSERT_EQUAL_INT32(-2, FixedPoint::scale(-3, 500));
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_format_all_decimals);
+    RUN_TEST(test_format_negative);
+    RUN_TEST(test_format_rounds_half_away_from_zero);
+    RUN_TEST(test_format_has_no_negative_zero);
+    RUN_TEST(test_format_clamps_decimals_to_scale);
+    RUN_TEST(test_format_reports_small_buffer);
+    RUN_TEST(test_text_and_to_string);
+    RUN_TEST(test_conversions);
+    return UNITY_END();
+}
@@ -0,0 +1,213 @@
+/**
+ * expLORA Gateway Lite
+ *
+ * Unit tests of log arena
+ *
+ * Copyright Pajenicko s.r.o., Igor Sverma (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <unity.h>
+#include <vector>
+#include "../../src/Data/Logging.h"
+
+// Smallest arena the logger accepts holds a few records, so it wraps quickly
+static const size_t ARENA_SIZE = 1024;
+
+static Logger logger;
+
+void setUp()
+{
+    logger.init(ARENA_SIZE);
+    logger.setLogLevel(LogLevel::INFO);
+}
+
+void tearDown()
+{
+    logger.deinit();
+}
+
+// Message of record number, its length varies so records end at varying offsets
+static String messageOf(uint32_t number)
+{
+    String message = "record " + String(number) + " ";
+    for (uint32_t i = 0; i < number % 97; i++)
+    {
+        message += (char)('a' + i % 26);
+    }
+    return message;
+}
+
+// Log records first..first+count-1, returns sequence number of the first one
+static uint32_t logRecords(uint32_t first, uint32_t count)
+{
+    uint32_t sequence = Logger::getNextSequence();
+    for (uint32_t i = first; i < first + count; i++)
+    {
+        Logger::logf(LogLevel::INFO, "%s", messageOf(i).c_str());
+    }
+    return sequence;
+}
+
+// Records visited by forEachLogSince
+struct Visited
+{
+    std::vector<uint32_t> sequences;
+    std::vector<String> messages;
+};
+
+static size_t visitSince(uint32_t &cursor, Visited &visited, size_t limit = SIZE_MAX)
+{
+    auto visitor = [&](const LogEntry &entry)
+    {
+        visited.sequences.push_back(entry.sequence);
+        visited.messages.push_back(String(entry.message));
+        return visited.sequences.size() < limit;
+    };
+    return Logger::forEachLogSince(cursor, visitor);
+}
+
+static void test_arena_wraps_keeping_newest_records()
+{
+    uint32_t first = logRecords(0, 200);
+    uint32_t next = Logger::getNextSequence();
+    TEST_ASSERT_EQUAL_UINT32(first + 200, next);
+
+    size_t count = Logger::getLogCount();
+    TEST_ASSERT_GREATER_THAN(0, count);
+    TEST_ASSERT_LESS_THAN(200, count);
+
+    // Newest first, consecutive sequence numbers, messages intact after wrapping
+    uint32_t expected = next - 1;
+    bool intact = true;
+    auto visitor = [&](const LogEntry &entry)
+    {
+        intact = intact && entry.sequence == expected && messageOf(expected - first) == entry.message &&
+                 entry.length == strlen(entry.message);
+        expected--;
+        return true;
+    };
+    size_t visited = Logger::forEachLog(visitor);
+    TEST_ASSERT_EQUAL(count, visited);
+    TEST_ASSERT_TRUE(intact);
+}
+
+static void test_for_each_log_since_visits_oldest_first()
+{
+    uint32_t first = logRecords(0, 150);
+    uint32_t next = Logger::getNextSequence();
+    size_t count = Logger::getLogCount();
+    uint32_t oldest = next - count;
+
+    uint32_t cursor = oldest;
+    Visited visited;
+    TEST_ASSERT_EQUAL(count, visitSince(cursor, visited));
+    TEST_ASSERT_EQUAL_UINT32(next, cursor);
+
+    for (size_t i = 0; i < visited.sequences.size(); i++)
+    {
+        TEST_ASSERT_EQUAL_UINT32(oldest + i, visited.sequences[i]);
+        TEST_ASSERT_EQUAL_STRING(messageOf(oldest + i - first).c_str(), visited.messages[i].c_str());
+    }
+
+    // Nothing new since
+    Visited none;
+    TEST_ASSERT_EQUAL(0, visitSince(cursor, none));
+    TEST_ASSERT_EQUAL_UINT32(next, cursor);
+}
+
+static void test_for_each_log_since_continues_where_it_stopped()
+{
+    uint32_t first = logRecords(0, 20);
+    uint32_t cursor = first;
+
+    Visited part;
+    TEST_ASSERT_EQUAL(3, visitSince(cursor, part, 3));
+    TEST_ASSERT_EQUAL_UINT32(first + 3, cursor);
+
+    logRecords(20, 2);
+
+    Visited rest;
+    visitSince(cursor, rest);
+    TEST_ASSERT_EQUAL_UINT32(first + 3, rest.sequences.front());
+    TEST_ASSERT_EQUAL_UINT32(first + 21, rest.sequences.back());
+    TEST_ASSERT_EQUAL_STRING(messageOf(21).c_str(), rest.messages.back().c_str());
+    TEST_ASSERT_EQUAL_UINT32(Logger::getNextSequence(), cursor);
+}
+
+static void test_for_each_log_since_clamps_lost_cursor()
+{
+    uint32_t first = logRecords(0, 5);
+
+    // Records the cursor points to were overwritten meanwhile
+    logRecords(5, 200);
+    uint32_t oldest = Logger::getNextSequence() - Logger::getLogCount();
+    TEST_ASSERT_GREATER_THAN(first, oldest);
+
+    uint32_t cursor = first;
+    Visited visited;
+    visitSince(cursor, visited);
+    TEST_ASSERT_EQUAL_UINT32(oldest, visited.sequences.front());
+    TEST_ASSERT_EQUAL_UINT32(Logger::getNextSequence(), cursor);
+}
+
+static void test_for_each_log_since_clamps_cursor_ahead()
+{
+    logRecords(0, 10);
+    uint32_t next = Logger::getNextSequence();
+    uint32_t oldest = next - Logger::getLogCount();
+
+    // Cursor from before a reboot, ahead of the newest record
+    uint32_t cursor = next + 1000;
+    Visited visited;
+    TEST_ASSERT_EQUAL(Logger::getLogCount(), visitSince(cursor, visited));
+    TEST_ASSERT_EQUAL_UINT32(oldest, visited.sequences.front());
+    TEST_ASSERT_EQUAL_UINT32(next, cursor);
+}
+
+static void test_long_message_is_truncated()
+{
+    String longMessage;
+    for (int i = 0; i < LOG_MESSAGE_SIZE * 2; i++)
+    {
+        longMessage += 'x';
+    }
+
+    uint32_t cursor = Logger::getNextSequence();
+    Logger::log(LogLevel::INFO, longMessage);
+
+    Visited visited;
+    TEST_ASSERT_EQUAL(1, visitSince(cursor, visited));
+    TEST_ASSERT_LESS_THAN(LOG_MESSAGE_SIZE, visited.messages[0].length());
+    TEST_ASSERT_GREATER_THAN(0, visited.messages[0].length());
+}
+
+static void test_boot_id_is_set()
+{
+    TEST_ASSERT_TRUE(Logger::getBootId() != 0);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_arena_wraps_keeping_newest_records);
+    RUN_TEST(test_for_each_log_since_visits_oldest_first);
+    RUN_TEST(test_for_each_log_since_continues_where_it_stopped);
+    RUN_TEST(test_for_each_log_since_clamps_lost_cursor);
+    RUN_TEST(test_for_each_log_since_clamps_cursor_ahead);
+    RUN_TEST(test_long_message_is_truncated);
+    RUN_TEST(test_boot_id_is_set);
+    return UNITY_END();
+}
@@ -0,0 +1,386 @@
+/**
+ * expLORA Gateway Lite
+ *
+ * Unit tests of packet decryption and simulated radio
+ *
+ * Copyright Pajenicko s.r.o., Igor Sverma (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <unity.h>
+#include <LittleFS.h>
+#include "../../src/Data/SensorManager.h"
+#include "../../src/Hardware/SimulatedRadio.h"
+#include "../../src/Protocol/LoRaProtocol.h"
+
+static const char *SENSORS_TEST_FILE = "/test_sensors.bin";
+
+static const uint32_t GARDEN_SN = 0x123456;
+static const uint32_t GARDEN_KEY = 0xA5C3E1F7;
+static const uint32_t FOREIGN_SN = 0x654321;
+static const uint32_t FOREIGN_KEY = 0x0BADF00D;
+
+static Logger logger;
+
+void setUp()
+{
+    TEST_ASSERT_TRUE(LittleFS.begin(true));
+}
+
+void tearDown()
+{
+    LittleFS.remove(SENSORS_TEST_FILE);
+}
+
+// Plain packet - header, big-endian values, XOR checksum - returns its length
+static uint8_t buildPlainPacket(uint8_t *packet, uint8_t type, uint32_t serialNumber, const uint16_t *values,
+                                uint8_t valueCount)
+{
+    packet[0] = 0x5A;
+    packet[1] = type;
+    packet[2] = serialNumber >> 16;
+    packet[3] = serialNumber >> 8;
+    packet[4] = serialNumber;
+    packet[5] = 3300 >> 8;
+    packet[6] = 3300 & 0xFF;
+    packet[7] = valueCount;
+
+    uint8_t length = 8;
+    for (uint8_t i = 0; i < valueCount; i++)
+    {
+        packet[length++] = values[i] >> 8;
+        packet[length++] = values[i];
+    }
+
+    uint8_t checksum = 0;
+    for (uint8_t i = 0; i < length; i++)
+    {
+        checksum ^= packet[i];
+    }
+    packet[length++] = checksum;
+    return length;
+}
+
+// Plain BME280 packet
+static uint8_t buildClimatePacket(uint8_t *packet, uint32_t serialNumber, int16_t temperatureCenti,
+                                  uint16_t pressureDeci, uint16_t humidityCenti)
+{
+    uint16_t values[] = {(uint16_t)temperatureCenti, pressureDeci, humidityCenti};
+    return buildPlainPacket(packet, SENSOR_TYPE_BME280, serialNumber, values, 3);
+}
+
+// Encrypted BME280 packet
+static uint8_t buildEncryptedPacket(uint8_t *packet, uint32_t serialNumber, uint32_t key, int16_t temperatureCenti = 2137)
+{
+    uint8_t length = buildClimatePacket(packet, serialNumber, temperatureCenti, 10132, 4512);
+    LoRaProtocol::encryptData(packet, length, key);
+    return length;
+}
+
+static void test_packet_key_tag_matches_sensor_key_tag()
+{
+    uint8_t packet[32];
+    buildEncryptedPacket(packet, GARDEN_SN, GARDEN_KEY);
+    TEST_ASSERT_EQUAL_HEX32(SensorManager::computeKeyTag(GARDEN_SN, GARDEN_KEY), LoRaProtocol::computePacketKeyTag(packet));
+
+    buildEncryptedPacket(packet, FOREIGN_SN, FOREIGN_KEY);
+    TEST_ASSERT_EQUAL_HEX32(SensorManager::computeKeyTag(FOREIGN_SN, FOREIGN_KEY), LoRaProtocol::computePacketKeyTag(packet));
+}
+
+static void test_find_sensors_by_key_tag()
+{
+    SensorManager manager(logger, SENSORS_TEST_FILE);
+    int garden = manager.addSensor(SensorType::BME280, GARDEN_SN, GARDEN_KEY, "Garden");
+    TEST_ASSERT_TRUE(garden >= 0);
+
+    // Serial number and key differing in the same bit share the key tag
+    int twin = manager.addSensor(SensorType::BME280, GARDEN_SN ^ 0x01, GARDEN_KEY ^ 0x01, "Twin");
+    TEST_ASSERT_EQUAL_HEX32(SensorManager::computeKeyTag(GARDEN_SN, GARDEN_KEY),
+                            SensorManager::computeKeyTag(GARDEN_SN ^ 0x01, GARDEN_KEY ^ 0x01));
+
+    int indices[4];
+    uint32_t keys[4];
+    size_t count = manager.findSensorsByKeyTag(SensorManager::computeKeyTag(GARDEN_SN, GARDEN_KEY), indices, keys, 4);
+    TEST_ASSERT_EQUAL(2, count);
+    TEST_ASSERT_TRUE((indices[0] == garden && keys[0] == GARDEN_KEY) || (indices[1] == garden && keys[1] == GARDEN_KEY));
+    TEST_ASSERT_TRUE(indices[0] == twin || indices[1] == twin);
+
+    TEST_ASSERT_EQUAL(0, manager.findSensorsByKeyTag(SensorManager::computeKeyTag(FOREIGN_SN, FOREIGN_KEY), indices, keys, 4));
+
+    // Deleted sensors are no candidates
+    TEST_ASSERT_TRUE(manager.deleteSensor(twin));
+    count = manager.findSensorsByKeyTag(SensorManager::computeKeyTag(GARDEN_SN, GARDEN_KEY), indices, keys, 4);
+    TEST_ASSERT_EQUAL(1, count);
+    TEST_ASSERT_EQUAL_INT(garden, indices[0]);
+}
+
+static void test_decrypt_and_verify_round_trip()
+{
+    uint8_t plain[32];
+    uint8_t packet[32];
+    uint8_t decrypted[32];
+    uint8_t length = buildClimatePacket(plain, GARDEN_SN, -525, 10132, 4512);
+    memcpy(packet, plain, length);
+    LoRaProtocol::encryptData(packet, length, GARDEN_KEY);
+
+    TEST_ASSERT_TRUE(LoRaProtocol::decryptAndVerify(packet, length, GARDEN_KEY, GARDEN_SN, decrypted));
+    TEST_ASSERT_EQUAL_MEMORY(plain, decrypted, length);
+}
+
+static void test_decrypt_and_verify_all_lengths()
+{
+    // Every length exercises another split between the byte and word loops
+    for (uint8_t length = 6; length < 64; length++)
+    {
+        uint8_t plain[64];
+        uint8_t packet[64];
+        uint8_t decrypted[64];
+        plain[0] = length;
+        plain[1] = SENSOR_TYPE_BME280;
+        plain[2] = (uint8_t)(GARDEN_SN >> 16);
+        plain[3] = (uint8_t)(GARDEN_SN >> 8);
+        plain[4] = (uint8_t)GARDEN_SN;
+        uint8_t checksum = plain[0] ^ plain[1] ^ plain[2] ^ plain[3] ^ plain[4];
+        for (uint8_t i = 5; i < length - 1; i++)
+        {
+            plain[i] = (uint8_t)(i * 37 + length);
+            checksum ^= plain[i];
+        }
+        plain[length - 1] = checksum;
+
+        memcpy(packet, plain, length);
+        LoRaProtocol::encryptData(packet, length, GARDEN_KEY);
+        TEST_ASSERT_TRUE(LoRaProtocol::decryptAndVerify(packet, length, GARDEN_KEY, GARDEN_SN, decrypted));
+        TEST_ASSERT_EQUAL_MEMORY(plain, decrypted, length);
+
+        // Any flipped bit after the header breaks the checksum
+        for (uint8_t i = 5; i < length; i++)
+        {
+            packet[i] ^= 0x04;
+            TEST_ASSERT_FALSE(LoRaProtocol::decryptAndVerify(packet, length, GARDEN_KEY, GARDEN_SN, decrypted));
+            packet[i] ^= 0x04;
+        }
+    }
+}
+
+static void test_decrypt_and_verify_rejects_wrong_key_or_serial()
+{
+    uint8_t packet[32];
+    uint8_t decrypted[32];
+    uint8_t length = buildEncryptedPacket(packet, GARDEN_SN, GARDEN_KEY);
+
+    TEST_ASSERT_FALSE(LoRaProtocol::decryptAndVerify(packet, length, FOREIGN_KEY, GARDEN_SN, decrypted));
+    TEST_ASSERT_FALSE(LoRaProtocol::decryptAndVerify(packet, length, GARDEN_KEY, FOREIGN_SN, decrypted));
+    TEST_ASSERT_FALSE(LoRaProtocol::decryptAndVerify(packet, 5, GARDEN_KEY, GARDEN_SN, decrypted));
+}
+
+static void test_decrypt_data_matches_fused_decryption()
+{
+    SensorManager manager(logger, SENSORS_TEST_FILE);
+    SimulatedRadio radio(logger);
+    LoRaProtocol protocol(radio, manager, logger);
+
+    uint8_t packet[32];
+    uint8_t decrypted[32];
+    uint8_t length = buildEncryptedPacket(packet, GARDEN_SN, GARDEN_KEY);
+    TEST_ASSERT_TRUE(LoRaProtocol::decryptAndVerify(packet, length, GARDEN_KEY, GARDEN_SN, decrypted));
+
+    protocol.decryptData(packet, length, GARDEN_KEY);
+    TEST_ASSERT_EQUAL_MEMORY(decrypted, packet, length);
+}
+
+static void test_try_decrypt_with_all_keys()
+{
+    SensorManager manager(logger, SENSORS_TEST_FILE);
+    SimulatedRadio radio(logger);
+    LoRaProtocol protocol(radio, manager, logger);
+    manager.addSensor(SensorType::BME280, GARDEN_SN ^ 0x01, GARDEN_KEY ^ 0x01, "Twin");
+    int garden = manager.addSensor(SensorType::BME280, GARDEN_SN, GARDEN_KEY, "Garden");
+
+    uint8_t plain[32];
+    uint8_t packet[32];
+    uint8_t decrypted[32];
+    uint8_t length = buildClimatePacket(plain, GARDEN_SN, 2137, 10132, 4512);
+    memcpy(packet, plain, length);
+    LoRaProtocol::encryptData(packet, length, GARDEN_KEY);
+
+    // Sensor sharing the key tag is tried too, but its serial number does not match
+    TEST_ASSERT_EQUAL_INT(garden, protocol.tryDecryptWithAllKeys(packet, length, decrypted));
+    TEST_ASSERT_EQUAL_MEMORY(plain, decrypted, length);
+
+    // Packet of an unknown sensor is left as received
+    length = buildEncryptedPacket(packet, FOREIGN_SN, FOREIGN_KEY);
+    TEST_ASSERT_EQUAL_INT(-1, protocol.tryDecryptWithAllKeys(packet, length, decrypted));
+    TEST_ASSERT_EQUAL_MEMORY(packet, decrypted, length);
+
+    // Corrupted packet of a known sensor
+    length = buildEncryptedPacket(packet, GARDEN_SN, GARDEN_KEY);
+    packet[length - 3] ^= 0x80;
+    TEST_ASSERT_EQUAL_INT(-1, protocol.tryDecryptWithAllKeys(packet, length, decrypted));
+}
+
+static void test_simulated_radio_round_trip()
+{
+    SimulatedRadio radio(logger);
+    TEST_ASSERT_TRUE(radio.init());
+
+    uint8_t packet[32];
+    uint8_t length = buildEncryptedPacket(packet, GARDEN_SN, GARDEN_KEY);
+    TEST_ASSERT_TRUE(radio.transmit(1000, packet, length, -80, 7.5f));
+
+    // Frame is delivered once its last symbol is on air
+    TEST_ASSERT_EQUAL(0, radio.advanceTo(1000 + radio.timeOnAir(length) - 1));
+    TEST_ASSERT_NULL(radio.peekFrame());
+    TEST_ASSERT_EQUAL(1, radio.advanceTo(1000 + radio.timeOnAir(length)));
+
+    LoRaFrame *frame = radio.peekFrame();
+    TEST_ASSERT_NOT_NULL(frame);
+    TEST_ASSERT_EQUAL(length, frame->length);
+    TEST_ASSERT_EQUAL_MEMORY(packet, frame->data, length);
+    TEST_ASSERT_EQUAL_INT16(-80, frame->rssi);
+    TEST_ASSERT_EQUAL_FLOAT(7.5f, frame->snr);
+    radio.releaseFrame();
+
+    TEST_ASSERT_NULL(radio.peekFrame());
+    TEST_ASSERT_EQUAL_UINT32(1, radio.getDeliveredFrames());
+}
+
+static void test_simulated_radio_collisions()
+{
+    SimulatedRadio radio(logger);
+    radio.init();
+
+    uint8_t packet[32];
+    uint8_t length = buildEncryptedPacket(packet, GARDEN_SN, GARDEN_KEY);
+
+    // Overlapping frames of similar power are both lost
+    radio.transmit(0, packet, length, -90, 5.0f);
+    radio.transmit(1000, packet, length, -92, 5.0f);
+    TEST_ASSERT_EQUAL(0, radio.flush());
+    TEST_ASSERT_EQUAL_UINT32(2, radio.getCollidedFrames());
+
+    // A frame louder by the capture margin survives
+    int64_t start = radio.getTime() + 1000;
+    radio.transmit(start, packet, length, -90, 5.0f);
+    radio.transmit(start + 1000, packet, length, -90 + SIMULATED_RADIO_CAPTURE_DB, 5.0f);
+    TEST_ASSERT_EQUAL(1, radio.flush());
+    TEST_ASSERT_EQUAL_UINT32(3, radio.getCollidedFrames());
+    TEST_ASSERT_EQUAL_INT16(-90 + SIMULATED_RADIO_CAPTURE_DB, radio.peekFrame()->rssi);
+    radio.releaseFrame();
+
+    // Frame below the demodulation limit of SF9
+    radio.transmit(radio.getTime() + 1000, packet, length, -120, -20.0f);
+    TEST_ASSERT_EQUAL(0, radio.flush());
+    TEST_ASSERT_EQUAL_UINT32(1, radio.getWeakFrames());
+}
+
+static void test_simulated_radio_script_line()
+{
+    SimulatedRadio radio(logger);
+    radio.init();
+
+    TEST_ASSERT_TRUE(radio.injectScriptLine("# comment"));
+    TEST_ASSERT_TRUE(radio.injectScriptLine("5000 -85 6.5 0102a0ff"));
+    TEST_ASSERT_FALSE(radio.injectScriptLine("not a line"));
+    TEST_ASSERT_EQUAL(1, radio.flush());
+
+    const uint8_t expected[] = {0x01, 0x02, 0xA0, 0xFF};
+    LoRaFrame *frame = radio.peekFrame();
+    TEST_ASSERT_NOT_NULL(frame);
+    TEST_ASSERT_EQUAL(sizeof(expected), frame->length);
+    TEST_ASSERT_EQUAL_MEMORY(expected, frame->data, sizeof(expected));
+    TEST_ASSERT_EQUAL_INT16(-85, frame->rssi);
+}
+
+static void test_received_packet_updates_sensor()
+{
+    SensorManager manager(logger, SENSORS_TEST_FILE);
+    SimulatedRadio radio(logger);
+    LoRaProtocol protocol(radio, manager, logger);
+    radio.init();
+    int garden = manager.addSensor(SensorType::BME280, GARDEN_SN, GARDEN_KEY, "Garden");
+
+    uint8_t packet[32];
+    uint8_t length = buildEncryptedPacket(packet, GARDEN_SN, GARDEN_KEY, -525);
+    radio.transmit(0, packet, length, -77, 8.0f);
+    length = buildEncryptedPacket(packet, FOREIGN_SN, FOREIGN_KEY);
+    radio.transmit(radio.timeOnAir(length) + 1000, packet, length, -70, 8.0f);
+    radio.flush();
+    TEST_ASSERT_EQUAL_UINT32(2, radio.getDeliveredFrames());
+
+    TEST_ASSERT_TRUE(protocol.processReceivedPacket());
+    TEST_ASSERT_EQUAL_INT(garden, protocol.getLastProcessedSensorIndex());
+
+    SensorView sensor = manager.getSensor(garden);
+    TEST_ASSERT_TRUE((bool)sensor);
+    TEST_ASSERT_EQUAL_INT16(-525, sensor->temperatureCenti);
+    TEST_ASSERT_EQUAL_UINT16(10132, sensor->pressureDeci);
+    TEST_ASSERT_EQUAL_UINT16(4512, sensor->humidityCenti);
+    TEST_ASSERT_EQUAL_UINT16(3300, sensor->batteryMillivolts);
+    TEST_ASSERT_EQUAL_INT(-77, sensor->rssi);
+
+    // Foreign packet is consumed without a sensor
+    TEST_ASSERT_FALSE(protocol.processReceivedPacket());
+    TEST_ASSERT_NULL(radio.peekFrame());
+    TEST_ASSERT_FALSE(protocol.processReceivedPacket());
+}
+
+static void test_meteo_packet_keeps_full_range()
+{
+    SensorManager manager(logger, SENSORS_TEST_FILE);
+    SimulatedRadio radio(logger);
+    LoRaProtocol protocol(radio, manager, logger);
+    radio.init();
+    int meteo = manager.addSensor(SensorType::METEO, GARDEN_SN, GARDEN_KEY, "Meteo");
+
+    // Highest wind speed the packet check accepts (raw is 1/9 m/s), rain in 1/5000 mm, rate in 1/500 mm/h
+    uint16_t values[] = {2137, 10132, 4512, 6000, 270, 7, 250};
+    uint8_t packet[32];
+    uint8_t length = buildPlainPacket(packet, SENSOR_TYPE_METEO, GARDEN_SN, values, 7);
+    LoRaProtocol::encryptData(packet, length, GARDEN_KEY);
+    radio.transmit(0, packet, length, -77, 8.0f);
+    radio.flush();
+    TEST_ASSERT_TRUE(protocol.processReceivedPacket());
+
+    SensorView sensor = manager.getSensor(meteo);
+    TEST_ASSERT_TRUE((bool)sensor);
+    TEST_ASSERT_EQUAL_UINT32(66667, sensor->windSpeedCenti);
+    TEST_ASSERT_EQUAL_STRING("666.7", sensor->getWindSpeedString().c_str());
+    TEST_ASSERT_EQUAL_UINT16(270, sensor->windDirection);
+    TEST_ASSERT_EQUAL_UINT32(14, sensor->rainAmountTenthMilli);
+    TEST_ASSERT_EQUAL_UINT32(14, sensor->dailyRainTotalTenthMilli);
+    TEST_ASSERT_EQUAL_UINT32(500, sensor->rainRateMilli);
+}
+
+int main()
+{
+    logger.init();
+    logger.setLogLevel(LogLevel::ERROR);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_packet_key_tag_matches_sensor_key_tag);
+    RUN_TEST(test_find_sensors_by_key_tag);
+    RUN_TEST(test_decrypt_and_verify_round_trip);
+    RUN_TEST(test_decrypt_and_verify_all_lengths);
+    RUN_TEST(test_decrypt_and_verify_rejects_wrong_key_or_serial);
+    RUN_TEST(test_decrypt_data_matches_fused_decryption);
+    RUN_TEST(test_try_decrypt_with_all_keys);
+    RUN_TEST(test_simulated_radio_round_trip);
+    RUN_TEST(test_simulated_radio_collisions);
+    RUN_TEST(test_simulated_radio_script_line);
+    RUN_TEST(test_received_packet_updates_sensor);
+    RUN_TEST(test_meteo_packet_keeps_full_range);
+    return UNITY_END();
+}
@@ -0,0 +1,156 @@
+/**
+ * expLORA Gateway Lite
+ *
+ * Unit tests of single producer single consumer ring buffer
+ *
+ * Copyright Pajenicko s.r.o., Igor Sverma (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <unity.h>
+#include <thread>
+#include "../../src/Data/SPSCRingBuffer.h"
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+static void test_empty_buffer()
+{
+    SPSCRingBuffer<uint32_t, 4> ring;
+    TEST_ASSERT_TRUE(ring.empty());
+    TEST_ASSERT_EQUAL(0, ring.size());
+    TEST_ASSERT_EQUAL(4, ring.capacity());
+    TEST_ASSERT_NULL(ring.peekRead());
+}
+
+static void test_fifo_order()
+{
+    SPSCRingBuffer<uint32_t, 4> ring;
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        uint32_t *slot = ring.acquireWrite();
+        TEST_ASSERT_NOT_NULL(slot);
+        *slot = 100 + i;
+        ring.commitWrite();
+    }
+    TEST_ASSERT_EQUAL(3, ring.size());
+
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        uint32_t *slot = ring.peekRead();
+        TEST_ASSERT_NOT_NULL(slot);
+        TEST_ASSERT_EQUAL_UINT32(100 + i, *slot);
+        ring.releaseRead();
+    }
+    TEST_ASSERT_TRUE(ring.empty());
+}
+
+static void test_full_buffer_refuses_write()
+{
+    SPSCRingBuffer<uint32_t, 4> ring;
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        *ring.acquireWrite() = i;
+        ring.commitWrite();
+    }
+    TEST_ASSERT_NULL(ring.acquireWrite());
+
+    // Slot is free again once the consumer released it
+    ring.releaseRead();
+    TEST_ASSERT_NOT_NULL(ring.acquireWrite());
+}
+
+static void test_peek_without_release_keeps_slot()
+{
+    SPSCRingBuffer<uint32_t, 2> ring;
+    *ring.acquireWrite() = 7;
+    ring.commitWrite();
+    TEST_ASSERT_EQUAL_UINT32(7, *ring.peekRead());
+    TEST_ASSERT_EQUAL_UINT32(7, *ring.peekRead());
+    TEST_ASSERT_EQUAL(1, ring.size());
+}
+
+static void test_wraps_around_indices()
+{
+    SPSCRingBuffer<uint32_t, 4> ring;
+    for (uint32_t i = 0; i < 1000; i++)
+    {
+        *ring.acquireWrite() = i;
+        ring.commitWrite();
+        TEST_ASSERT_EQUAL_UINT32(i, *ring.peekRead());
+        ring.releaseRead();
+    }
+    TEST_ASSERT_TRUE(ring.empty());
+}
+
+static SPSCRingBuffer<uint32_t, 8> threadRing;
+static const uint32_t THREAD_ITEMS = 100000;
+
+// Producer thread, waits while the ring is full
+static void produceItems()
+{
+    for (uint32_t i = 0; i < THREAD_ITEMS; i++)
+    {
+        uint32_t *slot;
+        while ((slot = threadRing.acquireWrite()) == nullptr)
+        {
+            std::this_thread::yield();
+        }
+        *slot = i;
+        threadRing.commitWrite();
+    }
+}
+
+// Consumer sees every item of a producer on another thread once and in order
+static void test_producer_consumer_threads()
+{
+    std::thread producer(produceItems);
+
+    uint32_t expected = 0;
+    bool ordered = true;
+    while (expected < THREAD_ITEMS)
+    {
+        uint32_t *slot = threadRing.peekRead();
+        if (slot == nullptr)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        ordered = ordered && *slot == expected;
+        expected++;
+        threadRing.releaseRead();
+    }
+    producer.join();
+
+    TEST_ASSERT_TRUE(ordered);
+    TEST_ASSERT_TRUE(threadRing.empty());
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_empty_buffer);
+    RUN_TEST(test_fifo_order);
+    RUN_TEST(test_full_buffer_refuses_write);
+    RUN_TEST(test_peek_without_release_keeps_slot);
+    RUN_TEST(test_wraps_around_indices);
+    RUN_TEST(test_producer_consumer_threads);
+    return UNITY_END();
+}
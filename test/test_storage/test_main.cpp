@@ -0,0 +1,370 @@
+/**
+ * expLORA Gateway Lite
+ *
+ * Unit tests of sensor registry file and state journal
+ *
+ * Copyright Pajenicko s.r.o., Igor Sverma (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <unity.h>
+#include <LittleFS.h>
+#include <vector>
+#include "../../src/Data/SensorStore.h"
+#include "../../src/Storage/SensorRegistryFile.h"
+#include "../../src/Storage/StateJournal.h"
+
+static const char *JOURNAL_FILE = "/test_state.jnl";
+static const char *SNAPSHOT_FILE = "/test_state.snap";
+
+static Logger logger;
+
+// Journal record as passed to ApplyFunction
+struct Applied
+{
+    uint32_t serialNumber;
+    StateJournal::Field field;
+    uint32_t value;
+};
+
+static std::vector<Applied> applied;
+
+static void collect(uint32_t serialNumber, StateJournal::Field field, uint32_t value)
+{
+    applied.push_back({serialNumber, field, value});
+}
+
+static void removeStateFiles()
+{
+    LittleFS.remove(JOURNAL_FILE);
+    LittleFS.remove(SNAPSHOT_FILE);
+    LittleFS.remove(String(SNAPSHOT_FILE) + ".tmp");
+}
+
+void setUp()
+{
+    TEST_ASSERT_TRUE(LittleFS.begin(true));
+    removeStateFiles();
+    applied.clear();
+}
+
+void tearDown()
+{
+    removeStateFiles();
+}
+
+// Read whole file
+static std::vector<uint8_t> readFile(const char *path)
+{
+    File file = LittleFS.open(path, "r");
+    std::vector<uint8_t> data(file ? file.size() : 0);
+    if (file)
+    {
+        file.read(data.data(), data.size());
+        file.close();
+    }
+    return data;
+}
+
+// Replace file content
+static void writeFile(const char *path, const std::vector<uint8_t> &data)
+{
+    File file = LittleFS.open(path, "w");
+    TEST_ASSERT_TRUE((bool)file);
+    file.write(data.data(), data.size());
+    file.close();
+}
+
+// Configure slot of store as sensor
+static void addSensor(SensorStore &store, size_t index, SensorType type, uint32_t serialNumber, const char *name)
+{
+    SensorReadings &sensor = store.beginWrite(index);
+    sensor.deviceType = type;
+    sensor.serialNumber = serialNumber;
+    sensor.deviceKey = serialNumber ^ 0x5A5A5A5A;
+    sensor.configured = true;
+    store.endWrite(index);
+    store.config(index).name = name;
+}
+
+// Registry of two sensors with an unconfigured slot between them
+static void encodeRegistry(std::vector<uint8_t> &buffer)
+{
+    SensorStore store;
+    TEST_ASSERT_TRUE(store.reserve(3));
+    addSensor(store, 0, SensorType::BME280, 0x010203, "Garden");
+    addSensor(store, 2, SensorType::METEO, 0x0A0B0C, "Roof");
+    store.config(0).customUrl = "http://host/?t=*TEMP*";
+    store.config(0).temperatureCorrection = -0.5f;
+    store.config(0).altitude = 320;
+    store.config(2).windSpeedCorrection = 1.25f;
+
+    TEST_ASSERT_EQUAL(2, SensorRegistryFile::encode(store, 3, buffer));
+}
+
+// Decode registry expecting an error
+static String decodeError(const std::vector<uint8_t> &buffer)
+{
+    SensorStore store;
+    size_t count = 99;
+    String error;
+    TEST_ASSERT_FALSE(SensorRegistryFile::decode(buffer.data(), buffer.size(), store, count, error));
+    TEST_ASSERT_EQUAL(0, count);
+    return error;
+}
+
+static void test_registry_round_trip()
+{
+    std::vector<uint8_t> buffer;
+    encodeRegistry(buffer);
+    TEST_ASSERT_EQUAL(sizeof(SensorRegistryFile::Header) + 2 * sizeof(SensorRegistryFile::Record) +
+                          strlen("Garden") + strlen("http://host/?t=*TEMP*") + strlen("Roof"),
+                      buffer.size());
+
+    SensorStore store;
+    size_t count = 0;
+    String error;
+    TEST_ASSERT_TRUE(SensorRegistryFile::decode(buffer.data(), buffer.size(), store, count, error));
+    TEST_ASSERT_EQUAL(2, count);
+
+    // Unconfigured slots are not stored, sensors are packed
+    TEST_ASSERT_EQUAL_HEX32(0x010203, store.readings(0).serialNumber);
+    TEST_ASSERT_EQUAL_HEX32(0x010203 ^ 0x5A5A5A5A, store.readings(0).deviceKey);
+    TEST_ASSERT_TRUE(store.readings(0).deviceType == SensorType::BME280);
+    TEST_ASSERT_EQUAL_STRING("Garden", store.config(0).name.c_str());
+    TEST_ASSERT_EQUAL_STRING("http://host/?t=*TEMP*", store.config(0).customUrl.c_str());
+    TEST_ASSERT_EQUAL_INT(320, store.config(0).altitude);
+    TEST_ASSERT_EQUAL_INT32(-50, store.config(0).temperatureOffset);
+
+    TEST_ASSERT_EQUAL_HEX32(0x0A0B0C, store.readings(1).serialNumber);
+    TEST_ASSERT_TRUE(store.readings(1).deviceType == SensorType::METEO);
+    TEST_ASSERT_EQUAL_STRING("Roof", store.config(1).name.c_str());
+    TEST_ASSERT_EQUAL_STRING("", store.config(1).customUrl.c_str());
+    TEST_ASSERT_EQUAL_INT32(1250, store.config(1).windSpeedFactor);
+}
+
+static void test_registry_empty()
+{
+    SensorStore empty;
+    std::vector<uint8_t> buffer;
+    TEST_ASSERT_EQUAL(0, SensorRegistryFile::encode(empty, 0, buffer));
+
+    SensorStore store;
+    size_t count = 99;
+    String error;
+    TEST_ASSERT_TRUE(SensorRegistryFile::decode(buffer.data(), buffer.size(), store, count, error));
+    TEST_ASSERT_EQUAL(0, count);
+}
+
+static void test_registry_rejects_corrupt_crc()
+{
+    std::vector<uint8_t> buffer;
+    encodeRegistry(buffer);
+
+    // Flipped bit in a record
+    std::vector<uint8_t> corrupted = buffer;
+    corrupted[sizeof(SensorRegistryFile::Header) + 1] ^= 0x10;
+    TEST_ASSERT_EQUAL_STRING("CRC mismatch", decodeError(corrupted).c_str());
+
+    // Flipped bit in the string table
+    corrupted = buffer;
+    corrupted.back() ^= 0x01;
+    TEST_ASSERT_EQUAL_STRING("CRC mismatch", decodeError(corrupted).c_str());
+
+    // Wrong CRC in the header
+    corrupted = buffer;
+    corrupted[offsetof(SensorRegistryFile::Header, crc)] ^= 0x80;
+    TEST_ASSERT_EQUAL_STRING("CRC mismatch", decodeError(corrupted).c_str());
+}
+
+static void test_registry_rejects_bad_header()
+{
+    std::vector<uint8_t> buffer;
+    encodeRegistry(buffer);
+
+    std::vector<uint8_t> corrupted(buffer.begin(), buffer.begin() + 10);
+    TEST_ASSERT_EQUAL_STRING("file too short", decodeError(corrupted).c_str());
+
+    corrupted = buffer;
+    corrupted[0] ^= 0xFF;
+    TEST_ASSERT_EQUAL_STRING("bad magic", decodeError(corrupted).c_str());
+
+    corrupted = buffer;
+    corrupted.pop_back();
+    TEST_ASSERT_EQUAL_STRING("size mismatch", decodeError(corrupted).c_str());
+}
+
+static void test_journal_replay_without_files()
+{
+    StateJournal journal(logger, JOURNAL_FILE, SNAPSHOT_FILE);
+    TEST_ASSERT_TRUE(journal.replay(collect));
+    TEST_ASSERT_EQUAL(0, applied.size());
+    TEST_ASSERT_EQUAL(0, journal.getReplayedRecords());
+}
+
+static void test_journal_replays_appended_records()
+{
+    {
+        StateJournal journal(logger, JOURNAL_FILE, SNAPSHOT_FILE);
+        journal.replay(collect);
+
+        StateJournal::Record records[] = {
+            StateJournal::makeRecord(0x010203, StateJournal::Field::DAILY_RAIN_TOTAL, 12.5f),
+            StateJournal::makeRecord(0x010203, StateJournal::Field::LAST_RAIN_RESET, (uint32_t)1700000000),
+        };
+        TEST_ASSERT_TRUE(journal.append(records, 2));
+
+        StateJournal::Record later = StateJournal::makeRecord(0x0A0B0C, StateJournal::Field::DAILY_RAIN_TOTAL, 3.0f);
+        TEST_ASSERT_TRUE(journal.append(&later, 1));
+        TEST_ASSERT_EQUAL(3, journal.getJournalRecords());
+    }
+
+    // After reboot the records come back in the order they were written
+    StateJournal journal(logger, JOURNAL_FILE, SNAPSHOT_FILE);
+    TEST_ASSERT_TRUE(journal.replay(collect));
+    TEST_ASSERT_EQUAL(3, applied.size());
+    TEST_ASSERT_EQUAL(3, journal.getReplayedRecords());
+    TEST_ASSERT_EQUAL(0, journal.getCorruptedRecords());
+
+    TEST_ASSERT_EQUAL_HEX32(0x010203, applied[0].serialNumber);
+    TEST_ASSERT_TRUE(applied[0].field == StateJournal::Field::DAILY_RAIN_TOTAL);
+    TEST_ASSERT_EQUAL_FLOAT(12.5f, StateJournal::toFloat(applied[0].value));
+    TEST_ASSERT_TRUE(applied[1].field == StateJournal::Field::LAST_RAIN_RESET);
+    TEST_ASSERT_EQUAL_UINT32(1700000000, applied[1].value);
+    TEST_ASSERT_EQUAL_HEX32(0x0A0B0C, applied[2].serialNumber);
+    TEST_ASSERT_EQUAL_FLOAT(3.0f, StateJournal::toFloat(applied[2].value));
+}
+
+static void test_journal_stops_at_corrupted_record()
+{
+    {
+        StateJournal journal(logger, JOURNAL_FILE, SNAPSHOT_FILE);
+        journal.replay(collect);
+        StateJournal::Record records[] = {
+            StateJournal::makeRecord(1, StateJournal::Field::DAILY_RAIN_TOTAL, 1.0f),
+            StateJournal::makeRecord(2, StateJournal::Field::DAILY_RAIN_TOTAL, 2.0f),
+            StateJournal::makeRecord(3, StateJournal::Field::DAILY_RAIN_TOTAL, 3.0f),
+        };
+        TEST_ASSERT_TRUE(journal.append(records, 3));
+    }
+
+    // Torn write of the second record
+    std::vector<uint8_t> data = readFile(JOURNAL_FILE);
+    TEST_ASSERT_EQUAL(3 * sizeof(StateJournal::Record), data.size());
+    data[sizeof(StateJournal::Record) + offsetof(StateJournal::Record, value)] ^= 0x01;
+    writeFile(JOURNAL_FILE, data);
+
+    StateJournal journal(logger, JOURNAL_FILE, SNAPSHOT_FILE);
+    TEST_ASSERT_TRUE(journal.replay(collect));
+    TEST_ASSERT_EQUAL(1, applied.size());
+    TEST_ASSERT_EQUAL_UINT32(1, applied[0].serialNumber);
+    TEST_ASSERT_EQUAL(1, journal.getCorruptedRecords());
+    TEST_ASSERT_TRUE(journal.needsCompaction());
+}
+
+static void test_journal_ignores_truncated_record()
+{
+    {
+        StateJournal journal(logger, JOURNAL_FILE, SNAPSHOT_FILE);
+        journal.replay(collect);
+        StateJournal::Record records[] = {
+            StateJournal::makeRecord(1, StateJournal::Field::DAILY_RAIN_TOTAL, 1.0f),
+            StateJournal::makeRecord(2, StateJournal::Field::DAILY_RAIN_TOTAL, 2.0f),
+        };
+        TEST_ASSERT_TRUE(journal.append(records, 2));
+    }
+
+    std::vector<uint8_t> data = readFile(JOURNAL_FILE);
+    data.resize(data.size() - 3);
+    writeFile(JOURNAL_FILE, data);
+
+    StateJournal journal(logger, JOURNAL_FILE, SNAPSHOT_FILE);
+    TEST_ASSERT_TRUE(journal.replay(collect));
+    TEST_ASSERT_EQUAL(1, applied.size());
+    TEST_ASSERT_EQUAL(1, journal.getCorruptedRecords());
+}
+
+static void test_journal_replays_snapshot_after_compaction()
+{
+    {
+        StateJournal journal(logger, JOURNAL_FILE, SNAPSHOT_FILE);
+        journal.replay(collect);
+        StateJournal::Record record = StateJournal::makeRecord(1, StateJournal::Field::DAILY_RAIN_TOTAL, 1.0f);
+        TEST_ASSERT_TRUE(journal.append(&record, 1));
+        record = StateJournal::makeRecord(1, StateJournal::Field::DAILY_RAIN_TOTAL, 2.0f);
+        TEST_ASSERT_TRUE(journal.append(&record, 1));
+
+        // Snapshot holds only the latest value, the journal starts over
+        StateJournal::Record latest = StateJournal::makeRecord(1, StateJournal::Field::DAILY_RAIN_TOTAL, 2.0f);
+        TEST_ASSERT_TRUE(journal.compact(&latest, 1));
+        TEST_ASSERT_EQUAL(0, journal.getJournalRecords());
+        TEST_ASSERT_FALSE(LittleFS.exists(JOURNAL_FILE));
+
+        record = StateJournal::makeRecord(1, StateJournal::Field::DAILY_RAIN_TOTAL, 4.0f);
+        TEST_ASSERT_TRUE(journal.append(&record, 1));
+    }
+
+    StateJournal journal(logger, JOURNAL_FILE, SNAPSHOT_FILE);
+    TEST_ASSERT_TRUE(journal.replay(collect));
+    TEST_ASSERT_EQUAL(2, applied.size());
+    TEST_ASSERT_EQUAL_FLOAT(2.0f, StateJournal::toFloat(applied[0].value));
+    TEST_ASSERT_EQUAL_FLOAT(4.0f, StateJournal::toFloat(applied[1].value));
+    TEST_ASSERT_EQUAL(1, journal.getJournalRecords());
+}
+
+static void test_journal_skips_records_covered_by_snapshot()
+{
+    std::vector<uint8_t> oldJournal;
+    {
+        StateJournal journal(logger, JOURNAL_FILE, SNAPSHOT_FILE);
+        journal.replay(collect);
+        StateJournal::Record records[] = {
+            StateJournal::makeRecord(1, StateJournal::Field::DAILY_RAIN_TOTAL, 1.0f),
+            StateJournal::makeRecord(1, StateJournal::Field::DAILY_RAIN_TOTAL, 2.0f),
+        };
+        TEST_ASSERT_TRUE(journal.append(records, 2));
+        oldJournal = readFile(JOURNAL_FILE);
+
+        StateJournal::Record latest = StateJournal::makeRecord(1, StateJournal::Field::DAILY_RAIN_TOTAL, 2.0f);
+        TEST_ASSERT_TRUE(journal.compact(&latest, 1));
+    }
+
+    // Power lost after the snapshot was renamed but before the journal was removed
+    writeFile(JOURNAL_FILE, oldJournal);
+
+    StateJournal journal(logger, JOURNAL_FILE, SNAPSHOT_FILE);
+    TEST_ASSERT_TRUE(journal.replay(collect));
+    TEST_ASSERT_EQUAL(1, applied.size());
+    TEST_ASSERT_EQUAL_FLOAT(2.0f, StateJournal::toFloat(applied[0].value));
+}
+
+int main()
+{
+    logger.init();
+    logger.setLogLevel(LogLevel::ERROR);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_registry_round_trip);
+    RUN_TEST(test_registry_empty);
+    RUN_TEST(test_registry_rejects_corrupt_crc);
+    RUN_TEST(test_registry_rejects_bad_header);
+    RUN_TEST(test_journal_replay_without_files);
+    RUN_TEST(test_journal_replays_appended_records);
+    RUN_TEST(test_journal_stops_at_corrupted_record);
+    RUN_TEST(test_journal_ignores_truncated_record);
+    RUN_TEST(test_journal_replays_snapshot_after_compaction);
+    RUN_TEST(test_journal_skips_records_covered_by_snapshot);
+    return UNITY_END();
+}
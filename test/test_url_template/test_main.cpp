@@ -0,0 +1,151 @@
+/**
+ * expLORA Gateway Lite
+ *
+ * Unit tests of custom URL templates
+ *
+ * Copyright Pajenicko s.r.o., Igor Sverma (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <unity.h>
+#include "../../src/Data/UrlTemplate.h"
+#include "../../src/Data/SensorData.h"
+
+static SensorReadings climate;
+
+void setUp()
+{
+    climate = SensorReadings();
+    climate.serialNumber = 0xA1B2C3;
+    climate.deviceType = SensorType::BME280;
+    climate.configured = true;
+    climate.temperatureCenti = -525;
+    climate.humidityCenti = 4512;
+    climate.pressureDeci = 10132;
+    climate.batteryMillivolts = 3290;
+    climate.rssi = -97;
+}
+
+void tearDown()
+{
+}
+
+// URL expanded for sensor, "<none>" if it does not fit into size bytes
+static String expanded(const char *url, const SensorReadings &sensor, size_t size = 256)
+{
+    UrlTemplate urlTemplate;
+    TEST_ASSERT_TRUE(urlTemplate.compile(url));
+
+    char buffer[256];
+    size_t length = urlTemplate.expand(sensor, buffer, size);
+    if (length == 0)
+    {
+        return String("<none>");
+    }
+    TEST_ASSERT_EQUAL(strlen(buffer), length);
+    return String(buffer);
+}
+
+static void test_expand_placeholders()
+{
+    TEST_ASSERT_EQUAL_STRING(
+        "http://host/add?sn=a1b2c3&t=-5.25&h=45.12&p=1013.20&b=3.29&rssi=-97&type=1",
+        expanded("http://host/add?sn=*SN*&t=*TEMP*&h=*HUM*&p=*PRESS*&b=*BAT*&rssi=*RSSI*&type=*TYPE*", climate).c_str());
+}
+
+static void test_expand_without_placeholders()
+{
+    TEST_ASSERT_EQUAL_STRING("http://host/ping", expanded("http://host/ping", climate).c_str());
+}
+
+static void test_expand_adjacent_placeholders()
+{
+    TEST_ASSERT_EQUAL_STRING("-5.2545.12", expanded("*TEMP**HUM*", climate).c_str());
+}
+
+static void test_unknown_placeholder_is_literal()
+{
+    // Closing asterisk of an unknown name may open the next placeholder
+    TEST_ASSERT_EQUAL_STRING("a=*FOO*&b=*x-5.25", expanded("a=*FOO*&b=*x*TEMP*", climate).c_str());
+}
+
+static void test_missing_value_keeps_placeholder()
+{
+    // Climate sensor has no CO2 or wind readings
+    TEST_ASSERT_EQUAL_STRING("co2=*PPM*&w=*WIND_SPEED*", expanded("co2=*PPM*&w=*WIND_SPEED*", climate).c_str());
+}
+
+static void test_meteo_values()
+{
+    SensorReadings meteo = climate;
+    meteo.deviceType = SensorType::METEO;
+    meteo.windSpeedCenti = 345;
+    meteo.windDirection = 270;
+    meteo.rainAmountTenthMilli = 12500;
+    meteo.dailyRainTotalTenthMilli = 123400;
+    meteo.rainRateMilli = 600;
+    TEST_ASSERT_EQUAL_STRING("w=3.5&d=270&r=1.3&dr=12.3&rr=0.6",
+                             expanded("w=*WIND_SPEED*&d=*WIND_DIR*&r=*RAIN*&dr=*DAILY_RAIN*&rr=*RAIN_RATE*", meteo).c_str());
+}
+
+static void test_expand_reports_small_buffer()
+{
+    // "t=-5.25" needs 8 bytes with the terminator
+    TEST_ASSERT_EQUAL_STRING("<none>", expanded("t=*TEMP*", climate, 7).c_str());
+    TEST_ASSERT_EQUAL_STRING("t=-5.25", expanded("t=*TEMP*", climate, 8).c_str());
+    TEST_ASSERT_EQUAL_STRING("<none>", expanded("http://host", climate, 11).c_str());
+}
+
+static void test_update_recompiles_changed_url()
+{
+    UrlTemplate urlTemplate;
+    TEST_ASSERT_TRUE(urlTemplate.empty());
+    TEST_ASSERT_TRUE(urlTemplate.update("a=*TEMP*"));
+    TEST_ASSERT_TRUE(urlTemplate.update("b=*HUM*"));
+
+    char buffer[32];
+    TEST_ASSERT_GREATER_THAN(0, urlTemplate.expand(climate, buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL_STRING("b=45.12", buffer);
+}
+
+static void test_too_many_tokens()
+{
+    String url;
+    for (int i = 0; i < URL_TEMPLATE_MAX_TOKENS; i++)
+    {
+        url += "x*SN*";
+    }
+
+    UrlTemplate urlTemplate;
+    TEST_ASSERT_FALSE(urlTemplate.compile(url));
+
+    char buffer[16];
+    TEST_ASSERT_EQUAL(0, urlTemplate.expand(climate, buffer, sizeof(buffer)));
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_expand_placeholders);
+    RUN_TEST(test_expand_without_placeholders);
+    RUN_TEST(test_expand_adjacent_placeholders);
+    RUN_TEST(test_unknown_placeholder_is_literal);
+    RUN_TEST(test_missing_value_keeps_placeholder);
+    RUN_TEST(test_meteo_values);
+    RUN_TEST(test_expand_reports_small_buffer);
+    RUN_TEST(test_update_recompiles_changed_url);
+    RUN_TEST(test_too_many_tokens);
+    return UNITY_END();
+}
@@ -0,0 +1,175 @@
+/**
+ * expLORA Gateway Lite
+ *
+ * Host shim - Arduino core
+ *
+ * Copyright Pajenicko s.r.o., Igor Sverma (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "Arduino.h"
+#include "esp_system.h"
+#include <chrono>
+#include <random>
+#include <thread>
+#include <unistd.h>
+
+HardwareSerial Serial;
+EspClass ESP;
+
+static const std::chrono::steady_clock::time_point bootTime = std::chrono::steady_clock::now();
+static std::mt19937 randomGenerator;
+
+size_t HardwareSerial::write(uint8_t c)
+{
+    return fputc(c, stdout) == EOF ? 0 : 1;
+}
+
+size_t HardwareSerial::write(const uint8_t *buffer, size_t size)
+{
+    return fwrite(buffer, 1, size, stdout);
+}
+
+void HardwareSerial::flush()
+{
+    fflush(stdout);
+}
+
+// Host has no fixed heap; report the physical memory of the machine
+uint32_t EspClass::getHeapSize()
+{
+    long pages = sysconf(_SC_PHYS_PAGES);
+    long pageSize = sysconf(_SC_PAGE_SIZE);
+    uint64_t size = (uint64_t)pages * pageSize;
+    return size > UINT32_MAX ? UINT32_MAX : (uint32_t)size;
+}
+
+uint32_t EspClass::getFreeHeap()
+{
+    long pages = sysconf(_SC_AVPHYS_PAGES);
+    long pageSize = sysconf(_SC_PAGE_SIZE);
+    uint64_t size = (uint64_t)pages * pageSize;
+    return size > UINT32_MAX ? UINT32_MAX : (uint32_t)size;
+}
+
+uint32_t EspClass::getMinFreeHeap()
+{
+    return getFreeHeap();
+}
+
+uint32_t EspClass::getMaxAllocHeap()
+{
+    return getFreeHeap();
+}
+
+void EspClass::restart()
+{
+    fflush(stdout);
+    exit(0);
+}
+
+unsigned long millis()
+{
+    return (unsigned long)(esp_timer_get_time() / 1000);
+}
+
+unsigned long micros()
+{
+    return (unsigned long)esp_timer_get_time();
+}
+
+void delay(uint32_t ms)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void delayMicroseconds(uint32_t us)
+{
+    std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+void yield()
+{
+    std::this_thread::yield();
+}
+
+long random(long max)
+{
+    if (max <= 0)
+    {
+        return 0;
+    }
+    return std::uniform_int_distribution<long>(0, max - 1)(randomGenerator);
+}
+
+long random(long min, long max)
+{
+    if (min >= max)
+    {
+        return min;
+    }
+    return min + random(max - min);
+}
+
+uint32_t esp_random()
+{
+    return randomGenerator();
+}
+
+void randomSeed(unsigned long seed)
+{
+    randomGenerator.seed(seed);
+}
+
+void configTime(long gmtOffset_sec, int daylightOffset_sec, const char *server1,
+                const char *server2, const char *server3)
+{
+    (void)gmtOffset_sec, (void)daylightOffset_sec, (void)server1, (void)server2, (void)server3;
+}
+
+void configTzTime(const char *tz, const char *server1, const char *server2, const char *server3)
+{
+    (void)server1, (void)server2, (void)server3;
+    setenv("TZ", tz, 1);
+    tzset();
+}
+
+bool getLocalTime(struct tm *info, uint32_t ms)
+{
+    (void)ms;
+    time_t now = time(nullptr);
+    localtime_r(&now, info);
+    return true;
+}
+
+bool psramInit()
+{
+    return false;
+}
+
+bool psramFound()
+{
+    return false;
+}
+
+extern "C" bool esp_spiram_is_initialized(void)
+{
+    return false;
+}
+
+int64_t esp_timer_get_time()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - bootTime).count();
+}
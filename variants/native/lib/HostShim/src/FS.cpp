@@ -0,0 +1,306 @@
+/**
+ * expLORA Gateway Lite
+ *
+ * Host shim - Arduino file system
+ *
+ * Copyright Pajenicko s.r.o., Igor Sverma (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "LittleFS.h"
+#include <dirent.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <vector>
+
+fs::LittleFSFS LittleFS;
+
+namespace fs
+{
+    static std::string baseName(const std::string &path)
+    {
+        size_t slash = path.rfind('/');
+        return slash == std::string::npos ? path : path.substr(slash + 1);
+    }
+
+    File::File(FILE *file, const std::string &path)
+        : handle(file, fclose), filePath(path), fileName(baseName(path)), directory(false), nextEntry(0)
+    {
+    }
+
+    File::File(const std::string &root, const std::string &path, std::vector<std::string> listing)
+        : filePath(path), fileName(baseName(path)), directory(true),
+          entries(std::make_shared<std::vector<std::string>>(std::move(listing))), nextEntry(0), hostRoot(root)
+    {
+    }
+
+    size_t File::write(uint8_t c)
+    {
+        return handle ? fwrite(&c, 1, 1, handle.get()) : 0;
+    }
+
+    size_t File::write(const uint8_t *buffer, size_t size)
+    {
+        return handle ? fwrite(buffer, 1, size, handle.get()) : 0;
+    }
+
+    int File::available()
+    {
+        if (!handle)
+        {
+            return 0;
+        }
+        size_t total = size();
+        size_t pos = position();
+        return pos < total ? (int)(total - pos) : 0;
+    }
+
+    int File::read()
+    {
+        return handle ? fgetc(handle.get()) : -1;
+    }
+
+    int File::peek()
+    {
+        if (!handle)
+        {
+            return -1;
+        }
+        int c = fgetc(handle.get());
+        if (c != EOF)
+        {
+            ungetc(c, handle.get());
+        }
+        return c;
+    }
+
+    size_t File::readBytes(char *buffer, size_t length)
+    {
+        return handle ? fread(buffer, 1, length, handle.get()) : 0;
+    }
+
+    void File::flush()
+    {
+        if (handle)
+        {
+            fflush(handle.get());
+        }
+    }
+
+    bool File::seek(uint32_t pos, SeekMode mode)
+    {
+        static const int whence[] = {SEEK_SET, SEEK_CUR, SEEK_END};
+        return handle && fseek(handle.get(), pos, whence[mode]) == 0;
+    }
+
+    size_t File::position() const
+    {
+        return handle ? (size_t)ftell(handle.get()) : 0;
+    }
+
+    size_t File::size() const
+    {
+        if (!handle)
+        {
+            return 0;
+        }
+
+        fflush(handle.get());
+        struct stat st;
+        if (fstat(fileno(handle.get()), &st) != 0)
+        {
+            return 0;
+        }
+        return st.st_size;
+    }
+
+    void File::close()
+    {
+        handle.reset();
+        entries.reset();
+        directory = false;
+    }
+
+    File File::openNextFile(const char *mode)
+    {
+        if (!directory || !entries || nextEntry >= entries->size())
+        {
+            return File();
+        }
+
+        std::string path = filePath;
+        if (path.empty() || path.back() != '/')
+        {
+            path += '/';
+        }
+        path += (*entries)[nextEntry++];
+
+        FS fs(hostRoot);
+        return fs.open(path.c_str(), mode);
+    }
+
+    std::string FS::hostPath(const char *path) const
+    {
+        std::string result = root;
+        if (path == nullptr || path[0] != '/')
+        {
+            result += '/';
+        }
+        if (path != nullptr)
+        {
+            result += path;
+        }
+        return result;
+    }
+
+    File FS::open(const char *path, const char *mode, const bool create)
+    {
+        (void)create;
+        std::string host = hostPath(path);
+
+        struct stat st;
+        if (stat(host.c_str(), &st) == 0 && S_ISDIR(st.st_mode))
+        {
+            std::vector<std::string> listing;
+            DIR *dir = opendir(host.c_str());
+            if (dir != nullptr)
+            {
+                struct dirent *entry;
+                while ((entry = readdir(dir)) != nullptr)
+                {
+                    if (strcmp(entry->d_name, ".") != 0 && strcmp(entry->d_name, "..") != 0)
+                    {
+                        listing.push_back(entry->d_name);
+                    }
+                }
+                closedir(dir);
+            }
+            std::sort(listing.begin(), listing.end());
+            return File(root, path, std::move(listing));
+        }
+
+        // Binary mode so sizes and positions match the device
+        std::string hostMode = mode;
+        if (hostMode.find('b') == std::string::npos)
+        {
+            hostMode += 'b';
+        }
+
+        FILE *file = fopen(host.c_str(), hostMode.c_str());
+        if (file == nullptr)
+        {
+            return File();
+        }
+        return File(file, path);
+    }
+
+    bool FS::exists(const char *path)
+    {
+        struct stat st;
+        return stat(hostPath(path).c_str(), &st) == 0;
+    }
+
+    bool FS::remove(const char *path)
+    {
+        return ::unlink(hostPath(path).c_str()) == 0;
+    }
+
+    bool FS::rename(const char *pathFrom, const char *pathTo)
+    {
+        return ::rename(hostPath(pathFrom).c_str(), hostPath(pathTo).c_str()) == 0;
+    }
+
+    bool FS::mkdir(const char *path)
+    {
+        return ::mkdir(hostPath(path).c_str(), 0755) == 0 || errno == EEXIST;
+    }
+
+    bool FS::rmdir(const char *path)
+    {
+        return ::rmdir(hostPath(path).c_str()) == 0;
+    }
+
+    static const char *littleFsRoot()
+    {
+        const char *root = getenv("LITTLEFS_ROOT");
+        return root != nullptr && root[0] != '\0' ? root : "littlefs";
+    }
+
+    LittleFSFS::LittleFSFS() : FS(littleFsRoot())
+    {
+    }
+
+    bool LittleFSFS::begin(bool formatOnFail, const char *basePath, uint8_t maxOpenFiles, const char *partitionLabel)
+    {
+        (void)basePath, (void)maxOpenFiles, (void)partitionLabel;
+
+        struct stat st;
+        if (stat(root.c_str(), &st) == 0)
+        {
+            return S_ISDIR(st.st_mode);
+        }
+        return formatOnFail && ::mkdir(root.c_str(), 0755) == 0;
+    }
+
+    bool LittleFSFS::format()
+    {
+        DIR *dir = opendir(root.c_str());
+        if (dir == nullptr)
+        {
+            return ::mkdir(root.c_str(), 0755) == 0;
+        }
+
+        struct dirent *entry;
+        while ((entry = readdir(dir)) != nullptr)
+        {
+            if (entry->d_type == DT_REG)
+            {
+                ::unlink((root + "/" + entry->d_name).c_str());
+            }
+        }
+        closedir(dir);
+        return true;
+    }
+
+    size_t LittleFSFS::totalBytes()
+    {
+        return 0xE0000;
+    }
+
+    size_t LittleFSFS::usedBytes()
+    {
+        size_t used = 0;
+        DIR *dir = opendir(root.c_str());
+        if (dir == nullptr)
+        {
+            return 0;
+        }
+
+        struct dirent *entry;
+        while ((entry = readdir(dir)) != nullptr)
+        {
+            struct stat st;
+            if (stat((root + "/" + entry->d_name).c_str(), &st) == 0 && S_ISREG(st.st_mode))
+            {
+                used += st.st_size;
+            }
+        }
+        closedir(dir);
+        return used;
+    }
+}
@@ -0,0 +1,121 @@
+/**
+ * expLORA Gateway Lite
+ *
+ * Host shim - Arduino file system
+ *
+ * Copyright Pajenicko s.r.o., Igor Sverma (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Arduino.h"
+
+#define FILE_READ "r"
+#define FILE_WRITE "w"
+#define FILE_APPEND "a"
+
+namespace fs
+{
+    enum SeekMode
+    {
+        SeekSet = 0,
+        SeekCur = 1,
+        SeekEnd = 2
+    };
+
+    /**
+     * Open file or directory on host file system
+     */
+    class File : public Stream
+    {
+    private:
+        std::shared_ptr<FILE> handle;
+        std::string filePath;
+        std::string fileName;
+        bool directory;
+        std::shared_ptr<std::vector<std::string>> entries; // Directory listing
+        size_t nextEntry;
+        std::string hostRoot;
+
+    public:
+        File() : directory(false), nextEntry(0) {}
+        File(FILE *file, const std::string &path);
+        File(const std::string &root, const std::string &path, std::vector<std::string> listing);
+
+        size_t write(uint8_t c) override;
+        size_t write(const uint8_t *buffer, size_t size) override;
+        using Print::write;
+        int available() override;
+        int read() override;
+        int peek() override;
+        size_t readBytes(char *buffer, size_t length) override;
+        size_t read(uint8_t *buffer, size_t size) { return readBytes((char *)buffer, size); }
+        void flush() override;
+
+        bool seek(uint32_t pos, SeekMode mode = SeekSet);
+        size_t position() const;
+        size_t size() const;
+        void close();
+        operator bool() const { return handle != nullptr || directory; }
+
+        const char *path() const { return filePath.c_str(); }
+        const char *name() const { return fileName.c_str(); }
+        bool isDirectory() const { return directory; }
+        File openNextFile(const char *mode = FILE_READ);
+        void rewindDirectory() { nextEntry = 0; }
+    };
+
+    /**
+     * File system rooted in a host directory
+     *
+     * Paths are absolute within the file system ("/sensors.json").
+     */
+    class FS
+    {
+    protected:
+        std::string root;
+
+        std::string hostPath(const char *path) const;
+
+    public:
+        explicit FS(const std::string &rootDirectory) : root(rootDirectory) {}
+        virtual ~FS() {}
+
+        File open(const char *path, const char *mode = FILE_READ, const bool create = false);
+        File open(const String &path, const char *mode = FILE_READ, const bool create = false) { return open(path.c_str(), mode, create); }
+        bool exists(const char *path);
+        bool exists(const String &path) { return exists(path.c_str()); }
+        bool remove(const char *path);
+        bool remove(const String &path) { return remove(path.c_str()); }
+        bool rename(const char *pathFrom, const char *pathTo);
+        bool rename(const String &pathFrom, const String &pathTo) { return rename(pathFrom.c_str(), pathTo.c_str()); }
+        bool mkdir(const char *path);
+        bool mkdir(const String &path) { return mkdir(path.c_str()); }
+        bool rmdir(const char *path);
+        bool rmdir(const String &path) { return rmdir(path.c_str()); }
+    };
+}
+
+using fs::File;
+using fs::FS;
+using fs::SeekMode;
+using fs::SeekCur;
+using fs::SeekEnd;
+using fs::SeekSet;
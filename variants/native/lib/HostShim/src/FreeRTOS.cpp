@@ -0,0 +1,333 @@
+/**
+ * expLORA Gateway Lite
+ *
+ * Host shim - FreeRTOS on std::thread
+ *
+ * Copyright Pajenicko s.r.o., Igor Sverma (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "esp_timer.h"
+#include <string.h>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct HostTask
+{
+    std::string name;
+    std::mutex mutex;
+    std::condition_variable notified;
+    uint32_t notifyCount = 0;
+};
+
+struct HostQueue
+{
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::vector<uint8_t> storage;
+    size_t itemSize;
+    size_t length;
+    size_t head = 0;
+    size_t count = 0;
+};
+
+static thread_local HostTask *currentTask = nullptr;
+static std::recursive_mutex criticalMutex;
+
+// Wait on condition with FreeRTOS tick timeout
+template <typename Predicate>
+static bool waitFor(std::condition_variable &cv, std::unique_lock<std::mutex> &lock, TickType_t ticks, Predicate ready)
+{
+    if (ticks == portMAX_DELAY)
+    {
+        cv.wait(lock, ready);
+        return true;
+    }
+    return cv.wait_for(lock, std::chrono::milliseconds(ticks), ready);
+}
+
+void hostEnterCritical()
+{
+    criticalMutex.lock();
+}
+
+void hostExitCritical()
+{
+    criticalMutex.unlock();
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function, const char *name, uint32_t stackDepth,
+                                   void *parameters, UBaseType_t priority, TaskHandle_t *createdTask,
+                                   BaseType_t coreId)
+{
+    (void)stackDepth, (void)priority, (void)coreId;
+
+    HostTask *task = new HostTask();
+    task->name = name ? name : "";
+    if (createdTask)
+    {
+        *createdTask = task;
+    }
+
+    std::thread([function, parameters, task]()
+                {
+                    currentTask = task;
+                    function(parameters);
+                })
+        .detach();
+    return pdPASS;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t function, const char *name, uint32_t stackDepth,
+                       void *parameters, UBaseType_t priority, TaskHandle_t *createdTask)
+{
+    return xTaskCreatePinnedToCore(function, name, stackDepth, parameters, priority, createdTask, tskNO_AFFINITY);
+}
+
+// Deleting other tasks is not supported; a task deleting itself parks forever
+void vTaskDelete(TaskHandle_t task)
+{
+    if (task == nullptr || task == currentTask)
+    {
+        while (true)
+        {
+            std::this_thread::sleep_for(std::chrono::hours(24));
+        }
+    }
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(ticks));
+}
+
+TickType_t xTaskGetTickCount()
+{
+    return (TickType_t)(esp_timer_get_time() / 1000);
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle()
+{
+    if (currentTask == nullptr)
+    {
+        currentTask = new HostTask();
+        currentTask->name = "main";
+    }
+    return currentTask;
+}
+
+const char *pcTaskGetName(TaskHandle_t task)
+{
+    if (task == nullptr)
+    {
+        task = xTaskGetCurrentTaskHandle();
+    }
+    return task->name.c_str();
+}
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task)
+{
+    (void)task;
+    return 0;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clearCountOnExit, TickType_t ticksToWait)
+{
+    HostTask *task = xTaskGetCurrentTaskHandle();
+    std::unique_lock<std::mutex> lock(task->mutex);
+
+    waitFor(task->notified, lock, ticksToWait, [task]()
+            { return task->notifyCount > 0; });
+
+    uint32_t count = task->notifyCount;
+    if (count > 0)
+    {
+        task->notifyCount = clearCountOnExit ? 0 : count - 1;
+    }
+    return count;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task)
+{
+    {
+        std::lock_guard<std::mutex> lock(task->mutex);
+        task->notifyCount++;
+    }
+    task->notified.notify_one();
+    return pdPASS;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t *higherPriorityTaskWoken)
+{
+    xTaskNotifyGive(task);
+    if (higherPriorityTaskWoken)
+    {
+        *higherPriorityTaskWoken = pdFALSE;
+    }
+}
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize)
+{
+    if (length == 0)
+    {
+        return nullptr;
+    }
+
+    HostQueue *queue = new HostQueue();
+    queue->itemSize = itemSize;
+    queue->length = length;
+    queue->storage.resize((size_t)length * itemSize);
+    return queue;
+}
+
+void vQueueDelete(QueueHandle_t queue)
+{
+    delete queue;
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void *item, TickType_t ticksToWait)
+{
+    std::unique_lock<std::mutex> lock(queue->mutex);
+    if (!waitFor(queue->changed, lock, ticksToWait, [queue]()
+                 { return queue->count < queue->length; }))
+    {
+        return pdFAIL;
+    }
+
+    size_t slot = (queue->head + queue->count) % queue->length;
+    if (queue->itemSize > 0)
+    {
+        memcpy(&queue->storage[slot * queue->itemSize], item, queue->itemSize);
+    }
+    queue->count++;
+    lock.unlock();
+    queue->changed.notify_all();
+    return pdPASS;
+}
+
+BaseType_t xQueueSendToBack(QueueHandle_t queue, const void *item, TickType_t ticksToWait)
+{
+    return xQueueSend(queue, item, ticksToWait);
+}
+
+BaseType_t xQueueSendFromISR(QueueHandle_t queue, const void *item, BaseType_t *higherPriorityTaskWoken)
+{
+    if (higherPriorityTaskWoken)
+    {
+        *higherPriorityTaskWoken = pdFALSE;
+    }
+    return xQueueSend(queue, item, 0);
+}
+
+static BaseType_t queueRead(QueueHandle_t queue, void *buffer, TickType_t ticksToWait, bool remove)
+{
+    std::unique_lock<std::mutex> lock(queue->mutex);
+    if (!waitFor(queue->changed, lock, ticksToWait, [queue]()
+                 { return queue->count > 0; }))
+    {
+        return pdFAIL;
+    }
+
+    if (queue->itemSize > 0 && buffer != nullptr)
+    {
+        memcpy(buffer, &queue->storage[queue->head * queue->itemSize], queue->itemSize);
+    }
+    if (remove)
+    {
+        queue->head = (queue->head + 1) % queue->length;
+        queue->count--;
+        lock.unlock();
+        queue->changed.notify_all();
+    }
+    return pdPASS;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void *buffer, TickType_t ticksToWait)
+{
+    return queueRead(queue, buffer, ticksToWait, true);
+}
+
+BaseType_t xQueuePeek(QueueHandle_t queue, void *buffer, TickType_t ticksToWait)
+{
+    return queueRead(queue, buffer, ticksToWait, false);
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue)
+{
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    return queue->count;
+}
+
+UBaseType_t uxQueueSpacesAvailable(QueueHandle_t queue)
+{
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    return queue->length - queue->count;
+}
+
+BaseType_t xQueueReset(QueueHandle_t queue)
+{
+    {
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        queue->head = 0;
+        queue->count = 0;
+    }
+    queue->changed.notify_all();
+    return pdPASS;
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary()
+{
+    return xQueueCreate(1, 0);
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex()
+{
+    SemaphoreHandle_t semaphore = xQueueCreate(1, 0);
+    xSemaphoreGive(semaphore);
+    return semaphore;
+}
+
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t maxCount, UBaseType_t initialCount)
+{
+    SemaphoreHandle_t semaphore = xQueueCreate(maxCount, 0);
+    while (initialCount--)
+    {
+        xSemaphoreGive(semaphore);
+    }
+    return semaphore;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticksToWait)
+{
+    return xQueueReceive(semaphore, nullptr, ticksToWait);
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore)
+{
+    return xQueueSend(semaphore, nullptr, 0);
+}
+
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t semaphore, BaseType_t *higherPriorityTaskWoken)
+{
+    return xQueueSendFromISR(semaphore, nullptr, higherPriorityTaskWoken);
+}
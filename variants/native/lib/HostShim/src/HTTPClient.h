@@ -0,0 +1,118 @@
+/**
+ * expLORA Gateway Lite
+ *
+ * Host shim - ESP32 HTTP client
+ *
+ * Copyright Pajenicko s.r.o., Igor Sverma (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Arduino.h"
+#include "WiFiClient.h"
+#include "WiFiClientSecure.h"
+
+#define HTTPC_ERROR_CONNECTION_REFUSED (-1)
+#define HTTPC_ERROR_SEND_HEADER_FAILED (-2)
+#define HTTPC_ERROR_SEND_PAYLOAD_FAILED (-3)
+#define HTTPC_ERROR_NOT_CONNECTED (-4)
+#define HTTPC_ERROR_CONNECTION_LOST (-5)
+#define HTTPC_ERROR_NO_STREAM (-6)
+#define HTTPC_ERROR_NO_HTTP_SERVER (-7)
+#define HTTPC_ERROR_TOO_LESS_RAM (-8)
+#define HTTPC_ERROR_ENCODING (-9)
+#define HTTPC_ERROR_STREAM_WRITE (-10)
+#define HTTPC_ERROR_READ_TIMEOUT (-11)
+
+typedef enum
+{
+    HTTP_CODE_OK = 200,
+    HTTP_CODE_NO_CONTENT = 204,
+    HTTP_CODE_MOVED_PERMANENTLY = 301,
+    HTTP_CODE_FOUND = 302,
+    HTTP_CODE_BAD_REQUEST = 400,
+    HTTP_CODE_NOT_FOUND = 404,
+    HTTP_CODE_INTERNAL_SERVER_ERROR = 500
+} t_http_codes;
+
+/**
+ * HTTP client without network
+ *
+ * Requests fail immediately with HTTPC_ERROR_CONNECTION_REFUSED, so the
+ * forwarding code paths run without blocking the host pipeline.
+ */
+class HTTPClient
+{
+private:
+    String url;
+
+public:
+    bool begin(WiFiClient &client, const String &requestUrl)
+    {
+        (void)client;
+        url = requestUrl;
+        return true;
+    }
+    bool begin(const String &requestUrl)
+    {
+        url = requestUrl;
+        return true;
+    }
+    void end() { url = String(); }
+
+    void setTimeout(uint16_t timeout) { (void)timeout; }
+    void setConnectTimeout(int32_t timeout) { (void)timeout; }
+    void setReuse(bool reuse) { (void)reuse; }
+    void addHeader(const String &name, const String &value) { (void)name, (void)value; }
+
+    int GET() { return HTTPC_ERROR_CONNECTION_REFUSED; }
+    int POST(const String &payload) { return (void)payload, HTTPC_ERROR_CONNECTION_REFUSED; }
+    int sendRequest(const char *type, const String &payload) { return (void)type, (void)payload, HTTPC_ERROR_CONNECTION_REFUSED; }
+
+    int getSize() { return -1; }
+    String getString() { return String(); }
+
+    static String errorToString(int error)
+    {
+        switch (error)
+        {
+        case HTTPC_ERROR_CONNECTION_REFUSED:
+            return F("connection refused");
+        case HTTPC_ERROR_SEND_HEADER_FAILED:
+            return F("send header failed");
+        case HTTPC_ERROR_SEND_PAYLOAD_FAILED:
+            return F("send payload failed");
+        case HTTPC_ERROR_NOT_CONNECTED:
+            return F("not connected");
+        case HTTPC_ERROR_CONNECTION_LOST:
+            return F("connection lost");
+        case HTTPC_ERROR_NO_STREAM:
+            return F("no stream");
+        case HTTPC_ERROR_NO_HTTP_SERVER:
+            return F("no HTTP server");
+        case HTTPC_ERROR_TOO_LESS_RAM:
+            return F("too less ram");
+        case HTTPC_ERROR_ENCODING:
+            return F("Transfer-Encoding not supported");
+        case HTTPC_ERROR_STREAM_WRITE:
+            return F("Stream write error");
+        case HTTPC_ERROR_READ_TIMEOUT:
+            return F("read Timeout");
+        default:
+            return String();
+        }
+    }
+};
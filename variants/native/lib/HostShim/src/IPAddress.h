@@ -0,0 +1,66 @@
+/**
+ * expLORA Gateway Lite
+ *
+ * Host shim - IPv4 address
+ *
+ * Copyright Pajenicko s.r.o., Igor Sverma (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Arduino.h"
+
+class IPAddress
+{
+private:
+    uint8_t bytes[4];
+
+public:
+    IPAddress() : bytes{0, 0, 0, 0} {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : bytes{a, b, c, d} {}
+    IPAddress(uint32_t address)
+    {
+        memcpy(bytes, &address, sizeof(bytes));
+    }
+
+    operator uint32_t() const
+    {
+        uint32_t address;
+        memcpy(&address, bytes, sizeof(address));
+        return address;
+    }
+    uint8_t operator[](int index) const { return bytes[index]; }
+    bool operator==(const IPAddress &other) const { return memcmp(bytes, other.bytes, sizeof(bytes)) == 0; }
+
+    bool fromString(const char *address)
+    {
+        unsigned a, b, c, d;
+        if (sscanf(address, "%u.%u.%u.%u", &a, &b, &c, &d) != 4 || a > 255 || b > 255 || c > 255 || d > 255)
+        {
+            return false;
+        }
+        bytes[0] = a, bytes[1] = b, bytes[2] = c, bytes[3] = d;
+        return true;
+    }
+    bool fromString(const String &address) { return fromString(address.c_str()); }
+
+    String toString() const
+    {
+        char text[16];
+        snprintf(text, sizeof(text), "%u.%u.%u.%u", bytes[0], bytes[1], bytes[2], bytes[3]);
+        return String(text);
+    }
+};
@@ -0,0 +1,49 @@
+/**
+ * expLORA Gateway Lite
+ *
+ * Host shim - LittleFS
+ *
+ * Copyright Pajenicko s.r.o., Igor Sverma (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "FS.h"
+
+namespace fs
+{
+    /**
+     * LittleFS partition emulated by a host directory
+     *
+     * The directory is taken from the LITTLEFS_ROOT environment variable,
+     * "littlefs" in the working directory by default. totalBytes() reports the
+     * size of the partition in partitions/huge_app_littlefs.csv.
+     */
+    class LittleFSFS : public FS
+    {
+    public:
+        LittleFSFS();
+
+        bool begin(bool formatOnFail = false, const char *basePath = "/littlefs", uint8_t maxOpenFiles = 10,
+                   const char *partitionLabel = "spiffs");
+        void end() {}
+        bool format();
+        size_t totalBytes();
+        size_t usedBytes();
+    };
+}
+
+extern fs::LittleFSFS LittleFS;
@@ -0,0 +1,109 @@
+/**
+ * expLORA Gateway Lite
+ *
+ * Host shim - ESP32 Preferences
+ *
+ * Copyright Pajenicko s.r.o., Igor Sverma (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "Preferences.h"
+#include <mutex>
+
+static std::map<std::string, std::map<std::string, std::string>> namespaces;
+static std::mutex namespacesMutex;
+
+bool Preferences::begin(const char *name, bool readOnlyMode, const char *partitionLabel)
+{
+    (void)partitionLabel;
+    std::lock_guard<std::mutex> lock(namespacesMutex);
+    values = &namespaces[name];
+    readOnly = readOnlyMode;
+    return true;
+}
+
+void Preferences::end()
+{
+    values = nullptr;
+}
+
+bool Preferences::clear()
+{
+    if (values == nullptr || readOnly)
+    {
+        return false;
+    }
+    values->clear();
+    return true;
+}
+
+bool Preferences::remove(const char *key)
+{
+    if (values == nullptr || readOnly)
+    {
+        return false;
+    }
+    return values->erase(key) > 0;
+}
+
+bool Preferences::put(const char *key, const std::string &value)
+{
+    if (values == nullptr || readOnly || key == nullptr)
+    {
+        return false;
+    }
+    (*values)[key] = value;
+    return true;
+}
+
+const std::string *Preferences::get(const char *key) const
+{
+    if (values == nullptr || key == nullptr)
+    {
+        return nullptr;
+    }
+    auto it = values->find(key);
+    return it == values->end() ? nullptr : &it->second;
+}
+
+bool Preferences::getBool(const char *key, bool defaultValue) const
+{
+    const std::string *value = get(key);
+    return value ? *value == "1" : defaultValue;
+}
+
+int32_t Preferences::getInt(const char *key, int32_t defaultValue) const
+{
+    const std::string *value = get(key);
+    return value ? (int32_t)strtol(value->c_str(), nullptr, 10) : defaultValue;
+}
+
+uint32_t Preferences::getUInt(const char *key, uint32_t defaultValue) const
+{
+    const std::string *value = get(key);
+    return value ? (uint32_t)strtoul(value->c_str(), nullptr, 10) : defaultValue;
+}
+
+float Preferences::getFloat(const char *key, float defaultValue) const
+{
+    const std::string *value = get(key);
+    return value ? strtof(value->c_str(), nullptr) : defaultValue;
+}
+
+String Preferences::getString(const char *key, const String defaultValue) const
+{
+    const std::string *value = get(key);
+    return value ? String(value->c_str()) : defaultValue;
+}
@@ -0,0 +1,67 @@
+/**
+ * expLORA Gateway Lite
+ *
+ * Host shim - ESP32 Preferences
+ *
+ * Copyright Pajenicko s.r.o., Igor Sverma (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Arduino.h"
+#include <map>
+#include <string>
+
+/**
+ * Non-volatile key/value storage kept in process memory
+ *
+ * Namespaces survive end()/begin() but not program restart.
+ */
+class Preferences
+{
+private:
+    std::map<std::string, std::string> *values;
+    bool readOnly;
+
+    bool put(const char *key, const std::string &value);
+    const std::string *get(const char *key) const;
+
+public:
+    Preferences() : values(nullptr), readOnly(false) {}
+
+    bool begin(const char *name, bool readOnly = false, const char *partitionLabel = nullptr);
+    void end();
+    bool clear();
+    bool remove(const char *key);
+    bool isKey(const char *key) const { return get(key) != nullptr; }
+
+    size_t putBool(const char *key, bool value) { return put(key, value ? "1" : "0") ? 1 : 0; }
+    size_t putInt(const char *key, int32_t value) { return put(key, std::to_string(value)) ? 4 : 0; }
+    size_t putUInt(const char *key, uint32_t value) { return put(key, std::to_string(value)) ? 4 : 0; }
+    size_t putLong(const char *key, int32_t value) { return putInt(key, value); }
+    size_t putULong(const char *key, uint32_t value) { return putUInt(key, value); }
+    size_t putFloat(const char *key, float value) { return put(key, std::to_string(value)) ? 4 : 0; }
+    size_t putString(const char *key, const char *value) { return put(key, value) ? strlen(value) : 0; }
+    size_t putString(const char *key, const String &value) { return putString(key, value.c_str()); }
+
+    bool getBool(const char *key, bool defaultValue = false) const;
+    int32_t getInt(const char *key, int32_t defaultValue = 0) const;
+    uint32_t getUInt(const char *key, uint32_t defaultValue = 0) const;
+    int32_t getLong(const char *key, int32_t defaultValue = 0) const { return getInt(key, defaultValue); }
+    uint32_t getULong(const char *key, uint32_t defaultValue = 0) const { return getUInt(key, defaultValue); }
+    float getFloat(const char *key, float defaultValue = NAN) const;
+    String getString(const char *key, const String defaultValue = String()) const;
+};
@@ -0,0 +1,99 @@
+/**
+ * expLORA Gateway Lite
+ *
+ * Host shim - Arduino Print and Stream
+ *
+ * Copyright Pajenicko s.r.o., Igor Sverma (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "Print.h"
+#include <stdio.h>
+
+size_t Print::write(const uint8_t *buffer, size_t size)
+{
+    size_t n = 0;
+    while (size--)
+    {
+        if (write(*buffer++) == 0)
+        {
+            break;
+        }
+        n++;
+    }
+    return n;
+}
+
+size_t Print::printf(const char *format, ...)
+{
+    char stackBuffer[128];
+    va_list args;
+
+    va_start(args, format);
+    int length = vsnprintf(stackBuffer, sizeof(stackBuffer), format, args);
+    va_end(args);
+
+    if (length < 0)
+    {
+        return 0;
+    }
+    if ((size_t)length < sizeof(stackBuffer))
+    {
+        return write((const uint8_t *)stackBuffer, length);
+    }
+
+    std::string heapBuffer(length + 1, '\0');
+    va_start(args, format);
+    vsnprintf(&heapBuffer[0], length + 1, format, args);
+    va_end(args);
+    return write((const uint8_t *)heapBuffer.data(), length);
+}
+
+size_t Stream::readBytes(char *buffer, size_t length)
+{
+    size_t count = 0;
+    while (count < length)
+    {
+        int c = read();
+        if (c < 0)
+        {
+            break;
+        }
+        buffer[count++] = (char)c;
+    }
+    return count;
+}
+
+String Stream::readString()
+{
+    String result;
+    int c;
+    while ((c = read()) >= 0)
+    {
+        result += (char)c;
+    }
+    return result;
+}
+
+String Stream::readStringUntil(char terminator)
+{
+    String result;
+    int c;
+    while ((c = read()) >= 0 && c != terminator)
+    {
+        result += (char)c;
+    }
+    return result;
+}
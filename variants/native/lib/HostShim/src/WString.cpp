@@ -0,0 +1,237 @@
+/**
+ * expLORA Gateway Lite
+ *
+ * Host shim - Arduino String
+ *
+ * Copyright Pajenicko s.r.o., Igor Sverma (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "WString.h"
+#include <ctype.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <strings.h>
+
+std::string String::formatInteger(unsigned long long value, bool negative, unsigned char base)
+{
+    if (base < 2 || base > 36)
+    {
+        base = 10;
+    }
+
+    char digits[72];
+    int pos = sizeof(digits) - 1;
+    digits[pos] = '\0';
+    do
+    {
+        unsigned digit = value % base;
+        digits[--pos] = digit < 10 ? '0' + digit : 'a' + digit - 10;
+        value /= base;
+    } while (value != 0);
+
+    if (negative)
+    {
+        digits[--pos] = '-';
+    }
+
+    return std::string(&digits[pos]);
+}
+
+std::string String::formatFloat(double value, unsigned char decimalPlaces)
+{
+    if (isnan(value))
+    {
+        return "nan";
+    }
+    if (isinf(value))
+    {
+        return value > 0 ? "inf" : "-inf";
+    }
+
+    char text[352];
+    snprintf(text, sizeof(text), "%.*f", decimalPlaces, value);
+    return std::string(text);
+}
+
+bool String::equalsIgnoreCase(const String &s) const
+{
+    return buffer.size() == s.buffer.size() && strcasecmp(buffer.c_str(), s.buffer.c_str()) == 0;
+}
+
+bool String::startsWith(const String &prefix, unsigned int offset) const
+{
+    if (offset > buffer.size())
+    {
+        return false;
+    }
+    return buffer.compare(offset, prefix.buffer.size(), prefix.buffer) == 0;
+}
+
+bool String::endsWith(const String &suffix) const
+{
+    if (suffix.buffer.size() > buffer.size())
+    {
+        return false;
+    }
+    return buffer.compare(buffer.size() - suffix.buffer.size(), suffix.buffer.size(), suffix.buffer) == 0;
+}
+
+void String::getBytes(unsigned char *buf, unsigned int bufsize, unsigned int index) const
+{
+    if (bufsize == 0 || buf == nullptr)
+    {
+        return;
+    }
+    if (index >= buffer.size())
+    {
+        buf[0] = 0;
+        return;
+    }
+
+    unsigned int n = buffer.size() - index;
+    if (n > bufsize - 1)
+    {
+        n = bufsize - 1;
+    }
+    memcpy(buf, buffer.data() + index, n);
+    buf[n] = 0;
+}
+
+int String::indexOf(char ch, unsigned int fromIndex) const
+{
+    size_t pos = buffer.find(ch, fromIndex);
+    return pos == std::string::npos ? -1 : (int)pos;
+}
+
+int String::indexOf(const String &str, unsigned int fromIndex) const
+{
+    size_t pos = buffer.find(str.buffer, fromIndex);
+    return pos == std::string::npos ? -1 : (int)pos;
+}
+
+int String::lastIndexOf(char ch) const
+{
+    size_t pos = buffer.rfind(ch);
+    return pos == std::string::npos ? -1 : (int)pos;
+}
+
+int String::lastIndexOf(const String &str) const
+{
+    size_t pos = buffer.rfind(str.buffer);
+    return pos == std::string::npos ? -1 : (int)pos;
+}
+
+String String::substring(unsigned int beginIndex, unsigned int endIndex) const
+{
+    if (beginIndex > endIndex)
+    {
+        unsigned int tmp = beginIndex;
+        beginIndex = endIndex;
+        endIndex = tmp;
+    }
+    if (beginIndex >= buffer.size())
+    {
+        return String();
+    }
+    if (endIndex > buffer.size())
+    {
+        endIndex = buffer.size();
+    }
+    return String(buffer.substr(beginIndex, endIndex - beginIndex));
+}
+
+void String::replace(char find, char replace)
+{
+    for (char &c : buffer)
+    {
+        if (c == find)
+        {
+            c = replace;
+        }
+    }
+}
+
+void String::replace(const String &find, const String &replace)
+{
+    if (find.buffer.empty())
+    {
+        return;
+    }
+
+    size_t pos = 0;
+    while ((pos = buffer.find(find.buffer, pos)) != std::string::npos)
+    {
+        buffer.replace(pos, find.buffer.size(), replace.buffer);
+        pos += replace.buffer.size();
+    }
+}
+
+void String::remove(unsigned int index, unsigned int count)
+{
+    if (index < buffer.size())
+    {
+        buffer.erase(index, count);
+    }
+}
+
+void String::toLowerCase()
+{
+    for (char &c : buffer)
+    {
+        c = tolower((unsigned char)c);
+    }
+}
+
+void String::toUpperCase()
+{
+    for (char &c : buffer)
+    {
+        c = toupper((unsigned char)c);
+    }
+}
+
+void String::trim()
+{
+    size_t first = 0;
+    while (first < buffer.size() && isspace((unsigned char)buffer[first]))
+    {
+        first++;
+    }
+
+    size_t last = buffer.size();
+    while (last > first && isspace((unsigned char)buffer[last - 1]))
+    {
+        last--;
+    }
+
+    buffer = buffer.substr(first, last - first);
+}
+
+long String::toInt() const
+{
+    return atol(buffer.c_str());
+}
+
+float String::toFloat() const
+{
+    return (float)atof(buffer.c_str());
+}
+
+double String::toDouble() const
+{
+    return atof(buffer.c_str());
+}
@@ -0,0 +1,241 @@
+/**
+ * expLORA Gateway Lite
+ *
+ * Host shim - Arduino String
+ *
+ * Copyright Pajenicko s.r.o., Igor Sverma (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include <string>
+#include <type_traits>
+
+/**
+ * Arduino String on top of std::string
+ *
+ * Covers the subset of the Arduino-ESP32 String API used by the gateway;
+ * number formatting follows the Arduino implementation.
+ */
+class String
+{
+private:
+    std::string buffer;
+
+    static std::string formatInteger(unsigned long long value, bool negative, unsigned char base);
+    static std::string formatFloat(double value, unsigned char decimalPlaces);
+
+public:
+    String() {}
+    String(const char *cstr) : buffer(cstr ? cstr : "") {}
+    String(const char *cstr, unsigned int length) : buffer(cstr, length) {}
+    String(const std::string &str) : buffer(str) {}
+    String(const String &str) = default;
+    String(String &&str) = default;
+    explicit String(char c) : buffer(1, c) {}
+    explicit String(unsigned char value, unsigned char base = 10) : buffer(formatInteger(value, false, base)) {}
+    explicit String(int value, unsigned char base = 10) : buffer(formatInteger(value < 0 ? -(long long)value : value, value < 0 && base == 10, base)) {}
+    explicit String(unsigned int value, unsigned char base = 10) : buffer(formatInteger(value, false, base)) {}
+    explicit String(long value, unsigned char base = 10) : buffer(formatInteger(value < 0 ? -(long long)value : value, value < 0 && base == 10, base)) {}
+    explicit String(unsigned long value, unsigned char base = 10) : buffer(formatInteger(value, false, base)) {}
+    explicit String(long long value, unsigned char base = 10) : buffer(formatInteger(value < 0 ? -(unsigned long long)value : value, value < 0 && base == 10, base)) {}
+    explicit String(unsigned long long value, unsigned char base = 10) : buffer(formatInteger(value, false, base)) {}
+    explicit String(float value, unsigned char decimalPlaces = 2) : buffer(formatFloat(value, decimalPlaces)) {}
+    explicit String(double value, unsigned char decimalPlaces = 2) : buffer(formatFloat(value, decimalPlaces)) {}
+
+    String &operator=(const String &rhs) = default;
+    String &operator=(String &&rhs) = default;
+    String &operator=(const char *cstr)
+    {
+        buffer = cstr ? cstr : "";
+        return *this;
+    }
+
+    // Memory management
+    bool reserve(unsigned int size)
+    {
+        buffer.reserve(size);
+        return true;
+    }
+    unsigned int length() const { return buffer.size(); }
+    bool isEmpty() const { return buffer.empty(); }
+    const char *c_str() const { return buffer.c_str(); }
+    char *begin() { return &buffer[0]; }
+    char *end() { return &buffer[0] + buffer.size(); }
+    const char *begin() const { return buffer.data(); }
+    const char *end() const { return buffer.data() + buffer.size(); }
+
+    // Concatenation
+    bool concat(const String &str)
+    {
+        buffer += str.buffer;
+        return true;
+    }
+    bool concat(const char *cstr)
+    {
+        if (cstr == nullptr)
+        {
+            return false;
+        }
+        buffer += cstr;
+        return true;
+    }
+    bool concat(const char *cstr, unsigned int length)
+    {
+        if (cstr == nullptr)
+        {
+            return false;
+        }
+        buffer.append(cstr, length);
+        return true;
+    }
+    bool concat(char c)
+    {
+        buffer += c;
+        return true;
+    }
+    template <typename T, typename = typename std::enable_if<std::is_arithmetic<T>::value && !std::is_same<T, char>::value>::type>
+    bool concat(T value)
+    {
+        return concat(String(value));
+    }
+
+    String &operator+=(const String &rhs)
+    {
+        concat(rhs);
+        return *this;
+    }
+    String &operator+=(const char *cstr)
+    {
+        concat(cstr);
+        return *this;
+    }
+    String &operator+=(char c)
+    {
+        concat(c);
+        return *this;
+    }
+    template <typename T, typename = typename std::enable_if<std::is_arithmetic<T>::value && !std::is_same<T, char>::value>::type>
+    String &operator+=(T value)
+    {
+        concat(value);
+        return *this;
+    }
+
+    // Comparison
+    int compareTo(const String &s) const { return buffer.compare(s.buffer); }
+    bool equals(const String &s) const { return buffer == s.buffer; }
+    bool equals(const char *cstr) const { return buffer == (cstr ? cstr : ""); }
+    bool equalsIgnoreCase(const String &s) const;
+    bool operator==(const String &rhs) const { return equals(rhs); }
+    bool operator==(const char *cstr) const { return equals(cstr); }
+    bool operator!=(const String &rhs) const { return !equals(rhs); }
+    bool operator!=(const char *cstr) const { return !equals(cstr); }
+    bool operator<(const String &rhs) const { return compareTo(rhs) < 0; }
+    bool operator>(const String &rhs) const { return compareTo(rhs) > 0; }
+    bool startsWith(const String &prefix) const { return buffer.compare(0, prefix.buffer.size(), prefix.buffer) == 0; }
+    bool startsWith(const String &prefix, unsigned int offset) const;
+    bool endsWith(const String &suffix) const;
+
+    // Character access
+    char charAt(unsigned int index) const { return index < buffer.size() ? buffer[index] : 0; }
+    void setCharAt(unsigned int index, char c)
+    {
+        if (index < buffer.size())
+        {
+            buffer[index] = c;
+        }
+    }
+    char operator[](unsigned int index) const { return charAt(index); }
+    char &operator[](unsigned int index) { return buffer[index]; }
+    void getBytes(unsigned char *buf, unsigned int bufsize, unsigned int index = 0) const;
+    void toCharArray(char *buf, unsigned int bufsize, unsigned int index = 0) const
+    {
+        getBytes((unsigned char *)buf, bufsize, index);
+    }
+
+    // Search
+    int indexOf(char ch, unsigned int fromIndex = 0) const;
+    int indexOf(const String &str, unsigned int fromIndex = 0) const;
+    int lastIndexOf(char ch) const;
+    int lastIndexOf(const String &str) const;
+    String substring(unsigned int beginIndex) const { return substring(beginIndex, buffer.size()); }
+    String substring(unsigned int beginIndex, unsigned int endIndex) const;
+
+    // Modification
+    void replace(char find, char replace);
+    void replace(const String &find, const String &replace);
+    void remove(unsigned int index) { remove(index, (unsigned int)-1); }
+    void remove(unsigned int index, unsigned int count);
+    void toLowerCase();
+    void toUpperCase();
+    void trim();
+
+    // Parsing
+    long toInt() const;
+    float toFloat() const;
+    double toDouble() const;
+};
+
+// Result type of Arduino concatenation, kept for libraries that reference it
+class StringSumHelper : public String
+{
+public:
+    using String::String;
+    StringSumHelper(const String &s) : String(s) {}
+};
+
+// Concatenation operators
+inline String operator+(const String &lhs, const String &rhs)
+{
+    String result(lhs);
+    result += rhs;
+    return result;
+}
+inline String operator+(const String &lhs, const char *rhs)
+{
+    String result(lhs);
+    result += rhs;
+    return result;
+}
+inline String operator+(const char *lhs, const String &rhs)
+{
+    String result(lhs);
+    result += rhs;
+    return result;
+}
+inline String operator+(const String &lhs, char rhs)
+{
+    String result(lhs);
+    result += rhs;
+    return result;
+}
+template <typename T, typename = typename std::enable_if<std::is_arithmetic<T>::value && !std::is_same<T, char>::value>::type>
+inline String operator+(const String &lhs, T rhs)
+{
+    String result(lhs);
+    result += rhs;
+    return result;
+}
+inline bool operator==(const char *lhs, const String &rhs) { return rhs == lhs; }
+inline bool operator!=(const char *lhs, const String &rhs) { return rhs != lhs; }
+
+// Flash strings are ordinary strings on host
+class __FlashStringHelper;
+#define F(string_literal) (string_literal)
+#define FPSTR(p) ((const char *)(p))
@@ -0,0 +1,114 @@
+/**
+ * expLORA Gateway Lite
+ *
+ * Host shim - ESP32 WiFi
+ *
+ * Copyright Pajenicko s.r.o., Igor Sverma (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Arduino.h"
+#include "IPAddress.h"
+#include "WiFiClient.h"
+
+typedef enum
+{
+    WL_NO_SHIELD = 255,
+    WL_IDLE_STATUS = 0,
+    WL_NO_SSID_AVAIL = 1,
+    WL_SCAN_COMPLETED = 2,
+    WL_CONNECTED = 3,
+    WL_CONNECT_FAILED = 4,
+    WL_CONNECTION_LOST = 5,
+    WL_DISCONNECTED = 6
+} wl_status_t;
+
+typedef enum
+{
+    WIFI_OFF = 0,
+    WIFI_STA = 1,
+    WIFI_AP = 2,
+    WIFI_AP_STA = 3
+} wifi_mode_t;
+
+/**
+ * WiFi station/AP state of the host
+ *
+ * There is no radio; the station is reported as disconnected until the host
+ * program calls setHostStatus(WL_CONNECTED) to simulate an uplink.
+ */
+class WiFiClass
+{
+private:
+    wl_status_t hostStatus;
+    wifi_mode_t currentMode;
+    String ssid;
+    String apSsid;
+
+public:
+    WiFiClass() : hostStatus(WL_DISCONNECTED), currentMode(WIFI_OFF) {}
+
+    // Host only - set reported station status
+    void setHostStatus(wl_status_t status) { hostStatus = status; }
+
+    wl_status_t status() const { return hostStatus; }
+    bool isConnected() const { return hostStatus == WL_CONNECTED; }
+    wifi_mode_t getMode() const { return currentMode; }
+    bool mode(wifi_mode_t newMode)
+    {
+        currentMode = newMode;
+        return true;
+    }
+
+    wl_status_t begin(const char *networkSsid, const char *passphrase = nullptr)
+    {
+        (void)passphrase;
+        ssid = networkSsid;
+        return hostStatus;
+    }
+    bool disconnect(bool wifiOff = false, bool eraseAp = false) { return (void)wifiOff, (void)eraseAp, true; }
+    bool reconnect() { return true; }
+    bool setHostname(const char *hostname) { return (void)hostname, true; }
+    bool setAutoReconnect(bool autoReconnect) { return (void)autoReconnect, true; }
+
+    bool softAP(const char *networkSsid, const char *passphrase = nullptr)
+    {
+        (void)passphrase;
+        apSsid = networkSsid;
+        return true;
+    }
+    bool softAPdisconnect(bool wifiOff = false) { return (void)wifiOff, true; }
+
+    String SSID() const { return ssid; }
+    String softAPSSID() const { return apSsid; }
+    int8_t RSSI() const { return hostStatus == WL_CONNECTED ? -50 : 0; }
+    IPAddress localIP() const { return hostStatus == WL_CONNECTED ? IPAddress(127, 0, 0, 1) : IPAddress(); }
+    IPAddress softAPIP() const { return IPAddress(192, 168, 4, 1); }
+    IPAddress gatewayIP() const { return localIP(); }
+    IPAddress subnetMask() const { return IPAddress(255, 0, 0, 0); }
+    IPAddress dnsIP(uint8_t index = 0) const { return (void)index, localIP(); }
+
+    uint8_t *macAddress(uint8_t *mac) const
+    {
+        static const uint8_t hostMac[6] = {0x02, 0x00, 0x00, 0x00, 0x00, 0x01};
+        memcpy(mac, hostMac, sizeof(hostMac));
+        return mac;
+    }
+    String macAddress() const { return String("02:00:00:00:00:01"); }
+};
+
+extern WiFiClass WiFi;
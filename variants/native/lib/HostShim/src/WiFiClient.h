@@ -0,0 +1,48 @@
+/**
+ * expLORA Gateway Lite
+ *
+ * Host shim - WiFi TCP client
+ *
+ * Copyright Pajenicko s.r.o., Igor Sverma (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Arduino.h"
+
+/**
+ * TCP client without network - every connection is refused
+ */
+class WiFiClient : public Stream
+{
+public:
+    virtual ~WiFiClient() {}
+
+    virtual int connect(const char *host, uint16_t port) { return (void)host, (void)port, 0; }
+    virtual int connect(const char *host, uint16_t port, int32_t timeout) { return (void)timeout, connect(host, port); }
+    uint8_t connected() { return 0; }
+    void stop() {}
+    void setTimeout(uint32_t seconds) { (void)seconds; }
+    void setNoDelay(bool noDelay) { (void)noDelay; }
+
+    size_t write(uint8_t c) override { return (void)c, 0; }
+    size_t write(const uint8_t *buffer, size_t size) override { return (void)buffer, (void)size, 0; }
+    using Print::write;
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+    operator bool() { return connected(); }
+};
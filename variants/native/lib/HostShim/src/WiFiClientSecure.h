@@ -0,0 +1,33 @@
+/**
+ * expLORA Gateway Lite
+ *
+ * Host shim - WiFi TLS client
+ *
+ * Copyright Pajenicko s.r.o., Igor Sverma (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "WiFi.h"
+#include "WiFiClient.h"
+
+class WiFiClientSecure : public WiFiClient
+{
+public:
+    void setInsecure() {}
+    void setCACert(const char *rootCA) { (void)rootCA; }
+    void setHandshakeTimeout(unsigned long seconds) { (void)seconds; }
+};
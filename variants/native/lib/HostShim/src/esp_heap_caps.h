@@ -0,0 +1,46 @@
+/**
+ * expLORA Gateway Lite
+ *
+ * Host shim - ESP-IDF heap capabilities
+ *
+ * Copyright Pajenicko s.r.o., Igor Sverma (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+// Capabilities are ignored on host, all memory comes from malloc()
+#define MALLOC_CAP_EXEC (1 << 0)
+#define MALLOC_CAP_32BIT (1 << 1)
+#define MALLOC_CAP_8BIT (1 << 2)
+#define MALLOC_CAP_DMA (1 << 3)
+#define MALLOC_CAP_SPIRAM (1 << 10)
+#define MALLOC_CAP_INTERNAL (1 << 11)
+#define MALLOC_CAP_DEFAULT (1 << 12)
+
+inline void *heap_caps_malloc(size_t size, uint32_t caps) { return (void)caps, malloc(size); }
+inline void *heap_caps_calloc(size_t n, size_t size, uint32_t caps) { return (void)caps, calloc(n, size); }
+inline void *heap_caps_realloc(void *ptr, size_t size, uint32_t caps) { return (void)caps, realloc(ptr, size); }
+inline void heap_caps_free(void *ptr) { free(ptr); }
+inline bool heap_caps_check_integrity_addr(intptr_t addr, bool print_errors) { return (void)print_errors, addr != 0; }
+
+// Host reports no PSRAM and a fixed amount of internal memory
+inline size_t heap_caps_get_free_size(uint32_t caps) { return (caps & MALLOC_CAP_SPIRAM) ? 0 : 256 * 1024; }
+inline size_t heap_caps_get_largest_free_block(uint32_t caps) { return heap_caps_get_free_size(caps); }
+inline size_t heap_caps_get_total_size(uint32_t caps) { return heap_caps_get_free_size(caps); }
@@ -0,0 +1,34 @@
+/**
+ * expLORA Gateway Lite
+ *
+ * Host shim - ESP-IDF task watchdog
+ *
+ * Copyright Pajenicko s.r.o., Igor Sverma (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+typedef int esp_err_t;
+#define ESP_OK 0
+
+// Watchdog is not emulated on host
+inline esp_err_t esp_task_wdt_init(uint32_t timeout, bool panic) { return (void)timeout, (void)panic, ESP_OK; }
+inline esp_err_t esp_task_wdt_add(TaskHandle_t task) { return (void)task, ESP_OK; }
+inline esp_err_t esp_task_wdt_delete(TaskHandle_t task) { return (void)task, ESP_OK; }
+inline esp_err_t esp_task_wdt_reset() { return ESP_OK; }
@@ -0,0 +1,5 @@
+# Enable sanitizers for compiler and linker (build_flags only reach the compiler)
+Import("env")
+
+flags = ["-fsanitize=address,undefined", "-fno-omit-frame-pointer"]
+env.Append(CCFLAGS=flags, LINKFLAGS=flags)